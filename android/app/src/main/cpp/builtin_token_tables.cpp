@@ -0,0 +1,23 @@
+#include "token_table.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+// 随应用发布的音色的 tokens 表，由 tools/gen_token_table.cpp 生成
+#include "token_table_ru.inc"
+
+constexpr const BuiltinTokenTable* kBuiltinTokenTables[] = {
+    &kBuiltinTokensRu,
+};
+
+}  // namespace
+
+const BuiltinTokenTable* FindBuiltinTokenTable(std::string_view name) {
+  for (const BuiltinTokenTable* table : kBuiltinTokenTables) {
+    if (table->name == name) return table;
+  }
+  return nullptr;
+}
+
+}  // namespace sherpa_tts
@@ -2,61 +2,51 @@
 #include "token_table.h"
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #if defined(SHERPA_TTS_USE_ESPEAK_NG)
-#include <mutex>
-#include "espeak-ng/speak_lib.h"
-#include "phonemize.hpp"  // piper-phonemize
+#include "espeak_pool.h"
+#include "espeak_word_cache.h"
 #endif
 
 namespace sherpa_tts {
 
-namespace {
-
-// char32_t -> UTF-8 string (single character)
-std::string CodepointToUtf8(char32_t cp) {
-  std::string s;
-  if (cp <= 0x7F) {
-    s += static_cast<char>(cp);
-  } else if (cp <= 0x7FF) {
-    s += static_cast<char>(0xC0 | ((cp >> 6) & 0x1F));
-    s += static_cast<char>(0x80 | (cp & 0x3F));
-  } else if (cp <= 0xFFFF) {
-    s += static_cast<char>(0xE0 | ((cp >> 12) & 0x0F));
-    s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-    s += static_cast<char>(0x80 | (cp & 0x3F));
-  } else if (cp <= 0x10FFFF) {
-    s += static_cast<char>(0xF0 | ((cp >> 18) & 0x07));
-    s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
-    s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-    s += static_cast<char>(0x80 | (cp & 0x3F));
-  }
-  return s;
-}
-
-}  // namespace
-
 #if defined(SHERPA_TTS_USE_ESPEAK_NG)
 
-static std::mutex g_espeak_mutex;
-static bool g_espeak_inited = false;
-static std::string g_espeak_data_dir;
+// piper-phonemize 在句末追加的标点与空格（eSpeakPhonemeConfig 的默认值）
+constexpr char32_t kPeriod = U'.';
+constexpr char32_t kSpace = U' ';
+// PhonemizeWordsWithEspeak 的词间分隔：空行在 espeak 中总是段落结束。
+// 用 ". " 时后接小写字母（多数词）、序数 "1." 等情况下 espeak 不断句，整批因词数对不上而回退
+constexpr char kWordSeparator[] = "\n\n";
+// PhonemizeWordsWithEspeak 中由缓存命中、不送 espeak 的词
+constexpr size_t kCachedWord = static_cast<size_t>(-1);
 
-bool InitEspeakOnce(const std::string& data_dir) {
-  if (data_dir.empty()) return false;
-  if (g_espeak_inited && g_espeak_data_dir == data_dir) {
-    return true;
-  }
-  std::lock_guard<std::mutex> lock(g_espeak_mutex);
-  if (g_espeak_inited && g_espeak_data_dir == data_dir) {
-    return true;
-  }
-  int r = espeak_Initialize(AUDIO_OUTPUT_SYNCHRONOUS, 0, data_dir.c_str(), 0);
-  g_espeak_inited = (r == 22050);
-  if (g_espeak_inited) {
-    g_espeak_data_dir = data_dir;
+// 音素 -> token id：按 TokenTable::MatchSymbol 最长匹配取符号，每个符号后跟填充 pid（为负时不填充）；
+// 统计（按码点）写入 result。输出先按上界一次扩好再收缩，逐音素不分配
+void AppendPhonemeIds(const char32_t* phonemes, size_t size, const TokenTable* token_table,
+                      int64_t pid, std::vector<int64_t>* ids, EspeakResult* result) {
+  if (size == 0) return;
+  const size_t start = ids->size();
+  ids->resize(start + size * (token_table->MaxIdsPerSymbol() + 1));
+  int64_t* out = ids->data() + start;
+  int32_t matched = 0;
+  for (size_t i = 0; i < size;) {
+    size_t num_ids = 0;
+    const size_t n = token_table->MatchSymbol(phonemes + i, size - i, out, &num_ids);
+    if (n == 0) {
+      ++i;
+      continue;
+    }
+    out += num_ids;
+    if (pid >= 0) *out++ = pid;
+    matched += static_cast<int32_t>(n);
+    i += n;
   }
-  return g_espeak_inited;
+  ids->resize(out - ids->data());
+  result->phoneme_count += static_cast<int32_t>(size);
+  result->matched_phoneme_count += matched;
 }
 
 EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& text,
@@ -68,43 +58,31 @@ EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& text,
     result.code = EspeakErrorCode::kInvalidArgs;
     return result;
   }
-  if (!InitEspeakOnce(data_dir)) {
-    result.code = EspeakErrorCode::kInitFailed;
-    return result;
-  }
-
-  int64_t bid = token_table->GetId("^");
-  int64_t pid = token_table->GetId("_");
-  int64_t eid = token_table->GetId("$");
+  int64_t bid = token_table->TryGetId(U'^');
+  int64_t pid = token_table->TryGetId(U'_');
+  int64_t eid = token_table->TryGetId(U'$');
   if (bid < 0 || pid < 0 || eid < 0) {
     result.code = EspeakErrorCode::kMissingSpecialTokens;
     return result;
   }
 
-  std::vector<std::vector<piper::Phoneme>> phonemes;
-  {
-    std::lock_guard<std::mutex> lock(g_espeak_mutex);
-    piper::eSpeakPhonemeConfig config;
-    config.voice = voice.empty() ? "ru" : voice;
-    piper::phonemize_eSpeak(text, config, phonemes);
+  EspeakSentences phonemes;
+  if (!EspeakPool::Global().Phonemize(text, data_dir, voice, &phonemes)) {
+    result.code = EspeakErrorCode::kInitFailed;
+    return result;
   }
   if (phonemes.empty()) {
     result.code = EspeakErrorCode::kPhonemeEmpty;
     return result;
   }
 
+  size_t num_phonemes = 0;
+  for (const auto& p : phonemes) num_phonemes += p.size();
   std::vector<int64_t> ids;
+  ids.reserve(num_phonemes * (token_table->MaxIdsPerSymbol() + 1) + 2);
   ids.push_back(bid);
   for (const auto& p : phonemes) {
-    for (piper::Phoneme ph : p) {
-      result.phoneme_count += 1;
-      std::string sym = CodepointToUtf8(static_cast<char32_t>(ph));
-      if (token_table->Contains(sym)) {
-        ids.push_back(token_table->GetId(sym));
-        ids.push_back(pid);
-        result.matched_phoneme_count += 1;
-      }
-    }
+    AppendPhonemeIds(p.data(), p.size(), token_table, pid, &ids, &result);
   }
   ids.push_back(eid);
 
@@ -118,6 +96,155 @@ EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& text,
   return result;
 }
 
+EspeakResult PhonemizeWordsWithEspeak(const std::vector<std::string>& words,
+                                      const std::string& data_dir,
+                                      const std::string& voice,
+                                      const TokenTable* token_table) {
+  EspeakResult result;
+  if (!token_table || token_table->Size() == 0 || words.empty()) {
+    result.code = EspeakErrorCode::kInvalidArgs;
+    return result;
+  }
+  // 词典式的 tokens（无 "^" "$" "_"）不填充，与词典词条的 id 直接拼接
+  const int64_t pid = token_table->UsesPiperFraming() ? token_table->TryGetId(U'_') : -1;
+
+  // 先查词级缓存；未命中的词去重后合并为一次 espeak 调用
+  EspeakWordCache& cache = EspeakWordCache::Global();
+  const uint64_t generation = cache.Bind(data_dir, EspeakPool::Global().LibraryFingerprint());
+  std::vector<std::u32string> word_phonemes(words.size());
+  std::vector<size_t> batch_of(words.size(), kCachedWord);  // 未命中词在 batch 中的位置
+  std::vector<size_t> batch;                                // 送 espeak 的词（words 下标）
+  std::unordered_map<std::string_view, size_t> batch_index;
+  for (size_t i = 0; i < words.size(); ++i) {
+    if (EspeakWordCache::IsCacheable(words[i])) {
+      if (cache.Get(generation, voice, words[i], &word_phonemes[i])) continue;
+    } else {
+      cache.CountUncacheable();
+    }
+    auto inserted = batch_index.emplace(words[i], batch.size());
+    if (inserted.second) batch.push_back(i);
+    batch_of[i] = inserted.first->second;
+  }
+
+  if (!batch.empty()) {
+    std::string text;
+    for (size_t i : batch) {
+      text += words[i];
+      text += kWordSeparator;
+    }
+    EspeakSentences phonemes;
+    if (!EspeakPool::Global().Phonemize(text, data_dir, voice, &phonemes)) {
+      result.code = EspeakErrorCode::kInitFailed;
+      return result;
+    }
+    // 每个词恰好一句，无读音的词（"└──"）为空句。末尾可能多出空句；末尾的无读音词
+    // 也可能连空句都不产生，补上空句。不能按空句裁剪，否则末尾无读音词的空句被当作多余的丢掉，
+    // 结果随哪些词命中缓存而变
+    while (phonemes.size() > batch.size() && phonemes.back().empty()) phonemes.pop_back();
+    if (phonemes.size() > batch.size()) {
+      result.code = EspeakErrorCode::kWordSplitMismatch;
+      return result;
+    }
+    phonemes.resize(batch.size());
+    for (size_t j = 0; j < batch.size(); ++j) {
+      const auto& p = phonemes[j];
+      // 去掉句末的标点与空格
+      auto end = p.end();
+      while (end != p.begin() &&
+             (*(end - 1) == kPeriod || *(end - 1) == kSpace)) {
+        --end;
+      }
+      std::u32string& out = word_phonemes[batch[j]];
+      out.assign(p.begin(), end);
+      if (!out.empty() && EspeakWordCache::IsCacheable(words[batch[j]])) {
+        cache.Put(generation, voice, words[batch[j]], out);
+      }
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+      if (batch_of[i] != kCachedWord && batch[batch_of[i]] != i) {
+        word_phonemes[i] = word_phonemes[batch[batch_of[i]]];
+      }
+    }
+  }
+
+  size_t num_phonemes = 0;
+  for (const std::u32string& p : word_phonemes) num_phonemes += p.size();
+  result.token_ids.reserve(num_phonemes * (token_table->MaxIdsPerSymbol() + 1));
+  result.word_offsets.reserve(words.size() + 1);
+  result.word_offsets.push_back(0);
+  for (const std::u32string& p : word_phonemes) {
+    AppendPhonemeIds(p.data(), p.size(), token_table, pid, &result.token_ids, &result);
+    result.word_offsets.push_back(result.token_ids.size());
+  }
+  if (result.matched_phoneme_count == 0) {
+    result.code = EspeakErrorCode::kTokenMiss;
+    return result;
+  }
+  result.code = EspeakErrorCode::kOk;
+  return result;
+}
+
+EspeakResult StreamTextToTokenIdsWithEspeak(const std::string& text,
+                                            const std::string& data_dir,
+                                            const std::string& voice,
+                                            const TokenTable* token_table,
+                                            const EspeakChunkFn& on_chunk) {
+  EspeakResult result;
+  if (!token_table || token_table->Size() == 0 || text.empty() || !on_chunk) {
+    result.code = EspeakErrorCode::kInvalidArgs;
+    return result;
+  }
+  int64_t bid = token_table->TryGetId(U'^');
+  int64_t pid = token_table->TryGetId(U'_');
+  int64_t eid = token_table->TryGetId(U'$');
+  if (bid < 0 || pid < 0 || eid < 0) {
+    result.code = EspeakErrorCode::kMissingSpecialTokens;
+    return result;
+  }
+
+  EspeakChunk chunk;
+  int32_t chunk_matched = 0;
+  size_t num_chunks = 0;
+  bool stopped = false;
+  // 只含无法映射的音素（如单独的标点）的段丢弃
+  auto flush = [&] {
+    if (chunk_matched > 0) {
+      chunk.token_ids.push_back(eid);
+      ++num_chunks;
+      stopped = !on_chunk(std::move(chunk));
+    }
+    chunk = EspeakChunk();
+    chunk_matched = 0;
+  };
+  const bool ok = EspeakPool::Global().PhonemizeClauses(
+      text, data_dir, voice, [&](const EspeakClause& clause) {
+        if (chunk.token_ids.empty()) chunk.token_ids.push_back(bid);
+        const int32_t matched = result.matched_phoneme_count;
+        AppendPhonemeIds(clause.phonemes, clause.size, token_table, pid, &chunk.token_ids,
+                         &result);
+        chunk_matched += result.matched_phoneme_count - matched;
+        ++chunk.num_clauses;
+        chunk.sentence_end = clause.sentence_end;
+        if (clause.sentence_end || (num_chunks == 0 && chunk_matched > 0)) flush();
+        return !stopped;
+      });
+  if (!ok) {
+    result.code = EspeakErrorCode::kInitFailed;
+    return result;
+  }
+  if (!stopped) flush();
+  if (result.phoneme_count == 0) {
+    result.code = EspeakErrorCode::kPhonemeEmpty;
+    return result;
+  }
+  result.code = num_chunks > 0 ? EspeakErrorCode::kOk : EspeakErrorCode::kTokenMiss;
+  return result;
+}
+
+int32_t ReserveEspeakWorkers(int32_t n) {
+  return EspeakPool::Global().Reserve(n);
+}
+
 #else  // !SHERPA_TTS_USE_ESPEAK_NG
 
 EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& /*text*/,
@@ -129,6 +256,27 @@ EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& /*text*/,
   return result;
 }
 
+EspeakResult StreamTextToTokenIdsWithEspeak(const std::string& /*text*/,
+                                            const std::string& /*data_dir*/,
+                                            const std::string& /*voice*/,
+                                            const TokenTable* /*token_table*/,
+                                            const EspeakChunkFn& /*on_chunk*/) {
+  EspeakResult result;
+  result.code = EspeakErrorCode::kDisabled;
+  return result;
+}
+
+EspeakResult PhonemizeWordsWithEspeak(const std::vector<std::string>& /*words*/,
+                                      const std::string& /*data_dir*/,
+                                      const std::string& /*voice*/,
+                                      const TokenTable* /*token_table*/) {
+  EspeakResult result;
+  result.code = EspeakErrorCode::kDisabled;
+  return result;
+}
+
+int32_t ReserveEspeakWorkers(int32_t /*n*/) { return 0; }
+
 #endif
 
 std::vector<int64_t> TextToTokenIdsWithEspeak(const std::string& text,
@@ -1,6 +1,8 @@
 #ifndef SHERPA_TTS_ESPEAK_PHONEMIZE_H_
 #define SHERPA_TTS_ESPEAK_PHONEMIZE_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -16,6 +18,7 @@ enum class EspeakErrorCode : int32_t {
   kMissingSpecialTokens = 4,
   kPhonemeEmpty = 5,
   kTokenMiss = 6,
+  kWordSplitMismatch = 7,
 };
 
 struct EspeakResult {
@@ -23,6 +26,8 @@ struct EspeakResult {
   std::vector<int64_t> token_ids;
   int32_t phoneme_count = 0;
   int32_t matched_phoneme_count = 0;
+  // 仅 PhonemizeWordsWithEspeak 填写：第 i 个词的 id 为 token_ids[word_offsets[i], word_offsets[i+1])
+  std::vector<size_t> word_offsets;
 };
 
 // 当未提供 lexicon 时，用 espeak-ng 将文本转为音素再查 token 表（Piper/VITS 格式）。
@@ -34,6 +39,45 @@ EspeakResult TextToTokenIdsWithEspeakDetailed(const std::string& text,
                                               const std::string& voice,
                                               const TokenTable* token_table);
 
+// StreamTextToTokenIdsWithEspeak 交出的一段：首尾为 "^" / "$"，可直接作为一次推理的输入
+struct EspeakChunk {
+  std::vector<int64_t> token_ids;
+  int32_t num_clauses = 0;
+  bool sentence_end = false;  // 段在句末结束（否则在子句处，如逗号）
+};
+
+// 返回 false 时停止音素化剩余文本
+using EspeakChunkFn = std::function<bool(EspeakChunk&& chunk)>;
+
+// 流式版 TextToTokenIdsWithEspeakDetailed：espeak 每译出一个子句即转为 token id（见
+// EspeakPool::PhonemizeClauses），不等整段译完。首段在第一个有音素的子句处就交给 on_chunk，
+// 推理可以在其余子句仍在音素化时开始；之后的段在句末交出（句内其余子句合为一段）。
+// 每段各自带 "^" / "$"，因此在首个子句处被切开的句子是两次独立的推理输入，
+// 各段拼接起来并不等于整句的结果（多出段间的 "$" "^"）。
+// on_chunk 在调用线程上执行，期间占用一个 espeak 实例，不得阻塞（见 PipelineEmitFn）。
+// 返回的 token_ids 为空（已分段交出），计数与错误码同 TextToTokenIdsWithEspeakDetailed。
+EspeakResult StreamTextToTokenIdsWithEspeak(const std::string& text,
+                                            const std::string& data_dir,
+                                            const std::string& voice,
+                                            const TokenTable* token_table,
+                                            const EspeakChunkFn& on_chunk);
+
+// 批量音素化若干词：只占用一个 espeak 实例、一次调用（词间以空行分隔，每个词自成一段，
+// 读法与单独音素化该词相同，按句拆回各词），供词典未命中的词使用，耗时随未命中词数而非全文长度增长。
+// Piper 风格的 tokens（见 TokenTable::UsesPiperFraming）每个音素后跟填充 "_"，否则不填充；
+// 不含首尾的 "^" / "$" 与词间分隔（由调用方与词典片段一起组装）。
+// espeak 的分句与词数对不上时返回 kWordSplitMismatch，调用方可改为整句音素化。
+// 各词的音素先查 EspeakWordCache::Global()（见 espeak_word_cache.h），只有未命中的词
+//（同一批内去重）送 espeak。
+EspeakResult PhonemizeWordsWithEspeak(const std::vector<std::string>& words,
+                                      const std::string& data_dir,
+                                      const std::string& voice,
+                                      const TokenTable* token_table);
+
+// 把进程内的 espeak 实例数增加到至少 n（见 espeak_pool.h，只增不减，上限 8）。
+// 各实例互相独立，最多 n 个请求可同时音素化。返回实际实例数；未编入 espeak 或库加载失败为 0。
+int32_t ReserveEspeakWorkers(int32_t n);
+
 std::vector<int64_t> TextToTokenIdsWithEspeak(const std::string& text,
                                               const std::string& data_dir,
                                               const std::string& voice,
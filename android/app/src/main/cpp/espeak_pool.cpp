@@ -0,0 +1,326 @@
+#include "espeak_pool.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__ANDROID__)
+#include <android/dlext.h>
+#endif
+
+#include "espeak_worker.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+void AppendSentence(void* user, const char32_t* phonemes, size_t n) {
+  static_cast<EspeakSentences*>(user)->emplace_back(phonemes, phonemes + n);
+}
+
+int32_t ForwardClause(void* user, const char32_t* phonemes, size_t n, int32_t flags) {
+  EspeakClause clause;
+  clause.phonemes = phonemes;
+  clause.size = n;
+  clause.intonation =
+      static_cast<EspeakIntonation>(flags & SHERPA_TTS_ESPEAK_CLAUSE_INTONATION_MASK);
+  clause.sentence_end = (flags & SHERPA_TTS_ESPEAK_CLAUSE_SENTENCE_END) != 0;
+  return (*static_cast<const EspeakClauseFn*>(user))(clause) ? 1 : 0;
+}
+
+// 整句结果当作一个子句：语调由句末标点推断
+EspeakIntonation SentenceIntonation(const std::vector<char32_t>& sentence) {
+  auto it = std::find_if(sentence.rbegin(), sentence.rend(),
+                         [](char32_t c) { return c != U' '; });
+  if (it == sentence.rend()) return EspeakIntonation::kNone;
+  switch (*it) {
+    case U'.':
+      return EspeakIntonation::kFullStop;
+    case U',':
+    case U';':
+      return EspeakIntonation::kComma;
+    case U'?':
+      return EspeakIntonation::kQuestion;
+    case U'!':
+      return EspeakIntonation::kExclamation;
+    default:
+      return EspeakIntonation::kNone;
+  }
+}
+
+#if !defined(__ANDROID__)
+// 把 path 复制为临时文件并 dlopen：路径与 inode 都不同，动态链接器会当作另一个库加载。
+// 加载后即删除临时文件，映射保持有效。
+void* OpenPrivateCopy(const std::string& path) {
+  const char* tmp = std::getenv("TMPDIR");
+  std::string copy = std::string(tmp && *tmp ? tmp : "/tmp") + "/sherpa-tts-espeak-XXXXXX.so";
+  const int out = ::mkstemps(&copy[0], 3);
+  if (out < 0) return nullptr;
+  const int in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  bool ok = in >= 0;
+  char buf[1 << 16];
+  while (ok) {
+    const ssize_t n = ::read(in, buf, sizeof(buf));
+    if (n <= 0) {
+      ok = n == 0;
+      break;
+    }
+    ok = ::write(out, buf, static_cast<size_t>(n)) == n;
+  }
+  if (in >= 0) ::close(in);
+  ::close(out);
+  void* handle = ok ? ::dlopen(copy.c_str(), RTLD_NOW | RTLD_LOCAL) : nullptr;
+  ::unlink(copy.c_str());
+  return handle;
+}
+#endif
+
+}  // namespace
+
+struct EspeakPool::Library {
+  void* handle = nullptr;
+  SherpaTtsEspeakInitFn init = nullptr;
+  SherpaTtsEspeakPhonemizeFn phonemize = nullptr;
+  // 上下文接口，库未导出时为空
+  SherpaTtsEspeakContextCreateFn context_create = nullptr;
+  SherpaTtsEspeakContextPhonemizeFn context_phonemize = nullptr;
+  SherpaTtsEspeakContextDestroyFn context_destroy = nullptr;
+  // 逐子句接口，库未导出时为空（退回逐句）
+  SherpaTtsEspeakPhonemizeClausesFn phonemize_clauses = nullptr;
+  SherpaTtsEspeakContextPhonemizeClausesFn context_phonemize_clauses = nullptr;
+
+  ~Library() {
+    if (handle) ::dlclose(handle);
+  }
+};
+
+struct EspeakPool::Instance {
+  Library* library = nullptr;
+  void* context = nullptr;  // 仅上下文模式
+  std::string voice;        // context 上次使用的 voice
+
+  ~Instance() { DestroyContext(); }
+
+  void DestroyContext() {
+    if (context) library->context_destroy(context);
+    context = nullptr;
+    voice.clear();
+  }
+};
+
+EspeakPool::EspeakPool(std::string library) : library_(std::move(library)) {}
+
+EspeakPool::~EspeakPool() = default;
+
+EspeakPool& EspeakPool::Global() {
+  // 进程退出时不卸载：其他静态对象析构时可能仍有请求在途
+  static EspeakPool* pool = new EspeakPool();
+  return *pool;
+}
+
+std::unique_ptr<EspeakPool::Library> EspeakPool::Load(size_t index) {
+  void* handle = nullptr;
+  if (index == 0) {
+    handle = ::dlopen(library_.c_str(), RTLD_NOW | RTLD_LOCAL);
+  } else if (!resolved_path_.empty()) {
+#if defined(__ANDROID__)
+    android_dlextinfo info = {};
+    info.flags = ANDROID_DLEXT_FORCE_LOAD;
+    handle = android_dlopen_ext(resolved_path_.c_str(), RTLD_NOW | RTLD_LOCAL, &info);
+#else
+    handle = OpenPrivateCopy(resolved_path_);
+#endif
+  }
+  if (!handle) return nullptr;
+  auto library = std::make_unique<Library>();
+  library->handle = handle;
+  library->init = reinterpret_cast<SherpaTtsEspeakInitFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_init"));
+  library->phonemize = reinterpret_cast<SherpaTtsEspeakPhonemizeFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_phonemize"));
+  if (!library->init || !library->phonemize) return nullptr;
+  library->context_create = reinterpret_cast<SherpaTtsEspeakContextCreateFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_context_create"));
+  library->context_phonemize = reinterpret_cast<SherpaTtsEspeakContextPhonemizeFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_context_phonemize"));
+  library->context_destroy = reinterpret_cast<SherpaTtsEspeakContextDestroyFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_context_destroy"));
+  if (!library->context_create || !library->context_phonemize || !library->context_destroy) {
+    library->context_create = nullptr;
+    library->context_phonemize = nullptr;
+    library->context_destroy = nullptr;
+  }
+  library->phonemize_clauses = reinterpret_cast<SherpaTtsEspeakPhonemizeClausesFn>(
+      ::dlsym(handle, "sherpa_tts_espeak_phonemize_clauses"));
+  if (library->context_create) {
+    library->context_phonemize_clauses =
+        reinterpret_cast<SherpaTtsEspeakContextPhonemizeClausesFn>(
+            ::dlsym(handle, "sherpa_tts_espeak_context_phonemize_clauses"));
+  }
+  if (index == 0) {
+    Dl_info info;
+    if (::dladdr(reinterpret_cast<void*>(library->init), &info) && info.dli_fname) {
+      resolved_path_ = info.dli_fname;
+      // 从 APK 直接加载时路径形如 ".../base.apk!/lib/arm64-v8a/libsherpa-tts-espeak.so"
+      const std::string file = resolved_path_.substr(0, resolved_path_.find("!/"));
+      struct stat st;
+      if (::stat(file.c_str(), &st) == 0) {
+        library_fingerprint_.store(
+            (static_cast<uint64_t>(st.st_size) * 0x100000001B3ull) ^
+            (static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ull +
+             static_cast<uint64_t>(st.st_mtim.tv_nsec)),
+            std::memory_order_relaxed);
+      }
+    }
+  }
+  return library;
+}
+
+int32_t EspeakPool::Reserve(int32_t n) {
+  std::lock_guard<std::mutex> load_lock(load_mutex_);
+  const size_t target = static_cast<size_t>(std::clamp(n, 0, kMaxWorkers));
+  size_t have = static_cast<size_t>(NumWorkers());
+  // 在 mutex_ 外加载（复制 / 映射库要几十毫秒），已有实例照常服务；
+  // libraries_ 只在持有 load_mutex_ 时改动，这里可以直接读
+  while (have < target) {
+    std::unique_ptr<Library> library;
+    if (libraries_.empty() || !libraries_[0]->context_create) {
+      library = Load(libraries_.size());
+      if (!library) break;
+    }
+    auto instance = std::make_unique<Instance>();
+    instance->library = library ? library.get() : libraries_[0].get();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (library) {
+      libraries_.push_back(std::move(library));
+      contexts_ = libraries_[0]->context_create != nullptr;
+      library_loaded_.store(true, std::memory_order_release);
+    }
+    idle_.push_back(instance.get());
+    instances_.push_back(std::move(instance));
+    stats_.workers = static_cast<int32_t>(instances_.size());
+    stats_.libraries = static_cast<int32_t>(libraries_.size());
+    have = instances_.size();
+    idle_cv_.notify_all();
+  }
+  return static_cast<int32_t>(have);
+}
+
+uint64_t EspeakPool::LibraryFingerprint() {
+  if (!library_loaded_.load(std::memory_order_acquire)) Reserve(1);
+  return library_fingerprint_.load(std::memory_order_relaxed);
+}
+
+int32_t EspeakPool::NumWorkers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int32_t>(instances_.size());
+}
+
+EspeakPool::Instance* EspeakPool::Acquire(const std::string& data_dir,
+                                          const std::string& voice) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++stats_.requests;
+  if (idle_.empty()) ++stats_.waits;
+  if (contexts_ && data_dir != data_dir_) {
+    // 上下文引用着已加载的音素表：等所有实例空闲，销毁上下文后再重新初始化
+    idle_cv_.wait(lock, [this] { return idle_.size() == instances_.size(); });
+    if (data_dir != data_dir_) {
+      for (auto& instance : instances_) instance->DestroyContext();
+      data_dir_ = libraries_[0]->init(data_dir.c_str()) == 1 ? data_dir : "";
+      if (data_dir_.empty()) return nullptr;
+    }
+  }
+  idle_cv_.wait(lock, [this] { return !idle_.empty(); });
+  auto it = std::find_if(idle_.begin(), idle_.end(),
+                         [&voice](const Instance* i) { return i->voice == voice; });
+  if (it == idle_.end()) it = idle_.end() - 1;
+  Instance* instance = *it;
+  idle_.erase(it);
+  return instance;
+}
+
+void EspeakPool::Release(Instance* instance) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.push_back(instance);
+  }
+  // 换 data_dir 的请求在等所有实例空闲，notify_one 可能唤醒不到它
+  idle_cv_.notify_all();
+}
+
+bool EspeakPool::Run(const std::string& data_dir, const std::string& voice,
+                     const std::function<bool(const Library&, void*)>& fn) {
+  if (data_dir.empty()) return false;
+  if (NumWorkers() == 0 && Reserve(1) == 0) return false;
+  Instance* instance = Acquire(data_dir, voice);
+  if (!instance) return false;
+  const Library* library = instance->library;
+  bool ok = false;
+  if (library->context_create) {
+    if (!instance->context) {
+      instance->context = library->context_create(voice.c_str());
+    }
+    ok = instance->context && fn(*library, instance->context);
+    instance->voice = ok ? voice : "";
+  } else {
+    ok = library->init(data_dir.c_str()) == 1 && fn(*library, nullptr);
+  }
+  Release(instance);
+  return ok;
+}
+
+bool EspeakPool::Phonemize(const std::string& text, const std::string& data_dir,
+                           const std::string& voice, EspeakSentences* out) {
+  if (!out) return false;
+  out->clear();
+  return Run(data_dir, voice, [&](const Library& library, void* context) {
+    return (context ? library.context_phonemize(context, text.c_str(), voice.c_str(),
+                                                &AppendSentence, out)
+                    : library.phonemize(text.c_str(), voice.c_str(), &AppendSentence,
+                                        out)) >= 0;
+  });
+}
+
+bool EspeakPool::PhonemizeClauses(const std::string& text, const std::string& data_dir,
+                                  const std::string& voice,
+                                  const EspeakClauseFn& on_clause) {
+  if (!on_clause) return false;
+  return Run(data_dir, voice, [&](const Library& library, void* context) {
+    void* user = const_cast<EspeakClauseFn*>(&on_clause);
+    if (context && library.context_phonemize_clauses) {
+      return library.context_phonemize_clauses(context, text.c_str(), voice.c_str(),
+                                               &ForwardClause, user) >= 0;
+    }
+    if (!context && library.phonemize_clauses) {
+      return library.phonemize_clauses(text.c_str(), voice.c_str(), &ForwardClause,
+                                       user) >= 0;
+    }
+    EspeakSentences sentences;
+    const bool ok = (context ? library.context_phonemize(context, text.c_str(),
+                                                         voice.c_str(), &AppendSentence,
+                                                         &sentences)
+                             : library.phonemize(text.c_str(), voice.c_str(),
+                                                 &AppendSentence, &sentences)) >= 0;
+    for (size_t i = 0; ok && i < sentences.size(); ++i) {
+      EspeakClause clause;
+      clause.phonemes = sentences[i].data();
+      clause.size = sentences[i].size();
+      clause.intonation = SentenceIntonation(sentences[i]);
+      clause.sentence_end = true;
+      if (!on_clause(clause)) break;
+    }
+    return ok;
+  });
+}
+
+EspeakPoolStats EspeakPool::Stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,127 @@
+#ifndef SHERPA_TTS_ESPEAK_POOL_H_
+#define SHERPA_TTS_ESPEAK_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sherpa_tts {
+
+// 一次音素化的结果：piper-phonemize 切出的各句音素码点
+using EspeakSentences = std::vector<std::vector<char32_t>>;
+
+// 子句的语调（子句结束方式），取值同 espeak 的 CLAUSE_INTONATION_*
+enum class EspeakIntonation : int32_t {
+  kFullStop = 0,
+  kComma = 1,
+  kQuestion = 2,
+  kExclamation = 3,
+  kNone = 4,  // 无标点结束（如过长的子句被截断）
+};
+
+// 逐子句音素化的一个子句：音素码点含按结束方式追加的标点（"."、", " 等），仅在回调期间有效
+struct EspeakClause {
+  const char32_t* phonemes = nullptr;
+  size_t size = 0;
+  EspeakIntonation intonation = EspeakIntonation::kFullStop;
+  bool sentence_end = false;  // 该子句结束一句
+};
+
+// 返回 false 时停止音素化剩余文本
+using EspeakClauseFn = std::function<bool(const EspeakClause& clause)>;
+
+struct EspeakPoolStats {
+  int32_t workers = 0;
+  int32_t libraries = 0;  // 已加载的库份数：上下文模式下为 1
+  uint64_t requests = 0;
+  uint64_t waits = 0;  // 请求到达时没有空闲实例、须排队的次数
+};
+
+// 最多 NumWorkers() 个 espeak 实例同时音素化；请求取一个空闲实例执行，没有空闲实例时排队等待。
+// libsherpa-tts-espeak.so（espeak_worker.h）按库名 dlopen 一次：
+// - 库导出上下文接口时（上下文模式），每个实例是库内的一个 espeak 上下文，音素表与词典只加载
+//   一份；上下文惰性创建，请求优先取上次 voice 相同的空闲实例，否则由上下文切换 voice
+//  （上下文内缓存最近用过的 voice）。换 data_dir 时等所有实例空闲后销毁上下文、重新初始化。
+// - 否则 espeak 的翻译状态是库内全局变量，每个实例是一份独立加载的库副本：
+//   Android 上用 android_dlopen_ext(ANDROID_DLEXT_FORCE_LOAD) 从同一路径（可以是 APK 内的
+//   "base.apk!/lib/..."）再加载一次；其他平台（主机工具）把库复制为临时文件后 dlopen，
+//   加载后即删除临时文件。
+// 线程安全。析构时须没有进行中的请求。
+class EspeakPool {
+ public:
+  static constexpr int32_t kMaxWorkers = 8;
+
+  explicit EspeakPool(std::string library = "libsherpa-tts-espeak.so");
+  ~EspeakPool();
+
+  EspeakPool(const EspeakPool&) = delete;
+  EspeakPool& operator=(const EspeakPool&) = delete;
+
+  // 进程内共享的池（JNI 使用），不析构
+  static EspeakPool& Global();
+
+  // 把实例数增加到至少 n（上限 kMaxWorkers，不减少）；返回实际实例数，
+  // 库不存在或加载失败时可能少于 n（0 表示 espeak 不可用）
+  int32_t Reserve(int32_t n);
+
+  int32_t NumWorkers() const;
+
+  // 已加载的库文件的指纹（大小与修改时间；APK 内的库取 APK 文件），库更新后随之改变，
+  // 供持久化的音素缓存判断是否失效。尚无实例时先加载一份；库不可用返回 0。
+  // 第 0 份加载后只读原子变量，不等待正在进行的 Reserve
+  uint64_t LibraryFingerprint();
+
+  // 取一个空闲实例音素化 text（尚无实例时先加载一份）。
+  // 实例按需以 data_dir 初始化，换 data_dir 时重新初始化。
+  // 库不可用、初始化失败或 voice 无效时返回 false。
+  bool Phonemize(const std::string& text, const std::string& data_dir,
+                 const std::string& voice, EspeakSentences* out);
+
+  // 同 Phonemize，但 espeak 每译出一个子句即在调用线程上回调 on_clause，不等整段译完，
+  // 下游（如推理）可以在首个子句上先开始。回调期间占用该实例（非上下文模式下还持有库内的
+  // 全局锁），on_clause 不得阻塞等待下游，只应放入不会满的队列后返回。
+  // 库未导出逐子句接口时整段译完后逐句回调（每句作为一个结束该句的子句）。
+  // on_clause 返回 false 时停止，仍返回 true。
+  bool PhonemizeClauses(const std::string& text, const std::string& data_dir,
+                        const std::string& voice, const EspeakClauseFn& on_clause);
+
+  EspeakPoolStats Stats() const;
+
+ private:
+  struct Library;
+  struct Instance;
+
+  std::unique_ptr<Library> Load(size_t index);
+  // 上下文模式下按需切换 data_dir（失败返回 nullptr），并优先取 voice 相同的空闲实例
+  Instance* Acquire(const std::string& data_dir, const std::string& voice);
+  void Release(Instance* instance);
+  // 取一个实例、按需创建上下文（非上下文模式则按需 init）后执行 fn(库, 上下文或 nullptr)
+  bool Run(const std::string& data_dir, const std::string& voice,
+           const std::function<bool(const Library&, void*)>& fn);
+
+  const std::string library_;
+  std::string resolved_path_;  // 第 0 份的实际路径（dladdr），副本从这里加载
+  // 随 resolved_path_ 在加载第 0 份时确定；之后每批词都要读，不经 load_mutex_
+  std::atomic<uint64_t> library_fingerprint_{0};
+  std::atomic<bool> library_loaded_{false};
+  std::mutex load_mutex_;      // 串行化 Reserve，加载期间不阻塞请求
+  mutable std::mutex mutex_;
+  std::condition_variable idle_cv_;
+  // 先于 instances_ 声明：实例（及其上下文）先于库析构
+  std::vector<std::unique_ptr<Library>> libraries_;
+  std::vector<std::unique_ptr<Instance>> instances_;
+  std::vector<Instance*> idle_;
+  bool contexts_ = false;  // 上下文模式：所有实例共用 libraries_[0]
+  std::string data_dir_;   // 上下文模式下 libraries_[0] 已初始化的 data_dir
+  EspeakPoolStats stats_;
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_ESPEAK_POOL_H_
@@ -0,0 +1,227 @@
+#include "espeak_word_cache.h"
+
+#include <sys/stat.h>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "text_segment.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+bool IsAsciiLetter(char32_t cp) {
+  return (cp >= U'a' && cp <= U'z') || (cp >= U'A' && cp <= U'Z');
+}
+
+// 持久化文件名：voice 中的路径分隔符等替换为 '_'
+std::string StoreFileName(std::string_view voice) {
+  std::string name = "espeak-words-";
+  for (char c : voice) {
+    const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                      (c >= '0' && c <= '9') || c == '-' || c == '+';
+    name += safe ? c : '_';
+  }
+  return name + ".bin";
+}
+
+}  // namespace
+
+EspeakWordCache::EspeakWordCache(size_t max_bytes)
+    : shard_max_bytes_(max_bytes / kNumShards) {}
+
+EspeakWordCache& EspeakWordCache::Global() {
+  static EspeakWordCache* cache = new EspeakWordCache();
+  return *cache;
+}
+
+bool EspeakWordCache::IsCacheable(std::string_view word) {
+  if (word.empty()) return false;
+  char32_t cp;
+  for (size_t pos = 0, n = 0; (n = DecodeUtf8(word, pos, &cp)) > 0; pos += n) {
+    if (cp == 0xFFFD) return false;  // 非法 UTF-8
+    if (cp < 0x80 ? !IsAsciiLetter(cp) : ClassifyCodepoint(cp) != CharClass::kOther) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t EspeakWordCache::Bind(const std::string& data_dir, uint64_t library_fingerprint) {
+  std::lock_guard<std::mutex> lock(bind_mutex_);
+  if (data_dir != data_dir_ || library_fingerprint != library_fingerprint_) {
+    data_dir_ = data_dir;
+    library_fingerprint_ = library_fingerprint;
+    // 先换代数再清空：清空某片之前已在该片完成的 Put 随之清除，之后的 Put 因代数过期被丢弃
+    generation_.fetch_add(1);
+    Clear();
+    ResetStores(data_dir, library_fingerprint);
+  }
+  return generation_.load();
+}
+
+void EspeakWordCache::SetPersistentDir(const std::string& dir) {
+  if (!dir.empty()) ::mkdir(dir.c_str(), 0700);  // 已存在时失败，忽略
+  std::lock_guard<std::mutex> lock(persist_mutex_);
+  if (dir == persist_dir_) return;
+  persist_dir_ = dir;
+  stores_.clear();
+}
+
+void EspeakWordCache::ResetStores(const std::string& data_dir, uint64_t library_fingerprint) {
+  std::lock_guard<std::mutex> lock(persist_mutex_);
+  store_data_dir_ = data_dir;
+  store_library_fingerprint_ = library_fingerprint;
+  store_fingerprint_ = 0;
+  stores_.clear();
+}
+
+std::shared_ptr<EspeakWordStore> EspeakWordCache::StoreFor(uint64_t generation,
+                                                           std::string_view voice) {
+  std::shared_ptr<StoreSlot> slot;
+  std::string path;
+  std::string data_dir;
+  uint64_t library_fingerprint = 0;
+  uint64_t fingerprint = 0;
+  {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+    if (persist_dir_.empty() || generation != generation_.load()) return nullptr;
+    std::shared_ptr<StoreSlot>& entry = stores_[std::string(voice)];
+    if (!entry) entry = std::make_shared<StoreSlot>();
+    slot = entry;
+    path = persist_dir_ + "/" + StoreFileName(voice);
+    data_dir = store_data_dir_;
+    library_fingerprint = store_library_fingerprint_;
+    fingerprint = store_fingerprint_;
+  }
+  std::lock_guard<std::mutex> lock(slot->mutex);
+  if (slot->opened) return slot->store;
+  slot->opened = true;
+  if (fingerprint == 0) {
+    // 遍历 data_dir 只在每次绑定后做一次；数据目录不存在时指纹为 0，不持久化
+    const uint64_t data = EspeakDataFingerprint(data_dir);
+    if (data == 0) return nullptr;
+    fingerprint = data ^ (library_fingerprint * 0x100000001B3ull);
+    std::lock_guard<std::mutex> persist_lock(persist_mutex_);
+    if (generation == generation_.load()) store_fingerprint_ = fingerprint;
+  }
+  auto store = std::make_shared<EspeakWordStore>();
+  if (store->Open(path, std::string(voice), fingerprint)) slot->store = std::move(store);
+  return slot->store;
+}
+
+std::string EspeakWordCache::MakeKey(std::string_view voice, std::string_view word) {
+  std::string key;
+  key.reserve(voice.size() + 1 + word.size());
+  key.append(voice);
+  key += '\x1f';
+  key.append(word);
+  return key;
+}
+
+EspeakWordCache::Shard& EspeakWordCache::ShardFor(const std::string& key) {
+  return shards_[std::hash<std::string>()(key) % kNumShards];
+}
+
+bool EspeakWordCache::Get(uint64_t generation, std::string_view voice,
+                          std::string_view word, std::u32string* phonemes) {
+  std::string key = MakeKey(voice, word);
+  Shard& shard = ShardFor(key);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (generation != generation_.load()) {
+      ++shard.misses;
+      return false;
+    }
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      ++shard.hits;
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      *phonemes = it->second->phonemes;
+      return true;
+    }
+  }
+  // 内存未命中再查持久化文件（不持片锁），命中后放回内存
+  std::shared_ptr<EspeakWordStore> store = StoreFor(generation, voice);
+  const bool found = store && store->Find(word, phonemes);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (!found) {
+    ++shard.misses;
+    return false;
+  }
+  ++shard.hits;
+  persistent_hits_.fetch_add(1, std::memory_order_relaxed);
+  if (generation == generation_.load() && shard.index.count(key) == 0) {
+    InsertLocked(shard, std::move(key), *phonemes);
+  }
+  return true;
+}
+
+void EspeakWordCache::Put(uint64_t generation, std::string_view voice,
+                          std::string_view word, const std::u32string& phonemes) {
+  std::string key = MakeKey(voice, word);
+  Shard& shard = ShardFor(key);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (generation != generation_.load()) return;
+    if (shard.index.count(key) > 0) return;  // 并发音素化了同一个词
+    InsertLocked(shard, std::move(key), phonemes);
+  }
+  if (std::shared_ptr<EspeakWordStore> store = StoreFor(generation, voice)) {
+    store->Append(word, phonemes);
+  }
+}
+
+void EspeakWordCache::InsertLocked(Shard& shard, std::string key,
+                                   const std::u32string& phonemes) {
+  // 粗略估计：键 + 音素 + 链表 / 哈希表节点开销
+  const size_t bytes = key.size() * 2 + phonemes.size() * sizeof(char32_t) +
+                       sizeof(Entry) + 64;
+  if (bytes > shard_max_bytes_ / 8) return;
+  shard.lru.push_front({std::move(key), phonemes, bytes});
+  shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+  shard.bytes += bytes;
+  while (shard.bytes > shard_max_bytes_ && !shard.lru.empty()) {
+    shard.bytes -= shard.lru.back().bytes;
+    shard.index.erase(shard.lru.back().key);
+    shard.lru.pop_back();
+    ++shard.evictions;
+  }
+}
+
+void EspeakWordCache::Clear() {
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.bytes = 0;
+  }
+}
+
+EspeakWordCacheStats EspeakWordCache::Stats() const {
+  EspeakWordCacheStats stats;
+  for (const Shard& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    stats.hits += shard.hits;
+    stats.misses += shard.misses;
+    stats.evictions += shard.evictions;
+    stats.entries += shard.lru.size();
+    stats.bytes += shard.bytes;
+  }
+  stats.uncacheable = uncacheable_.load(std::memory_order_relaxed);
+  stats.persistent_hits = persistent_hits_.load(std::memory_order_relaxed);
+  std::vector<std::shared_ptr<StoreSlot>> slots;
+  {
+    std::lock_guard<std::mutex> lock(persist_mutex_);
+    for (const auto& entry : stores_) slots.push_back(entry.second);
+  }
+  for (const std::shared_ptr<StoreSlot>& slot : slots) {
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if (slot->store) stats.persistent_entries += slot->store->NumEntries();
+  }
+  return stats;
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,137 @@
+#ifndef SHERPA_TTS_ESPEAK_WORD_CACHE_H_
+#define SHERPA_TTS_ESPEAK_WORD_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "espeak_word_store.h"
+
+namespace sherpa_tts {
+
+// 词级缓存计数（自构造起累计，Clear 不清零）
+struct EspeakWordCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t uncacheable = 0;  // 不满足 IsCacheable、直接送 espeak 的词
+  uint64_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;
+  uint64_t persistent_hits = 0;   // hits 中由持久化文件命中的部分
+  size_t persistent_entries = 0;  // 已打开的持久化文件中的词数
+
+  double HitRatio() const {
+    const uint64_t n = hits + misses;
+    return n > 0 ? static_cast<double>(hits) / n : 0;
+  }
+};
+
+// 单个词的 espeak 音素缓存：(voice, 词) -> 音素码点（不含句末的 "." 与空格），
+// 位于 PhonemizeWordsWithEspeak 之前，命中的词不再经过 espeak 的规则匹配。
+// 该路径上每个词自成一段单独音素化，结果与上下文无关；整句音素化
+//（kAuto / kEspeakOnly、逐词切分失败时的回退）受相邻词影响，不经过本缓存。
+// 缓存的是音素而非 token id，与 TokenTable、词典无关，词典重载后无需清空。
+// 按键的哈希分为 kNumShards 片，各片独立加锁、各自 LRU（按字节数限界），线程安全。
+// 条目属于 Bind 绑定的 data_dir，换 data_dir 时清空。
+//
+// 设置 SetPersistentDir 后，每个 voice 另有一个持久化文件（EspeakWordStore）作为第二级：
+// 内存未命中时查文件，新音素化的词同时追加到文件，进程重启后常用词直接命中。
+// 文件带 espeak-ng-data 与 espeak 库的指纹，任一变化时自动清空重建。
+class EspeakWordCache {
+ public:
+  static constexpr size_t kNumShards = 16;
+  static constexpr size_t kDefaultMaxBytes = 1 << 20;
+
+  explicit EspeakWordCache(size_t max_bytes = kDefaultMaxBytes);
+
+  EspeakWordCache(const EspeakWordCache&) = delete;
+  EspeakWordCache& operator=(const EspeakWordCache&) = delete;
+
+  // 进程内共享的缓存（与 EspeakPool::Global 对应），不析构
+  static EspeakWordCache& Global();
+
+  // 只缓存全部由字母类字符组成的词（无空白、标点、ASCII 数字与符号），这类词在 espeak 中
+  // 恰好成为一句且读法固定。数字与带标点的片段（"3.14"、"т.е."、单独的标点）可能被拆成
+  // 多句或读不出音，且原文中的读法取决于相邻的词（序数点、千位分组），不缓存。
+  static bool IsCacheable(std::string_view word);
+
+  // 绑定 data_dir 与 espeak 库指纹（EspeakPool::LibraryFingerprint），与当前不同时清空缓存；
+  // 返回本次绑定的代数，传给 Get / Put。
+  // 代数过期（期间已换 data_dir）时 Get 不命中、Put 丢弃，旧数据的结果不会混入。
+  uint64_t Bind(const std::string& data_dir, uint64_t library_fingerprint = 0);
+
+  // 持久化文件所在目录（不存在时创建），空串关闭持久化。各 voice 的文件在首次用到时打开。
+  void SetPersistentDir(const std::string& dir);
+
+  bool Get(uint64_t generation, std::string_view voice, std::string_view word,
+           std::u32string* phonemes);
+  void Put(uint64_t generation, std::string_view voice, std::string_view word,
+           const std::u32string& phonemes);
+
+  // 计入一个不可缓存的词
+  void CountUncacheable() { uncacheable_.fetch_add(1, std::memory_order_relaxed); }
+
+  void Clear();
+
+  EspeakWordCacheStats Stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::u32string phonemes;
+    size_t bytes;
+  };
+
+  // 一个 voice 的持久化文件；首次用到时在 mutex 下打开（只阻塞同一 voice 的并发首次查询）
+  struct StoreSlot {
+    std::mutex mutex;
+    bool opened = false;  // 打开失败也记下，不再重试
+    std::shared_ptr<EspeakWordStore> store;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::list<Entry> lru;  // 表头最近使用
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  static std::string MakeKey(std::string_view voice, std::string_view word);
+  Shard& ShardFor(const std::string& key);
+  // 调用方须持有 shard.mutex
+  void InsertLocked(Shard& shard, std::string key, const std::u32string& phonemes);
+  // voice 的持久化文件；未启用、打开失败或代数过期时返回空。
+  // 遍历 data_dir 求指纹与打开文件都在 persist_mutex_ 之外进行
+  std::shared_ptr<EspeakWordStore> StoreFor(uint64_t generation, std::string_view voice);
+  void ResetStores(const std::string& data_dir, uint64_t library_fingerprint);
+
+  const size_t shard_max_bytes_;
+  Shard shards_[kNumShards];
+  std::mutex bind_mutex_;
+  std::string data_dir_;
+  uint64_t library_fingerprint_ = 0;
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<uint64_t> uncacheable_{0};
+  std::atomic<uint64_t> persistent_hits_{0};
+
+  // 持久化状态；加锁顺序 bind_mutex_ -> persist_mutex_
+  mutable std::mutex persist_mutex_;
+  std::string persist_dir_;
+  std::string store_data_dir_;
+  uint64_t store_library_fingerprint_ = 0;
+  uint64_t store_fingerprint_ = 0;  // 0 表示尚未计算
+  std::unordered_map<std::string, std::shared_ptr<StoreSlot>> stores_;  // voice -> 文件
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_ESPEAK_WORD_CACHE_H_
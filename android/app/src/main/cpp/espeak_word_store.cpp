@@ -0,0 +1,465 @@
+#include "espeak_word_store.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "mapped_file.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+constexpr char kStoreMagic[4] = {'S', 'E', 'W', 'C'};
+constexpr uint32_t kStoreVersion = 1;
+
+struct StoreHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t voice_hash;
+  uint64_t data_fingerprint;
+  uint64_t index;         // 哈希索引偏移
+  uint32_t num_slots;     // 2 的幂；0 表示没有索引区
+  uint32_t num_entries;   // 索引区的词数
+  uint64_t records_end;   // 索引区记录的结束位置，即追加区起点
+};
+
+struct IndexSlot {
+  uint32_t hash;
+  uint32_t offset;  // 记录相对文件起始的偏移，0 表示空槽
+};
+
+// 记录：头 | 词（UTF-8，补 0 到 4 字节对齐）| 音素码点
+struct RecordHeader {
+  uint32_t word_size;
+  uint32_t num_phonemes;
+  uint32_t checksum;
+};
+
+constexpr size_t kRecordAlign = 4;
+constexpr uint32_t kMaxWordSize = 1024;
+constexpr uint32_t kMaxPhonemes = 4096;
+
+static_assert(sizeof(StoreHeader) % kRecordAlign == 0, "records must stay aligned");
+
+// FNV-1a（同 token_table.cpp），可分段累加
+uint64_t Fnv1a(const void* data, size_t n, uint64_t h = 0xCBF29CE484222325ull) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < n; ++i) {
+    h ^= p[i];
+    h *= 0x100000001B3ull;
+  }
+  return h;
+}
+
+uint32_t Fold32(uint64_t h) { return static_cast<uint32_t>(h ^ (h >> 32)); }
+
+uint32_t WordHash(std::string_view word) { return Fold32(Fnv1a(word.data(), word.size())); }
+
+uint32_t Checksum(std::string_view word, const char32_t* phonemes, size_t n) {
+  return Fold32(Fnv1a(phonemes, n * sizeof(char32_t), Fnv1a(word.data(), word.size())));
+}
+
+size_t Padded(size_t n) { return (n + kRecordAlign - 1) & ~(kRecordAlign - 1); }
+
+void AppendRecord(std::string_view word, const char32_t* phonemes, size_t n,
+                  std::string* out) {
+  const RecordHeader r = {static_cast<uint32_t>(word.size()), static_cast<uint32_t>(n),
+                          Checksum(word, phonemes, n)};
+  out->append(reinterpret_cast<const char*>(&r), sizeof(r));
+  out->append(word.data(), word.size());
+  out->append(Padded(word.size()) - word.size(), '\0');
+  out->append(reinterpret_cast<const char*>(phonemes), n * sizeof(char32_t));
+}
+
+struct Record {
+  std::string_view word;
+  const char32_t* phonemes = nullptr;
+  size_t num_phonemes = 0;
+  size_t end = 0;  // 下一条记录的偏移
+};
+
+// 解析 base[pos, limit) 处的一条记录；越界、不完整或校验失败返回 false
+bool ParseRecord(const char* base, size_t pos, size_t limit, Record* out) {
+  if (pos % kRecordAlign != 0 || pos > limit || limit - pos < sizeof(RecordHeader)) {
+    return false;
+  }
+  RecordHeader r;
+  std::memcpy(&r, base + pos, sizeof(r));
+  if (r.word_size == 0 || r.word_size > kMaxWordSize || r.num_phonemes > kMaxPhonemes) {
+    return false;
+  }
+  const size_t size = sizeof(r) + Padded(r.word_size) + r.num_phonemes * sizeof(char32_t);
+  if (limit - pos < size) return false;
+  out->word = std::string_view(base + pos + sizeof(r), r.word_size);
+  out->phonemes =
+      reinterpret_cast<const char32_t*>(base + pos + sizeof(r) + Padded(r.word_size));
+  out->num_phonemes = r.num_phonemes;
+  out->end = pos + size;
+  return Checksum(out->word, out->phonemes, out->num_phonemes) == r.checksum;
+}
+
+struct Item {
+  std::string_view word;
+  const char32_t* phonemes;
+  size_t num_phonemes;
+};
+
+// 生成压缩后的文件内容：文件头 | 索引 | 记录（同一个词只保留第一次出现）
+std::string BuildImage(uint64_t voice_hash, uint64_t data_fingerprint,
+                       const std::vector<Item>& items) {
+  uint32_t num_slots = 0;
+  if (!items.empty()) {
+    num_slots = 16;
+    while (num_slots < items.size() * 2) num_slots *= 2;
+  }
+  StoreHeader h = {};
+  std::memcpy(h.magic, kStoreMagic, sizeof(h.magic));
+  h.version = kStoreVersion;
+  h.voice_hash = voice_hash;
+  h.data_fingerprint = data_fingerprint;
+  h.index = sizeof(StoreHeader);
+  h.num_slots = num_slots;
+
+  std::vector<IndexSlot> slots(num_slots, IndexSlot{0, 0});
+  std::string image(sizeof(StoreHeader) + num_slots * sizeof(IndexSlot), '\0');
+  for (const Item& item : items) {
+    const uint32_t hash = WordHash(item.word);
+    uint32_t i = hash & (num_slots - 1);
+    bool duplicate = false;
+    for (; slots[i].offset != 0; i = (i + 1) & (num_slots - 1)) {
+      Record r;
+      if (slots[i].hash == hash && ParseRecord(image.data(), slots[i].offset, image.size(), &r) &&
+          r.word == item.word) {
+        duplicate = true;
+        break;
+      }
+    }
+    if (duplicate || image.size() > UINT32_MAX / 2) continue;
+    slots[i] = {hash, static_cast<uint32_t>(image.size())};
+    AppendRecord(item.word, item.phonemes, item.num_phonemes, &image);
+    ++h.num_entries;
+  }
+  h.records_end = image.size();
+  std::memcpy(&image[0], &h, sizeof(h));
+  if (num_slots > 0) {
+    std::memcpy(&image[h.index], slots.data(), num_slots * sizeof(IndexSlot));
+  }
+  return image;
+}
+
+bool WriteFile(const std::string& path, const std::string& data) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  os.write(data.data(), static_cast<std::streamsize>(data.size()));
+  os.close();
+  return !os.fail();
+}
+
+// 写临时文件后 rename，读者不会看到写了一半的文件
+bool ReplaceFile(const std::string& path, const std::string& data) {
+  const std::string tmp = path + ".tmp";
+  if (!WriteFile(tmp, data) || ::rename(tmp.c_str(), path.c_str()) != 0) {
+    ::unlink(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+void MixValue(uint64_t value, uint64_t* h) { *h = Fnv1a(&value, sizeof(value), *h); }
+
+// 按名字排序遍历，结果与 readdir 的顺序无关；不跟随指向目录的符号链接
+void HashTree(const std::string& dir, const std::string& rel, uint64_t* h) {
+  DIR* d = ::opendir(dir.c_str());
+  if (!d) return;
+  std::vector<std::string> names;
+  while (const dirent* e = ::readdir(d)) {
+    if (std::strcmp(e->d_name, ".") != 0 && std::strcmp(e->d_name, "..") != 0) {
+      names.emplace_back(e->d_name);
+    }
+  }
+  ::closedir(d);
+  std::sort(names.begin(), names.end());
+  for (const std::string& name : names) {
+    const std::string full = dir + "/" + name;
+    struct stat st;
+    if (::lstat(full.c_str(), &st) != 0) continue;
+    if (S_ISDIR(st.st_mode)) {
+      HashTree(full, rel + name + "/", h);
+      continue;
+    }
+    if (S_ISLNK(st.st_mode) && (::stat(full.c_str(), &st) != 0 || !S_ISREG(st.st_mode))) {
+      continue;
+    }
+    const std::string path = rel + name;
+    *h = Fnv1a(path.data(), path.size() + 1, *h);  // 含结尾的 '\0'，分隔相邻的名字
+    MixValue(static_cast<uint64_t>(st.st_size), h);
+    MixValue(static_cast<uint64_t>(st.st_mtim.tv_sec), h);
+    MixValue(static_cast<uint64_t>(st.st_mtim.tv_nsec), h);
+  }
+}
+
+}  // namespace
+
+uint64_t EspeakDataFingerprint(const std::string& data_dir) {
+  struct stat st;
+  if (data_dir.empty() || ::stat(data_dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+    return 0;
+  }
+  uint64_t h = Fnv1a(nullptr, 0);
+  HashTree(data_dir, "", &h);
+  return h;
+}
+
+// 一次映射的文件：索引区只读，直接在映射上查询
+struct EspeakWordStore::Segment {
+  MappedFile file;
+  const IndexSlot* slots = nullptr;
+  uint32_t num_slots = 0;
+  uint32_t num_entries = 0;
+  size_t records_begin = 0;
+  size_t records_end = 0;
+
+  // 校验文件头与各区边界
+  bool Parse(uint64_t voice_hash, uint64_t data_fingerprint) {
+    if (file.Size() < sizeof(StoreHeader)) return false;
+    StoreHeader h;
+    std::memcpy(&h, file.Data(), sizeof(h));
+    if (std::memcmp(h.magic, kStoreMagic, sizeof(h.magic)) != 0 || h.version != kStoreVersion ||
+        h.voice_hash != voice_hash || h.data_fingerprint != data_fingerprint) {
+      return false;
+    }
+    if ((h.num_slots & (h.num_slots - 1)) != 0 || h.num_entries > h.num_slots ||
+        h.index != sizeof(StoreHeader) ||
+        h.records_end < h.index + uint64_t{h.num_slots} * sizeof(IndexSlot) ||
+        h.records_end > file.Size()) {
+      return false;
+    }
+    slots = reinterpret_cast<const IndexSlot*>(file.Data() + h.index);
+    num_slots = h.num_slots;
+    num_entries = h.num_entries;
+    records_begin = h.index + num_slots * sizeof(IndexSlot);
+    records_end = h.records_end;
+    return true;
+  }
+
+  bool Find(std::string_view word, uint32_t hash, std::u32string* phonemes) const {
+    if (num_slots == 0) return false;
+    for (uint32_t i = hash & (num_slots - 1), probes = 0;
+         probes < num_slots && slots[i].offset != 0;
+         i = (i + 1) & (num_slots - 1), ++probes) {
+      Record r;
+      if (slots[i].hash == hash && slots[i].offset >= records_begin &&
+          ParseRecord(file.Data(), slots[i].offset, records_end, &r) && r.word == word) {
+        phonemes->assign(r.phonemes, r.num_phonemes);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // 按文件中的顺序遍历索引区记录
+  void CollectItems(std::vector<Item>* items) const {
+    Record r;
+    for (size_t pos = records_begin;
+         pos < records_end && ParseRecord(file.Data(), pos, records_end, &r); pos = r.end) {
+      items->push_back({r.word, r.phonemes, r.num_phonemes});
+    }
+  }
+};
+
+EspeakWordStore::EspeakWordStore() = default;
+
+EspeakWordStore::~EspeakWordStore() {
+  WaitForCompaction();
+  if (fd_ >= 0) ::close(fd_);
+}
+
+std::shared_ptr<const EspeakWordStore::Segment> EspeakWordStore::CurrentSegment() const {
+  return std::atomic_load(&segment_);
+}
+
+bool EspeakWordStore::Open(const std::string& path, const std::string& voice,
+                           uint64_t data_fingerprint) {
+  path_ = path;
+  voice_hash_ = Fnv1a(voice.data(), voice.size());
+  data_fingerprint_ = data_fingerprint;
+
+  auto segment = std::make_shared<Segment>();
+  if (!segment->file.Open(path_) || !segment->Parse(voice_hash_, data_fingerprint_)) {
+    // 不存在、格式旧、voice 或数据指纹不同（espeak 数据或库已更新）：清空重建
+    segment = std::make_shared<Segment>();
+    if (!ReplaceFile(path_, BuildImage(voice_hash_, data_fingerprint_, {})) ||
+        !segment->file.Open(path_) || !segment->Parse(voice_hash_, data_fingerprint_)) {
+      return false;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 追加区读入内存；末尾不完整的记录（写入中途退出）截掉，之后的追加从这里接着写
+  size_t pos = segment->records_end;
+  const size_t size = segment->file.Size();
+  Record r;
+  while (pos < size && ParseRecord(segment->file.Data(), pos, size, &r)) {
+    auto inserted = tail_.emplace(std::string(r.word),
+                                  std::u32string(r.phonemes, r.num_phonemes));
+    if (inserted.second) tail_order_.push_back(&*inserted.first);
+    pos = r.end;
+  }
+  if (pos < size && ::truncate(path_.c_str(), static_cast<off_t>(pos)) != 0) return false;
+  fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  if (fd_ < 0) return false;
+  std::atomic_store(&segment_, std::shared_ptr<const Segment>(std::move(segment)));
+  if (ShouldCompactLocked()) StartCompactionLocked();
+  return true;
+}
+
+bool EspeakWordStore::Find(std::string_view word, std::u32string* phonemes) const {
+  const uint32_t hash = WordHash(word);
+  std::shared_ptr<const Segment> segment = CurrentSegment();
+  if (!segment) return false;
+  if (segment->Find(word, hash, phonemes)) return true;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tail_.find(std::string(word));
+  if (it != tail_.end()) {
+    *phonemes = it->second;
+    return true;
+  }
+  // 其间压缩完成：词已移出追加区、并入新映射
+  std::shared_ptr<const Segment> current = CurrentSegment();
+  return current != segment && current->Find(word, hash, phonemes);
+}
+
+void EspeakWordStore::Append(std::string_view word, const std::u32string& phonemes) {
+  if (word.empty() || word.size() > kMaxWordSize || phonemes.size() > kMaxPhonemes) return;
+  std::string key(word);
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 在锁内取快照：压缩在锁内发布新映射并移出已并入的词，两者一致
+  std::shared_ptr<const Segment> segment = CurrentSegment();
+  if (fd_ < 0 || !segment || tail_.count(key) > 0 ||
+      segment->num_entries + tail_.size() >= kMaxEntries) {
+    return;
+  }
+  std::u32string existing;
+  if (segment->Find(word, WordHash(word), &existing)) return;
+  std::string record;
+  AppendRecord(word, phonemes.data(), phonemes.size(), &record);
+  if (::write(fd_, record.data(), record.size()) != static_cast<ssize_t>(record.size())) {
+    // 磁盘满等：停止持久化，残缺的记录在下次打开时截掉
+    ::close(fd_);
+    fd_ = -1;
+    return;
+  }
+  auto inserted = tail_.emplace(std::move(key), phonemes);
+  tail_order_.push_back(&*inserted.first);
+  if (ShouldCompactLocked()) StartCompactionLocked();
+}
+
+bool EspeakWordStore::ShouldCompactLocked() const {
+  if (compacting_.load() || tail_.size() < kMinCompactEntries) return false;
+  std::shared_ptr<const Segment> segment = CurrentSegment();
+  return segment && tail_.size() * 2 >= segment->num_entries;
+}
+
+void EspeakWordStore::StartCompactionLocked() {
+  compacting_ = true;
+  // 上一次的线程已结束（compacting_ 为 false），回收后再启动
+  if (compactor_.joinable()) compactor_.join();
+  compactor_ = std::thread([this] {
+    Compact();
+    compacting_ = false;
+  });
+}
+
+bool EspeakWordStore::Compact() {
+  std::unique_lock<std::mutex> compact_lock(compact_mutex_, std::try_to_lock);
+  if (!compact_lock.owns_lock()) return false;
+
+  // 1. 取快照：当前映射与已追加的词（复制，之后不持锁）
+  std::shared_ptr<const Segment> old;
+  std::vector<std::pair<std::string, std::u32string>> appended;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    old = CurrentSegment();
+    if (fd_ < 0 || !old) return false;
+    appended.reserve(tail_order_.size());
+    for (const auto* entry : tail_order_) appended.emplace_back(entry->first, entry->second);
+  }
+  if (appended.empty()) return true;
+
+  // 2. 不持锁生成新文件：读者与追加照常进行
+  std::vector<Item> items;
+  items.reserve(old->num_entries + appended.size());
+  old->CollectItems(&items);
+  for (const auto& entry : appended) {
+    items.push_back({entry.first, entry.second.data(), entry.second.size()});
+  }
+  const std::string tmp = path_ + ".tmp";
+  if (!WriteFile(tmp, BuildImage(voice_hash_, data_fingerprint_, items))) {
+    ::unlink(tmp.c_str());
+    return false;
+  }
+
+  // 3. 持锁把压缩期间追加的词接在新文件末尾，替换文件并发布新映射
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t merged = appended.size();
+  std::string more;
+  for (size_t i = merged; i < tail_order_.size(); ++i) {
+    AppendRecord(tail_order_[i]->first, tail_order_[i]->second.data(),
+                 tail_order_[i]->second.size(), &more);
+  }
+  bool ok = true;
+  if (!more.empty()) {
+    std::ofstream os(tmp, std::ios::binary | std::ios::app);
+    os.write(more.data(), static_cast<std::streamsize>(more.size()));
+    os.close();
+    ok = !os.fail();
+  }
+  auto segment = std::make_shared<Segment>();
+  int fd = -1;
+  if (ok) ok = ::rename(tmp.c_str(), path_.c_str()) == 0;
+  if (!ok) {
+    ::unlink(tmp.c_str());
+    return false;
+  }
+  if (!segment->file.Open(path_) || !segment->Parse(voice_hash_, data_fingerprint_) ||
+      (fd = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC)) < 0) {
+    // 文件已被替换却无法映射：停止持久化，保留旧映射供查询
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  if (fd_ >= 0) ::close(fd_);
+  fd_ = fd;
+  for (size_t i = 0; i < merged; ++i) tail_.erase(tail_.find(tail_order_[i]->first));
+  tail_order_.erase(tail_order_.begin(), tail_order_.begin() + merged);
+  std::atomic_store(&segment_, std::shared_ptr<const Segment>(std::move(segment)));
+  return true;
+}
+
+void EspeakWordStore::WaitForCompaction() {
+  std::thread compactor;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    compactor = std::move(compactor_);
+  }
+  if (compactor.joinable()) compactor.join();
+}
+
+size_t EspeakWordStore::NumEntries() const {
+  std::shared_ptr<const Segment> segment = CurrentSegment();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return (segment ? segment->num_entries : 0) + tail_.size();
+}
+
+size_t EspeakWordStore::NumAppended() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tail_.size();
+}
+
+}  // namespace sherpa_tts
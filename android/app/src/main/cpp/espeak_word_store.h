@@ -0,0 +1,98 @@
+#ifndef SHERPA_TTS_ESPEAK_WORD_STORE_H_
+#define SHERPA_TTS_ESPEAK_WORD_STORE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sherpa_tts {
+
+// espeak-ng-data 目录的指纹：递归遍历目录，按相对路径、大小与修改时间计算（不读内容）。
+// 音素表、词典或 voice 文件被替换后即改变。目录不存在返回 0。
+uint64_t EspeakDataFingerprint(const std::string& data_dir);
+
+// 某个 voice 的词 -> 音素持久化文件（EspeakWordCache 的第二级），进程重启后直接 mmap，
+// 不解析、不重建，常用词无需再经 espeak。
+//
+// 文件格式（整数为小端，记录按 4 字节对齐）：
+//   文件头 | 哈希索引 | 索引区记录 | 追加区记录 ...
+// - 文件头记录格式版本、voice 与数据指纹（espeak 数据与库，见 EspeakWordCache），
+//   打开时任一不同即视为失效，清空重建；
+// - 哈希索引为开放寻址表（2 的幂个槽，装载率不超过 1/2，线性探测），槽内为词的 32 位哈希
+//   与记录偏移，查询直接在映射上进行；
+// - 新词以记录形式追加到文件末尾（记录带校验和，进程中途退出留下的残缺记录在下次打开时截掉），
+//   打开时扫描追加区读入内存；追加区达到一定规模后由后台线程压缩：把追加区并入索引，
+//   写临时文件后 rename 原子替换，再重新映射。
+//
+// 读者取得当前映射的快照（shared_ptr，同 LexiconStore）后不加锁查询；追加区由 mutex 保护。
+// 同一文件只应由一个 EspeakWordStore 打开（多进程同时写同一文件不受支持）。
+class EspeakWordStore {
+ public:
+  // 最多持久化的词数，达到后不再追加
+  static constexpr size_t kMaxEntries = 1 << 18;
+  // 追加区至少这么多词、且不少于索引区词数的一半时压缩
+  static constexpr size_t kMinCompactEntries = 256;
+
+  EspeakWordStore();
+  ~EspeakWordStore();  // 等待进行中的压缩
+
+  EspeakWordStore(const EspeakWordStore&) = delete;
+  EspeakWordStore& operator=(const EspeakWordStore&) = delete;
+
+  // 打开 path（不存在则新建）。文件头的格式版本、voice 或 data_fingerprint 与参数不同、
+  // 或文件已损坏时清空重建。失败（如目录不可写）返回 false，此后 Find / Append 无效果。
+  bool Open(const std::string& path, const std::string& voice,
+            uint64_t data_fingerprint);
+
+  bool Find(std::string_view word, std::u32string* phonemes) const;
+
+  // 追加一个词（已存在、已满或未打开时忽略），必要时在后台开始压缩
+  void Append(std::string_view word, const std::u32string& phonemes);
+
+  // 在调用线程上压缩（通常由 Append 在后台触发）；已在压缩时返回 false
+  bool Compact();
+
+  // 等待后台压缩结束（工具 / 退出前使用）
+  void WaitForCompaction();
+
+  size_t NumEntries() const;
+  size_t NumAppended() const;  // 追加区的词数（尚未压缩）
+
+ private:
+  struct Segment;
+  using TailMap = std::unordered_map<std::string, std::u32string>;
+
+  std::shared_ptr<const Segment> CurrentSegment() const;
+  // 调用方须持有 mutex_
+  bool ShouldCompactLocked() const;
+  void StartCompactionLocked();
+
+  std::string path_;
+  uint64_t voice_hash_ = 0;
+  uint64_t data_fingerprint_ = 0;
+
+  // 只通过 std::atomic_load / std::atomic_store 访问
+  std::shared_ptr<const Segment> segment_;
+
+  // 保护追加区、fd_ 与压缩线程的启动
+  mutable std::mutex mutex_;
+  int fd_ = -1;  // O_APPEND
+  TailMap tail_;
+  std::vector<const TailMap::value_type*> tail_order_;  // 追加顺序（元素地址在 rehash 后不变）
+
+  std::mutex compact_mutex_;  // 串行化 Compact
+  std::thread compactor_;
+  std::atomic<bool> compacting_{false};
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_ESPEAK_WORD_STORE_H_
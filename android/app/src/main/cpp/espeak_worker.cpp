@@ -0,0 +1,266 @@
+/**
+ * libsherpa-tts-espeak.so：包一层 piper-phonemize，只导出 espeak_worker.h 中的函数。
+ * 以 -Bsymbolic、--exclude-libs,ALL 链接，库内对 espeak 全局变量的引用总是落在本份库里，
+ * 因此同一进程中加载的多份副本互不干扰。
+ */
+#include "espeak_worker.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "espeak-ng/espeak_ng.h"
+#include "espeak-ng/speak_lib.h"
+#include "phonemize.hpp"  // piper-phonemize
+
+#define SHERPA_TTS_ESPEAK_EXPORT __attribute__((visibility("default")))
+
+// 上下文接口需要 android/third_party 中的 espeak-ng（espeak_ng_PHONEMIZER）与 piper-phonemize
+//（按子句回调的 phonemize_eSpeak）；用上游源码编译时只有经典接口
+#if defined(ESPEAK_NG_HAVE_PHONEMIZER) && defined(PIPERPHONEMIZE_HAVE_CLAUSE_FN)
+#define SHERPA_TTS_ESPEAK_HAVE_CONTEXTS 1
+#endif
+// 逐子句接口需要 piper-phonemize 的 phonemize_eSpeak_clauses
+#if defined(PIPERPHONEMIZE_HAVE_CLAUSE_STREAMING)
+#define SHERPA_TTS_ESPEAK_HAVE_CLAUSES 1
+#endif
+// 按文本末尾翻译子句（espeak_ng_TextToPhonemesInRange）：不必每个子句都对剩余文本 strlen，
+// 长文本的音素化为线性时间
+#if defined(ESPEAK_NG_HAVE_TEXT_RANGE) && defined(PIPERPHONEMIZE_HAVE_CLAUSE_RANGE_FN)
+#define SHERPA_TTS_ESPEAK_HAVE_TEXT_RANGE 1
+#endif
+
+namespace {
+
+// 经典接口的调用方（EspeakPool）已保证单线程使用；这里再加一把锁，直接使用本库时也安全。
+// 同时保护初始化状态与上下文计数
+std::mutex g_mutex;
+bool g_inited = false;
+std::string g_data_dir;
+std::string g_voice;  // 经典接口当前选中的 voice，空表示尚未选择
+int32_t g_num_contexts = 0;
+
+using Sentences = std::vector<std::vector<piper::Phoneme>>;
+
+int32_t Deliver(const Sentences& phonemes, SherpaTtsEspeakSentenceFn on_sentence,
+                void* user) {
+  for (const auto& sentence : phonemes) {
+    on_sentence(user, sentence.data(), sentence.size());
+  }
+  return static_cast<int32_t>(phonemes.size());
+}
+
+#if defined(PIPERPHONEMIZE_HAVE_CLAUSE_FN)
+// 经典接口的子句翻译
+auto ClassicTranslator() {
+#if defined(SHERPA_TTS_ESPEAK_HAVE_TEXT_RANGE)
+  return piper::eSpeakClauseRangeFn(espeak_ng_TextToPhonemesInRange);
+#else
+  return piper::eSpeakClauseFn(espeak_TextToPhonemesWithTerminator);
+#endif
+}
+
+// 只在 voice 变化时才选择 voice：piper-phonemize 每次调用都会重新 espeak_SetVoiceByName。
+// 调用方须持有 g_mutex
+bool SelectVoiceLocked(const std::string& voice) {
+  if (voice == g_voice) return true;
+  g_voice.clear();
+  if (espeak_SetVoiceByName(voice.c_str()) != EE_OK) return false;
+  g_voice = voice;
+  return true;
+}
+#endif
+
+#if defined(SHERPA_TTS_ESPEAK_HAVE_CLAUSES)
+// piper-phonemize 的子句回调转为 C 回调
+class ClauseForwarder {
+ public:
+  ClauseForwarder(SherpaTtsEspeakClauseFn on_clause, void* user)
+      : on_clause_(on_clause), user_(user) {}
+
+  bool operator()(const std::vector<piper::Phoneme>& phonemes, int terminator) {
+    int32_t flags = (terminator >> 12) & 0x7;  // CLAUSE_INTONATION_*
+    if ((terminator & CLAUSE_TYPE_SENTENCE) == CLAUSE_TYPE_SENTENCE) {
+      flags |= SHERPA_TTS_ESPEAK_CLAUSE_SENTENCE_END;
+    }
+    ++count_;
+    return on_clause_(user_, phonemes.data(), phonemes.size(), flags) != 0;
+  }
+
+  int32_t count() const { return count_; }
+
+ private:
+  SherpaTtsEspeakClauseFn on_clause_;
+  void* user_;
+  int32_t count_ = 0;
+};
+#endif
+
+#if defined(SHERPA_TTS_ESPEAK_HAVE_CONTEXTS)
+struct Context {
+  espeak_ng_PHONEMIZER* phonemizer = nullptr;
+  std::string voice;  // 空表示上次切换失败，须重新选择
+};
+
+bool SelectContextVoice(Context* ctx, const std::string& voice) {
+  if (voice == ctx->voice) return true;
+  ctx->voice.clear();
+  if (espeak_ng_SetPhonemizerVoice(ctx->phonemizer, voice.c_str()) != ENS_OK) return false;
+  ctx->voice = voice;
+  return true;
+}
+
+// 用上下文的翻译状态译一个子句
+#if defined(SHERPA_TTS_ESPEAK_HAVE_TEXT_RANGE)
+piper::eSpeakClauseRangeFn ClauseTranslator(Context* ctx) {
+  return [ctx](const void** textptr, const void* textend, int textmode, int phonememode,
+               int* terminator) {
+    return espeak_ng_PhonemizeClauseInRange(ctx->phonemizer, textptr, textend, textmode,
+                                            phonememode, terminator);
+  };
+}
+#else
+piper::eSpeakClauseFn ClauseTranslator(Context* ctx) {
+  return [ctx](const void** textptr, int textmode, int phonememode, int* terminator) {
+    return espeak_ng_PhonemizeClause(ctx->phonemizer, textptr, textmode, phonememode,
+                                     terminator);
+  };
+}
+#endif
+#endif
+
+}  // namespace
+
+extern "C" {
+
+SHERPA_TTS_ESPEAK_EXPORT int32_t sherpa_tts_espeak_init(const char* data_dir) {
+  if (!data_dir || !*data_dir) return 0;
+  std::lock_guard<std::mutex> lock(g_mutex);
+  if (g_inited && g_data_dir == data_dir) return 1;
+  // 上下文引用着已加载的音素表，重新初始化会使其失效
+  if (g_num_contexts > 0) return 0;
+  g_inited = espeak_Initialize(AUDIO_OUTPUT_SYNCHRONOUS, 0, data_dir, 0) == 22050;
+  g_data_dir = g_inited ? data_dir : "";
+  g_voice.clear();
+  return g_inited ? 1 : 0;
+}
+
+SHERPA_TTS_ESPEAK_EXPORT int32_t sherpa_tts_espeak_phonemize(
+    const char* text, const char* voice, SherpaTtsEspeakSentenceFn on_sentence,
+    void* user) {
+  if (!text || !on_sentence) return -1;
+  Sentences phonemes;
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!g_inited) return -1;
+    piper::eSpeakPhonemeConfig config;
+    config.voice = voice && *voice ? voice : "ru";
+#if defined(PIPERPHONEMIZE_HAVE_CLAUSE_FN)
+    if (!SelectVoiceLocked(config.voice)) return -1;
+    try {
+      piper::phonemize_eSpeak(text, config, phonemes, ClassicTranslator());
+    } catch (...) {
+      return -1;
+    }
+#else
+    // voice 不存在时 piper-phonemize 抛异常，不能让它穿过 C 接口
+    try {
+      piper::phonemize_eSpeak(text, config, phonemes);
+    } catch (...) {
+      return -1;
+    }
+#endif
+  }
+  return Deliver(phonemes, on_sentence, user);
+}
+
+#if defined(SHERPA_TTS_ESPEAK_HAVE_CLAUSES)
+
+SHERPA_TTS_ESPEAK_EXPORT int32_t sherpa_tts_espeak_phonemize_clauses(
+    const char* text, const char* voice, SherpaTtsEspeakClauseFn on_clause, void* user) {
+  if (!text || !on_clause) return -1;
+  std::lock_guard<std::mutex> lock(g_mutex);
+  if (!g_inited) return -1;
+  piper::eSpeakPhonemeConfig config;
+  config.voice = voice && *voice ? voice : "ru";
+  if (!SelectVoiceLocked(config.voice)) return -1;
+  ClauseForwarder forward(on_clause, user);
+  try {
+    piper::phonemize_eSpeak_clauses(text, config, ClassicTranslator(), std::ref(forward));
+  } catch (...) {
+    return -1;
+  }
+  return forward.count();
+}
+
+#endif  // SHERPA_TTS_ESPEAK_HAVE_CLAUSES
+
+#if defined(SHERPA_TTS_ESPEAK_HAVE_CONTEXTS)
+
+SHERPA_TTS_ESPEAK_EXPORT void* sherpa_tts_espeak_context_create(const char* voice) {
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!g_inited) return nullptr;
+    // 先计数：创建期间 init 不能换 data_dir
+    ++g_num_contexts;
+  }
+  auto* context = new Context;
+  context->voice = voice && *voice ? voice : "ru";
+  if (espeak_ng_CreatePhonemizer(context->voice.c_str(), &context->phonemizer) != ENS_OK) {
+    sherpa_tts_espeak_context_destroy(context);
+    return nullptr;
+  }
+  return context;
+}
+
+SHERPA_TTS_ESPEAK_EXPORT int32_t sherpa_tts_espeak_context_phonemize(
+    void* context, const char* text, const char* voice,
+    SherpaTtsEspeakSentenceFn on_sentence, void* user) {
+  if (!context || !text || !on_sentence) return -1;
+  auto* ctx = static_cast<Context*>(context);
+  piper::eSpeakPhonemeConfig config;
+  config.voice = voice && *voice ? voice : "ru";
+  if (!SelectContextVoice(ctx, config.voice)) return -1;
+  Sentences phonemes;
+  try {
+    piper::phonemize_eSpeak(text, config, phonemes, ClauseTranslator(ctx));
+  } catch (...) {
+    return -1;
+  }
+  return Deliver(phonemes, on_sentence, user);
+}
+
+#if defined(SHERPA_TTS_ESPEAK_HAVE_CLAUSES)
+
+SHERPA_TTS_ESPEAK_EXPORT int32_t sherpa_tts_espeak_context_phonemize_clauses(
+    void* context, const char* text, const char* voice, SherpaTtsEspeakClauseFn on_clause,
+    void* user) {
+  if (!context || !text || !on_clause) return -1;
+  auto* ctx = static_cast<Context*>(context);
+  piper::eSpeakPhonemeConfig config;
+  config.voice = voice && *voice ? voice : "ru";
+  if (!SelectContextVoice(ctx, config.voice)) return -1;
+  ClauseForwarder forward(on_clause, user);
+  try {
+    piper::phonemize_eSpeak_clauses(text, config, ClauseTranslator(ctx), std::ref(forward));
+  } catch (...) {
+    return -1;
+  }
+  return forward.count();
+}
+
+#endif  // SHERPA_TTS_ESPEAK_HAVE_CLAUSES
+
+SHERPA_TTS_ESPEAK_EXPORT void sherpa_tts_espeak_context_destroy(void* context) {
+  if (!context) return;
+  auto* ctx = static_cast<Context*>(context);
+  espeak_ng_DestroyPhonemizer(ctx->phonemizer);
+  delete ctx;
+  std::lock_guard<std::mutex> lock(g_mutex);
+  --g_num_contexts;
+}
+
+#endif  // SHERPA_TTS_ESPEAK_HAVE_CONTEXTS
+
+}  // extern "C"
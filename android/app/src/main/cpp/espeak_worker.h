@@ -0,0 +1,95 @@
+#ifndef SHERPA_TTS_ESPEAK_WORKER_H_
+#define SHERPA_TTS_ESPEAK_WORKER_H_
+
+// libsherpa-tts-espeak.so 的 C 接口：espeak-ng 与 piper-phonemize 静态链接在这个库里，
+// 其余符号全部隐藏。
+// - 上下文接口（sherpa_tts_espeak_context_*）：每个上下文持有一份独立的 espeak 翻译状态
+//   （espeak_ng_PHONEMIZER），不同上下文可在不同线程上同时音素化，音素表与词典在库内只加载
+//   一份、只读共享。用 android/third_party 下的 espeak-ng 编译时才导出。
+// - 经典接口（sherpa_tts_espeak_phonemize）：走 espeak 的全局状态，同一份库同一时刻只有
+//   一个调用在执行；上下文接口不可用时 EspeakPool 加载多份库来并行（见 espeak_pool.h）。
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+
+// piper-phonemize 切出的一句的音素码点（含标点），n 可为 0
+typedef void (*SherpaTtsEspeakSentenceFn)(void* user, const char32_t* phonemes,
+                                          size_t n);
+
+// 逐子句回调：espeak 每译出一个子句即调用一次，phonemes 含按子句结束方式追加的标点，
+// flags 见下面的 SHERPA_TTS_ESPEAK_CLAUSE_*。返回 0 时停止音素化剩余文本
+typedef int32_t (*SherpaTtsEspeakClauseFn)(void* user, const char32_t* phonemes,
+                                           size_t n, int32_t flags);
+
+// SherpaTtsEspeakClauseFn 的 flags：低 4 位为子句的语调（同 espeak 的 CLAUSE_INTONATION_*），
+// SHERPA_TTS_ESPEAK_CLAUSE_SENTENCE_END 表示该子句结束一句
+#define SHERPA_TTS_ESPEAK_CLAUSE_FULL_STOP 0
+#define SHERPA_TTS_ESPEAK_CLAUSE_COMMA 1
+#define SHERPA_TTS_ESPEAK_CLAUSE_QUESTION 2
+#define SHERPA_TTS_ESPEAK_CLAUSE_EXCLAMATION 3
+#define SHERPA_TTS_ESPEAK_CLAUSE_NONE 4
+#define SHERPA_TTS_ESPEAK_CLAUSE_INTONATION_MASK 0x0F
+#define SHERPA_TTS_ESPEAK_CLAUSE_SENTENCE_END 0x10
+
+// 初始化（或换 data_dir 后重新初始化）本份库中的 espeak；成功返回 1。
+// 仍有上下文存在时不能换 data_dir，返回 0
+typedef int32_t (*SherpaTtsEspeakInitFn)(const char* data_dir);
+
+// 音素化 text（UTF-8），每句回调一次；返回句数，未初始化或 voice 无效返回 -1
+typedef int32_t (*SherpaTtsEspeakPhonemizeFn)(const char* text,
+                                              const char* voice,
+                                              SherpaTtsEspeakSentenceFn on_sentence,
+                                              void* user);
+
+// 以 voice 创建一个上下文（须先 init）；失败返回 nullptr
+typedef void* (*SherpaTtsEspeakContextCreateFn)(const char* voice);
+
+// 用上下文音素化 text，语义同 SherpaTtsEspeakPhonemizeFn；同一上下文不能被两个线程同时使用。
+// voice 与上次不同时切换 voice，上下文最近用过的 voice 保持加载，切换回来只是换指针
+typedef int32_t (*SherpaTtsEspeakContextPhonemizeFn)(void* context, const char* text,
+                                                     const char* voice,
+                                                     SherpaTtsEspeakSentenceFn on_sentence,
+                                                     void* user);
+
+typedef void (*SherpaTtsEspeakContextDestroyFn)(void* context);
+
+// 逐子句版本（与 android/third_party 中的 piper-phonemize 一起编译时才导出）：
+// 不等整段译完，每个子句译出后即在调用线程上回调；返回子句数，失败返回 -1。
+// 经典接口的回调在持有库内的锁时执行，回调中不能再调用本库
+typedef int32_t (*SherpaTtsEspeakPhonemizeClausesFn)(const char* text, const char* voice,
+                                                     SherpaTtsEspeakClauseFn on_clause,
+                                                     void* user);
+
+typedef int32_t (*SherpaTtsEspeakContextPhonemizeClausesFn)(
+    void* context, const char* text, const char* voice, SherpaTtsEspeakClauseFn on_clause,
+    void* user);
+
+int32_t sherpa_tts_espeak_init(const char* data_dir);
+
+int32_t sherpa_tts_espeak_phonemize(const char* text, const char* voice,
+                                    SherpaTtsEspeakSentenceFn on_sentence,
+                                    void* user);
+
+int32_t sherpa_tts_espeak_phonemize_clauses(const char* text, const char* voice,
+                                            SherpaTtsEspeakClauseFn on_clause,
+                                            void* user);
+
+void* sherpa_tts_espeak_context_create(const char* voice);
+
+int32_t sherpa_tts_espeak_context_phonemize(void* context, const char* text,
+                                            const char* voice,
+                                            SherpaTtsEspeakSentenceFn on_sentence,
+                                            void* user);
+
+int32_t sherpa_tts_espeak_context_phonemize_clauses(void* context, const char* text,
+                                                    const char* voice,
+                                                    SherpaTtsEspeakClauseFn on_clause,
+                                                    void* user);
+
+void sherpa_tts_espeak_context_destroy(void* context);
+
+}  // extern "C"
+
+#endif  // SHERPA_TTS_ESPEAK_WORKER_H_
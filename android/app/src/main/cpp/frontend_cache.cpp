@@ -0,0 +1,169 @@
+#include "frontend_cache.h"
+
+#include <vector>
+
+#include "lexicon_store.h"
+#include "token_table.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+// 键：各字段以 0x1F（单元分隔符）连接，文本放最后；模式后的 kind 区分整段（'t'）与逐句（'c'）
+std::string MakeKeyPrefix(FrontendMode mode, const std::string& voice,
+                          const LexiconSnapshot* lexicon,
+                          const TokenTable* token_table, char kind) {
+  std::string prefix = std::to_string(static_cast<int32_t>(mode));
+  prefix += kind;
+  prefix += '\x1f';
+  prefix += voice;
+  prefix += '\x1f';
+  prefix += std::to_string(lexicon ? lexicon->Version() : 0);
+  prefix += '\x1f';
+  prefix += std::to_string(token_table ? token_table->Fingerprint() : 0);
+  prefix += '\x1f';
+  return prefix;
+}
+
+}  // namespace
+
+FrontendCache::FrontendCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+bool FrontendCache::GetText(const std::string& text, const std::string& voice,
+                            FrontendMode mode, const LexiconSnapshot* lexicon,
+                            const TokenTable* token_table, SentenceChunks* out) {
+  FrontendResult result;
+  std::vector<size_t> chunk_ends;
+  std::vector<size_t> sentence_ends;
+  if (!Get(MakeKeyPrefix(mode, voice, lexicon, token_table, 't') + text, false, &result,
+           &chunk_ends, &sentence_ends)) {
+    return false;
+  }
+  out->assign(sentence_ends.size(), {});
+  size_t chunk = 0;
+  size_t begin = 0;
+  for (size_t i = 0; i < sentence_ends.size(); ++i) {
+    for (; chunk < sentence_ends[i]; ++chunk) {
+      (*out)[i].emplace_back(result.token_ids.begin() + begin,
+                             result.token_ids.begin() + chunk_ends[chunk]);
+      begin = chunk_ends[chunk];
+    }
+  }
+  return true;
+}
+
+void FrontendCache::PutText(const std::string& text, const std::string& voice,
+                            FrontendMode mode, const LexiconSnapshot* lexicon,
+                            const TokenTable* token_table, const SentenceChunks& chunks) {
+  FrontendResult result;
+  result.code = FrontendErrorCode::kOk;
+  std::vector<size_t> chunk_ends;
+  std::vector<size_t> sentence_ends;
+  sentence_ends.reserve(chunks.size());
+  for (const std::vector<std::vector<int64_t>>& sentence : chunks) {
+    for (const std::vector<int64_t>& ids : sentence) {
+      result.token_ids.insert(result.token_ids.end(), ids.begin(), ids.end());
+      chunk_ends.push_back(result.token_ids.size());
+    }
+    sentence_ends.push_back(chunk_ends.size());
+  }
+  Put(MakeKeyPrefix(mode, voice, lexicon, token_table, 't') + text, result,
+      std::move(chunk_ends), std::move(sentence_ends));
+}
+
+FrontendResult FrontendCache::RouteChunks(const std::string& text,
+                                          const std::string& data_dir,
+                                          const std::string& voice, FrontendMode mode,
+                                          const LexiconSnapshot* lexicon,
+                                          const TokenTable* token_table,
+                                          const G2pEngine* g2p,
+                                          const FrontendChunkFn& on_chunk) {
+  std::string key = MakeKeyPrefix(mode, voice, lexicon, token_table, 'c') + text;
+  FrontendResult result;
+  std::vector<size_t> chunk_ends;
+  if (Get(key, true, &result, &chunk_ends)) {
+    size_t begin = 0;
+    for (size_t end : chunk_ends) {
+      std::vector<int64_t> ids(result.token_ids.begin() + begin,
+                               result.token_ids.begin() + end);
+      begin = end;
+      if (!on_chunk(std::move(ids))) break;
+    }
+    result.token_ids.clear();
+    return result;
+  }
+
+  // 交出前留一份副本，全部交出（未被下游中止）后才缓存
+  std::vector<int64_t> all;
+  bool complete = true;
+  result = RouteTextToTokenChunks(
+      text, data_dir, voice, mode, lexicon, token_table, g2p,
+      [&](std::vector<int64_t>&& ids) {
+        all.insert(all.end(), ids.begin(), ids.end());
+        chunk_ends.push_back(all.size());
+        complete = on_chunk(std::move(ids));
+        return complete;
+      });
+  if (complete && result.code == FrontendErrorCode::kOk) {
+    FrontendResult cached = result;
+    cached.token_ids = std::move(all);
+    Put(std::move(key), cached, std::move(chunk_ends));
+  }
+  return result;
+}
+
+bool FrontendCache::Get(const std::string& key, bool sentence, FrontendResult* out,
+                        std::vector<size_t>* chunk_ends,
+                        std::vector<size_t>* sentence_ends) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++(sentence ? stats_.sentence_misses : stats_.text_misses);
+    return false;
+  }
+  ++(sentence ? stats_.sentence_hits : stats_.text_hits);
+  lru_.splice(lru_.begin(), lru_, it->second);
+  *out = it->second->result;
+  *chunk_ends = it->second->chunk_ends;
+  if (sentence_ends) *sentence_ends = it->second->sentence_ends;
+  return true;
+}
+
+void FrontendCache::Put(std::string key, const FrontendResult& result,
+                        std::vector<size_t> chunk_ends, std::vector<size_t> sentence_ends) {
+  if (result.code != FrontendErrorCode::kOk) return;
+  // 粗略估计：键 + id + 分段 + 链表 / 哈希表节点开销
+  const size_t bytes = key.size() * 2 + result.token_ids.size() * sizeof(int64_t) +
+                       (chunk_ends.size() + sentence_ends.size()) * sizeof(size_t) +
+                       sizeof(Entry) + 64;
+  if (bytes > max_bytes_ / 8) return;  // 过长的文本不值得占用缓存
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index_.count(key) > 0) return;  // 并发计算了同一文本
+  lru_.push_front(
+      {std::move(key), result, std::move(chunk_ends), std::move(sentence_ends), bytes});
+  index_.emplace(lru_.front().key, lru_.begin());
+  bytes_ += bytes;
+  while (bytes_ > max_bytes_ && !lru_.empty()) {
+    bytes_ -= lru_.back().bytes;
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+void FrontendCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+FrontendCacheStats FrontendCache::Stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FrontendCacheStats stats = stats_;
+  stats.entries = lru_.size();
+  stats.bytes = bytes_;
+  return stats;
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,105 @@
+#ifndef SHERPA_TTS_FRONTEND_CACHE_H_
+#define SHERPA_TTS_FRONTEND_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "frontend_router.h"
+
+namespace sherpa_tts {
+
+class G2pEngine;
+class LexiconSnapshot;
+class TokenTable;
+
+// 缓存计数（自构造起累计，Clear 不清零）
+struct FrontendCacheStats {
+  uint64_t text_hits = 0;  // 整段文本（切句前，GetText）命中
+  uint64_t text_misses = 0;
+  uint64_t sentence_hits = 0;  // 整段未命中后逐句查询（RouteChunks）的命中
+  uint64_t sentence_misses = 0;
+  uint64_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;
+
+  double TextHitRatio() const {
+    const uint64_t n = text_hits + text_misses;
+    return n > 0 ? static_cast<double>(text_hits) / n : 0;
+  }
+  double SentenceHitRatio() const {
+    const uint64_t n = sentence_hits + sentence_misses;
+    return n > 0 ? static_cast<double>(sentence_hits) / n : 0;
+  }
+};
+
+// 第 i 句依次交出的各段 token id（下标为句号）
+using SentenceChunks = std::vector<std::vector<std::vector<int64_t>>>;
+
+// 前端结果缓存（LRU，按字节数限界，线程安全），分整段文本与逐句两级。
+// 前端对 (文本, 模式, voice, 词典快照版本, TokenTable 指纹) 是确定的，键即由这些组成；
+// 词典重载后新快照版本不同，旧条目不会再命中，调用方另应 Clear() 及时释放。
+// 只缓存成功（kOk）的结果：espeak 初始化失败等可能是暂时的。
+class FrontendCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 2 << 20;
+
+  explicit FrontendCache(size_t max_bytes = kDefaultMaxBytes);
+
+  FrontendCache(const FrontendCache&) = delete;
+  FrontendCache& operator=(const FrontendCache&) = delete;
+
+  // 整段文本（切句前）的查询，计入 text_* 计数。命中时 out 为各句的分段（同 PutText 写入的）。
+  bool GetText(const std::string& text, const std::string& voice, FrontendMode mode,
+               const LexiconSnapshot* lexicon, const TokenTable* token_table,
+               SentenceChunks* out);
+
+  // 整段文本的各句全部成功合成后写入，键同 GetText
+  void PutText(const std::string& text, const std::string& voice, FrontendMode mode,
+               const LexiconSnapshot* lexicon, const TokenTable* token_table,
+               const SentenceChunks& chunks);
+
+  // 一句的分段前端（参数同 RouteTextToTokenChunks，g2p 为句柄持有、生命周期内不变的模型），
+  // 计入 sentence_* 计数。命中时按缓存的分段依次交出；
+  // 未命中时边计算边交出，全部交出后连同分段位置写入缓存。
+  FrontendResult RouteChunks(const std::string& text, const std::string& data_dir,
+                             const std::string& voice, FrontendMode mode,
+                             const LexiconSnapshot* lexicon,
+                             const TokenTable* token_table, const G2pEngine* g2p,
+                             const FrontendChunkFn& on_chunk);
+
+  // 丢弃全部条目（词典重载 / 增量修改后调用）
+  void Clear();
+
+  FrontendCacheStats Stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    FrontendResult result;
+    std::vector<size_t> chunk_ends;  // 各段在 token_ids 中的结束位置
+    std::vector<size_t> sentence_ends;  // 整段条目：各句的最后一段在 chunk_ends 中的结束位置
+    size_t bytes;
+  };
+
+  bool Get(const std::string& key, bool sentence, FrontendResult* out,
+           std::vector<size_t>* chunk_ends, std::vector<size_t>* sentence_ends = nullptr);
+  void Put(std::string key, const FrontendResult& result, std::vector<size_t> chunk_ends,
+           std::vector<size_t> sentence_ends = {});
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  std::list<Entry> lru_;  // 表头最近使用
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t bytes_ = 0;
+  FrontendCacheStats stats_;
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_FRONTEND_CACHE_H_
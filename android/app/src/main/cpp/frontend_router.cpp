@@ -1,7 +1,11 @@
 #include "frontend_router.h"
 
 #include "espeak_phonemize.h"
+#include "g2p_engine.h"
 #include "lexicon.h"
+#include "lexicon_store.h"
+#include "text_fold.h"
+#include "text_segment.h"
 #include "token_table.h"
 
 #include <utility>
@@ -19,6 +23,7 @@ FrontendErrorCode MapEspeakError(EspeakErrorCode code) {
     case EspeakErrorCode::kInitFailed:
       return FrontendErrorCode::kEspeakInitFailed;
     case EspeakErrorCode::kPhonemeEmpty:
+    case EspeakErrorCode::kWordSplitMismatch:
       return FrontendErrorCode::kEspeakPhonemeEmpty;
     case EspeakErrorCode::kMissingSpecialTokens:
     case EspeakErrorCode::kTokenMiss:
@@ -29,49 +34,292 @@ FrontendErrorCode MapEspeakError(EspeakErrorCode code) {
   }
 }
 
+// 整句交给 espeak
+void RouteEspeak(const std::string& text, const std::string& data_dir,
+                 const std::string& voice, const TokenTable* token_table,
+                 FrontendResult* result) {
+  if (data_dir.empty()) {
+    result->code = FrontendErrorCode::kEspeakDataMissing;
+    return;
+  }
+  EspeakResult espeak =
+      TextToTokenIdsWithEspeakDetailed(text, data_dir, voice, token_table);
+  result->used_espeak = (espeak.code == EspeakErrorCode::kOk);
+  result->espeak_phoneme_count = espeak.phoneme_count;
+  result->espeak_matched_count = espeak.matched_phoneme_count;
+  result->token_ids = std::move(espeak.token_ids);
+  result->code = MapEspeakError(espeak.code);
+}
+
+// 整句交给 espeak，逐子句分段交出
+void RouteEspeakChunks(const std::string& text, const std::string& data_dir,
+                       const std::string& voice, const TokenTable* token_table,
+                       const FrontendChunkFn& on_chunk, FrontendResult* result) {
+  if (data_dir.empty()) {
+    result->code = FrontendErrorCode::kEspeakDataMissing;
+    return;
+  }
+  EspeakResult espeak = StreamTextToTokenIdsWithEspeak(
+      text, data_dir, voice, token_table, [&](EspeakChunk&& chunk) {
+        ++result->num_chunks;
+        return on_chunk(std::move(chunk.token_ids));
+      });
+  result->used_espeak = (espeak.code == EspeakErrorCode::kOk);
+  result->espeak_phoneme_count = espeak.phoneme_count;
+  result->espeak_matched_count = espeak.matched_phoneme_count;
+  result->code = MapEspeakError(espeak.code);
+}
+
+// 先查词典（kAuto / kLexiconFirst）；命中或 kLexiconFirst 未命中时结果已定，返回 true
+bool RouteLexicon(const std::string& text, FrontendMode mode,
+                  const LexiconSnapshot* lexicon, const TokenTable* token_table,
+                  FrontendResult* result) {
+  result->token_ids =
+      lexicon ? TextToTokenIds(text, lexicon->Layers(), lexicon->NumLayers(),
+                               token_table)
+              : TextToTokenIds(text, nullptr, token_table);
+  result->lexicon_token_count = static_cast<int32_t>(result->token_ids.size());
+  if (!result->token_ids.empty()) {
+    result->code = FrontendErrorCode::kOk;
+    result->used_lexicon = true;
+    return true;
+  }
+  if (mode == FrontendMode::kLexiconFirst) {
+    result->code = FrontendErrorCode::kLexiconMiss;
+    return true;
+  }
+  return false;
+}
+
+// 逐词混合。未命中的词先交给 g2p（非空时），否则 / 失败时交给 espeak；
+// espeak 也不可用或失败时按 TextToTokenIds 的规则回退（整词 / 逐字符查 TokenTable）；
+// espeak 未能逐词切分时整句交给 espeak。
+void RouteHybrid(const std::string& text, const std::string& data_dir,
+                 const std::string& voice, const LexiconSnapshot* lexicon,
+                 const TokenTable* token_table, const G2pEngine* g2p,
+                 FrontendResult* result) {
+  const Lexicon* const* layers = lexicon ? lexicon->Layers() : nullptr;
+  const size_t num_layers = lexicon ? lexicon->NumLayers() : 0;
+  std::vector<LexiconSegment> segments;
+  SegmentWithLexicon(text, layers, num_layers, &segments);
+  std::vector<std::string> misses;
+  for (const LexiconSegment& seg : segments) {
+    if (!seg.hit) misses.emplace_back(seg.text);
+  }
+  result->lexicon_word_count =
+      static_cast<int32_t>(segments.size() - misses.size());
+
+  // 未命中词的 token id 与各词的分界（g2p 或 espeak 的结果，布局相同）
+  EspeakResult oov;
+  if (!misses.empty() && g2p) {
+    G2pResult converted = g2p->PhonemizeWords(misses);
+    result->g2p_phoneme_count = converted.phoneme_count;
+    if (converted.code == G2pErrorCode::kOk) {
+      result->used_g2p = true;
+      result->g2p_word_count = static_cast<int32_t>(misses.size());
+      oov.token_ids = std::move(converted.token_ids);
+      oov.word_offsets = std::move(converted.word_offsets);
+      misses.clear();
+    }
+  }
+  result->espeak_word_count = static_cast<int32_t>(misses.size());
+  if (!misses.empty()) {
+    oov = data_dir.empty()
+                 ? EspeakResult{}
+                 : PhonemizeWordsWithEspeak(misses, data_dir, voice, token_table);
+    if (oov.code == EspeakErrorCode::kWordSplitMismatch) {
+      RouteEspeak(text, data_dir, voice, token_table, result);
+      return;
+    }
+    result->espeak_phoneme_count = oov.phoneme_count;
+    result->espeak_matched_count = oov.matched_phoneme_count;
+    if (oov.code != EspeakErrorCode::kOk) {
+      result->token_ids = TextToTokenIds(text, layers, num_layers, token_table);
+      result->lexicon_token_count =
+          static_cast<int32_t>(result->token_ids.size());
+      result->used_lexicon = result->lexicon_word_count > 0;
+      if (!result->token_ids.empty()) {
+        result->code = FrontendErrorCode::kOk;
+      } else {
+        result->code = data_dir.empty() ? FrontendErrorCode::kEspeakDataMissing
+                                        : MapEspeakError(oov.code);
+      }
+      return;
+    }
+    result->used_espeak = true;
+  }
+
+  // 一次推理的输入只用一种约定：Piper 风格的 tokens 下词典词条的 id 也逐个补填充、
+  // 词间插入空格音素、整句以 "^" / "$" 包围（同 PhonemesToTokenIds）；
+  // 词典式的 tokens 下各词直接拼接（espeak / g2p 的结果此时也不填充）
+  const bool piper = token_table->UsesPiperFraming();
+  const int64_t pid = piper ? token_table->TryGetId(U'_') : -1;
+  const int64_t sid = piper ? token_table->TryGetId(U' ') : -1;
+  std::vector<int64_t>& ids = result->token_ids;
+  if (piper) ids.push_back(token_table->TryGetId(U'^'));
+  const size_t body = ids.size();
+  size_t miss = 0;
+  for (const LexiconSegment& seg : segments) {
+    const int64_t* begin = seg.ids.begin();
+    const int64_t* end = seg.ids.end();
+    if (!seg.hit) {
+      begin = oov.token_ids.data() + oov.word_offsets[miss];
+      end = oov.token_ids.data() + oov.word_offsets[miss + 1];
+      ++miss;
+    }
+    if (begin == end) continue;  // 无读音的词不产生多余的分隔
+    if (sid >= 0 && ids.size() > body) {
+      ids.push_back(sid);
+      ids.push_back(pid);
+    }
+    if (!seg.hit) {
+      ids.insert(ids.end(), begin, end);
+      continue;
+    }
+    result->lexicon_token_count += static_cast<int32_t>(seg.ids.size);
+    for (const int64_t* it = begin; it != end; ++it) {
+      ids.push_back(*it);
+      if (pid >= 0) ids.push_back(pid);
+    }
+  }
+  result->used_lexicon = result->lexicon_word_count > 0;
+  if (ids.size() == body) {
+    ids.clear();
+    result->code = FrontendErrorCode::kLexiconMiss;
+    return;
+  }
+  if (piper) ids.push_back(token_table->TryGetId(U'$'));
+  result->code = FrontendErrorCode::kOk;
+}
+
 }  // namespace
 
 FrontendResult RouteTextToTokenIds(const std::string& text,
                                    const std::string& data_dir,
                                    const std::string& voice,
                                    FrontendMode mode,
-                                   const Lexicon* lexicon,
-                                   const TokenTable* token_table) {
+                                   const LexiconSnapshot* lexicon,
+                                   const TokenTable* token_table,
+                                   const G2pEngine* g2p) {
   FrontendResult result;
   if (!token_table || token_table->Size() == 0 || text.empty()) {
     result.code = FrontendErrorCode::kInvalidArgs;
     return result;
   }
 
-  if (mode != FrontendMode::kEspeakOnly) {
-    result.token_ids = TextToTokenIds(text, lexicon, token_table);
-    result.lexicon_token_count = static_cast<int32_t>(result.token_ids.size());
-    if (!result.token_ids.empty()) {
-      result.code = FrontendErrorCode::kOk;
-      result.used_lexicon = true;
-      return result;
-    }
-    if (mode == FrontendMode::kLexiconFirst) {
-      result.code = FrontendErrorCode::kLexiconMiss;
+  if (mode == FrontendMode::kHybrid || mode == FrontendMode::kNeuralG2p) {
+    RouteHybrid(text, data_dir, voice, lexicon, token_table,
+                mode == FrontendMode::kNeuralG2p ? g2p : nullptr, &result);
+    return result;
+  }
+
+  if (mode != FrontendMode::kEspeakOnly &&
+      RouteLexicon(text, mode, lexicon, token_table, &result)) {
+    return result;
+  }
+
+  RouteEspeak(text, data_dir, voice, token_table, &result);
+  return result;
+}
+
+FrontendResult RouteTextToTokenChunks(const std::string& text,
+                                      const std::string& data_dir,
+                                      const std::string& voice,
+                                      FrontendMode mode,
+                                      const LexiconSnapshot* lexicon,
+                                      const TokenTable* token_table,
+                                      const G2pEngine* g2p,
+                                      const FrontendChunkFn& on_chunk) {
+  FrontendResult result;
+  if (!token_table || token_table->Size() == 0 || text.empty() || !on_chunk) {
+    result.code = FrontendErrorCode::kInvalidArgs;
+    return result;
+  }
+  if (mode != FrontendMode::kAuto && mode != FrontendMode::kEspeakOnly) {
+    // 逐词路由的模式：结果由词典片段与逐词音素拼接而成，整体交出
+    result = RouteTextToTokenIds(text, data_dir, voice, mode, lexicon, token_table, g2p);
+  } else if (mode == FrontendMode::kEspeakOnly ||
+             !RouteLexicon(text, mode, lexicon, token_table, &result)) {
+    RouteEspeakChunks(text, data_dir, voice, token_table, on_chunk, &result);
+    return result;
+  }
+  if (result.code == FrontendErrorCode::kOk) {
+    result.num_chunks = 1;
+    on_chunk(std::move(result.token_ids));
+  }
+  result.token_ids.clear();
+  return result;
+}
+
+FrontendResult PhonemesToTokenIds(std::string_view phonemes,
+                                  const TokenTable* token_table) {
+  FrontendResult result;
+  if (!token_table || token_table->Size() == 0 || phonemes.empty()) {
+    result.code = FrontendErrorCode::kInvalidArgs;
+    return result;
+  }
+  const int64_t bid = token_table->TryGetId(U'^');
+  const int64_t pid = token_table->TryGetId(U'_');
+  const int64_t eid = token_table->TryGetId(U'$');
+  result.token_ids.reserve(phonemes.size() * 2 + 2);
+  if (bid >= 0) result.token_ids.push_back(bid);
+  char32_t cp;
+  for (size_t pos = 0, n = 0; (n = DecodeUtf8(phonemes, pos, &cp)) > 0; pos += n) {
+    if (!token_table->AppendIds(phonemes.substr(pos, n), &result.token_ids)) {
+      result.code = FrontendErrorCode::kTokenMiss;
+      result.token_ids.clear();
       return result;
     }
+    if (pid >= 0) result.token_ids.push_back(pid);
   }
+  if (eid >= 0) result.token_ids.push_back(eid);
+  result.code = FrontendErrorCode::kOk;
+  return result;
+}
 
-  if (data_dir.empty()) {
-    result.code = FrontendErrorCode::kEspeakDataMissing;
+FrontendResult TextCodepointsToTokenIds(std::string_view text,
+                                        const TokenTable* token_table) {
+  FrontendResult result;
+  if (!token_table || token_table->Size() == 0 || text.empty()) {
+    result.code = FrontendErrorCode::kInvalidArgs;
     return result;
   }
-
-  EspeakResult espeak =
-      TextToTokenIdsWithEspeakDetailed(text, data_dir, voice, token_table);
-  result.used_espeak = (espeak.code == EspeakErrorCode::kOk);
-  result.espeak_phoneme_count = espeak.phoneme_count;
-  result.espeak_matched_count = espeak.matched_phoneme_count;
-  result.token_ids = std::move(espeak.token_ids);
-  result.code = MapEspeakError(espeak.code);
+  std::string codepoints;
+  AppendLowercaseNfd(text, &codepoints);
+  const int64_t bid = token_table->TryGetId(U'^');
+  const int64_t pid = token_table->TryGetId(U'_');
+  const int64_t eid = token_table->TryGetId(U'$');
+  result.token_ids.reserve(codepoints.size() * 2 + 2);
+  if (bid >= 0) result.token_ids.push_back(bid);
+  size_t matched = 0;
+  char32_t cp;
+  for (size_t pos = 0, n = 0; (n = DecodeUtf8(codepoints, pos, &cp)) > 0; pos += n) {
+    if (!token_table->AppendIds(cp, &result.token_ids)) continue;
+    ++matched;
+    if (pid >= 0) result.token_ids.push_back(pid);
+  }
+  if (matched == 0) {
+    result.code = FrontendErrorCode::kTokenMiss;
+    result.token_ids.clear();
+    return result;
+  }
+  if (eid >= 0) result.token_ids.push_back(eid);
+  result.code = FrontendErrorCode::kOk;
   return result;
 }
 
+FrontendErrorCode ValidateTokenIds(const int64_t* ids, size_t n,
+                                   const TokenTable* token_table) {
+  if (!token_table || token_table->Size() == 0 || !ids || n == 0) {
+    return FrontendErrorCode::kInvalidArgs;
+  }
+  const int64_t max_id = token_table->MaxId();
+  for (size_t i = 0; i < n; ++i) {
+    if (ids[i] < 0 || ids[i] > max_id) return FrontendErrorCode::kTokenMiss;
+  }
+  return FrontendErrorCode::kOk;
+}
+
 const char* FrontendErrorCodeToString(FrontendErrorCode code) {
   switch (code) {
     case FrontendErrorCode::kOk:
@@ -103,6 +351,10 @@ const char* FrontendModeToString(FrontendMode mode) {
       return "lexicon_first";
     case FrontendMode::kEspeakOnly:
       return "espeak_only";
+    case FrontendMode::kHybrid:
+      return "hybrid";
+    case FrontendMode::kNeuralG2p:
+      return "neural_g2p";
     default:
       return "unknown";
   }
@@ -2,18 +2,28 @@
 #define SHERPA_TTS_FRONTEND_ROUTER_H_
 
 #include <cstdint>
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sherpa_tts {
 
-class Lexicon;
+class G2pEngine;
+class LexiconSnapshot;
 class TokenTable;
 
 enum class FrontendMode : int32_t {
   kAuto = 0,
   kLexiconFirst = 1,
   kEspeakOnly = 2,
+  // 逐词混合：词典命中的词直接取 id，未命中的词合并为一次 espeak 调用后按原文顺序拼接
+  //（按 TokenTable::UsesPiperFraming 统一填充、词间分隔与首尾）
+  kHybrid = 3,
+  // 同 kHybrid，但未命中的词先整批送 G2P 模型（一次推理、不持 espeak 的全局锁），
+  // 模型不可用或失败时再交给 espeak
+  kNeuralG2p = 4,
 };
 
 enum class FrontendErrorCode : int32_t {
@@ -35,13 +45,60 @@ struct FrontendResult {
   int32_t lexicon_token_count = 0;
   int32_t espeak_phoneme_count = 0;
   int32_t espeak_matched_count = 0;
+  // kHybrid：词典命中的片段数与送 espeak 的未命中词数
+  int32_t lexicon_word_count = 0;
+  int32_t espeak_word_count = 0;
+  // kNeuralG2p：由 G2P 模型转换的未命中词数与音素数
+  bool used_g2p = false;
+  int32_t g2p_word_count = 0;
+  int32_t g2p_phoneme_count = 0;
+  // RouteTextToTokenChunks：交出的段数
+  int32_t num_chunks = 0;
 };
 
+// 交出一段完整的推理输入（token id）；返回 false 时停止
+using FrontendChunkFn = std::function<bool(std::vector<int64_t>&& ids)>;
+
+// lexicon 为调用方持有的词典快照（可为空），整次调用期间保持有效。
+// g2p 仅 kNeuralG2p 使用，可为空（此时等同 kHybrid）。
 FrontendResult RouteTextToTokenIds(const std::string& text,
                                    const std::string& data_dir,
                                    const std::string& voice,
                                    FrontendMode mode,
-                                   const Lexicon* lexicon,
+                                   const LexiconSnapshot* lexicon,
+                                   const TokenTable* token_table,
+                                   const G2pEngine* g2p = nullptr);
+
+// 分段版 RouteTextToTokenIds：整句交给 espeak 的路径（kEspeakOnly、kAuto 词典未命中）
+// 逐子句流式输出（见 StreamTextToTokenIdsWithEspeak，每段各自带 "^" / "$"），espeak 译出
+// 首个子句后即回调 on_chunk，推理可以在其余子句仍在音素化时开始；on_chunk 不得阻塞。
+// 其他路径整体计算后作为一段交出。
+// 返回的 token_ids 为空（已交给 on_chunk），计数与错误码同 RouteTextToTokenIds。
+FrontendResult RouteTextToTokenChunks(const std::string& text,
+                                      const std::string& data_dir,
+                                      const std::string& voice,
+                                      FrontendMode mode,
+                                      const LexiconSnapshot* lexicon,
+                                      const TokenTable* token_table,
+                                      const G2pEngine* g2p,
+                                      const FrontendChunkFn& on_chunk);
+
+// 直接输入音素串（上游服务已完成文本前端，如 Piper / espeak 输出的 IPA）：
+// 只经 TokenTable 逐码点映射，不切句、不查词典、不调 espeak。
+// 输出格式同 espeak 路径："^"、每个音素后跟填充 "_"、"$"（tokens 中有时）。
+// 空串返回 kInvalidArgs，任一音素不在 tokens 中返回 kTokenMiss。
+FrontendResult PhonemesToTokenIds(std::string_view phonemes,
+                                  const TokenTable* token_table);
+
+// Piper "text" 音色（model.onnx.json 中 phoneme_type 为 "text"）：文本本身即音素序列。
+// 转小写并 NFD 分解（AppendLowercaseNfd）后逐码点经 TokenTable 映射，不查词典、不调 espeak；
+// tokens 中没有的码点跳过（同 Piper），一个都映射不到时返回 kTokenMiss。输出格式同 PhonemesToTokenIds。
+FrontendResult TextCodepointsToTokenIds(std::string_view text,
+                                        const TokenTable* token_table);
+
+// 校验直接输入的 token id：须在 [0, TokenTable::MaxId()] 内，越界返回 kTokenMiss，
+// 空输入返回 kInvalidArgs。
+FrontendErrorCode ValidateTokenIds(const int64_t* ids, size_t n,
                                    const TokenTable* token_table);
 
 const char* FrontendErrorCodeToString(FrontendErrorCode code);
@@ -0,0 +1,307 @@
+#include "g2p_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "onnx_util.h"
+#include "text_fold.h"
+#include "text_segment.h"
+#include "token_table.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+std::vector<std::string> SplitSymbols(const std::string& s) {
+  std::vector<std::string> out;
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t b = s.find_first_not_of(' ', pos);
+    if (b == std::string::npos) break;
+    size_t e = s.find(' ', b);
+    if (e == std::string::npos) e = s.size();
+    out.emplace_back(s, b, e - b);
+    pos = e;
+  }
+  return out;
+}
+
+bool IsSpecialSymbol(const std::string& s) {
+  return s.size() > 2 && s.front() == '<' && s.back() == '>';
+}
+
+}  // namespace
+
+class G2pEngine::Impl {
+ public:
+  Ort::SessionOptions opts_;
+  std::unique_ptr<Ort::Session> sess_;
+  std::vector<std::string> input_names_;
+  std::vector<const char*> input_names_ptr_;
+  std::vector<std::string> output_names_;
+  std::vector<const char*> output_names_ptr_;
+
+  // 单码点字素 -> 输入 id；多码点符号只用于 input_prefix / input_suffix
+  std::unordered_map<char32_t, int64_t> grapheme_ids_;
+  std::vector<int64_t> prefix_ids_;
+  std::vector<int64_t> suffix_ids_;
+  int64_t pad_id_ = 0;
+  int32_t char_repeats_ = 1;
+  bool ctc_ = false;
+
+  // 音素 id -> token id（整个符号在 tokens 中则取其 id，否则逐码点查），特殊符号为空
+  std::vector<std::vector<int64_t>> phoneme_tokens_;
+  std::vector<uint8_t> phoneme_special_;
+  int64_t end_id_ = -1;
+  int64_t pad_token_ = -1;
+  bool loaded_ = false;
+
+  Impl(const G2pConfig& config, const TokenTable* token_table) {
+    if (!token_table || token_table->Size() == 0) return;
+    std::vector<char> model_data = ReadFileBytes(config.model_path);
+    if (model_data.empty()) return;
+    opts_.SetIntraOpNumThreads(config.num_threads > 0 ? config.num_threads : 1);
+    opts_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    // G2P 模型可选，加载失败只禁用该前端，不让异常传到 JNI
+    try {
+      sess_ = std::make_unique<Ort::Session>(SharedOrtEnv(), model_data.data(),
+                                             model_data.size(), opts_);
+    } catch (const Ort::Exception&) {
+      sess_.reset();
+      return;
+    }
+    GetInputNames(sess_.get(), &input_names_, &input_names_ptr_);
+    GetOutputNames(sess_.get(), &output_names_, &output_names_ptr_);
+    if (input_names_.empty() || output_names_.empty()) return;
+
+    const std::vector<std::string> graphemes =
+        SplitSymbols(GetMetadataStr(sess_.get(), "graphemes"));
+    const std::vector<std::string> phonemes =
+        SplitSymbols(GetMetadataStr(sess_.get(), "phonemes"));
+    if (graphemes.empty() || phonemes.empty()) return;
+
+    std::unordered_map<std::string, int64_t> symbol_ids;
+    for (size_t i = 0; i < graphemes.size(); ++i) {
+      const std::string& g = graphemes[i];
+      symbol_ids.emplace(g, static_cast<int64_t>(i));
+      char32_t cp;
+      if (DecodeUtf8(g, 0, &cp) == g.size()) {
+        grapheme_ids_.emplace(cp, static_cast<int64_t>(i));
+      }
+    }
+    for (const auto& [key, ids] :
+         {std::make_pair("input_prefix", &prefix_ids_),
+          std::make_pair("input_suffix", &suffix_ids_)}) {
+      for (const std::string& s : SplitSymbols(GetMetadataStr(sess_.get(), key))) {
+        auto it = symbol_ids.find(s);
+        if (it != symbol_ids.end()) ids->push_back(it->second);
+      }
+    }
+    pad_id_ = GetMetadataInt(sess_.get(), "pad_id", 0);
+    char_repeats_ = std::max(1, GetMetadataInt(sess_.get(), "char_repeats", 1));
+    ctc_ = GetMetadataInt(sess_.get(), "ctc", 0) != 0;
+
+    phoneme_tokens_.resize(phonemes.size());
+    phoneme_special_.resize(phonemes.size());
+    for (size_t i = 0; i < phonemes.size(); ++i) {
+      const std::string& p = phonemes[i];
+      if (IsSpecialSymbol(p)) {
+        phoneme_special_[i] = 1;
+        if (p == "<end>") end_id_ = static_cast<int64_t>(i);
+        continue;
+      }
+      if (token_table->AppendIds(p, &phoneme_tokens_[i])) continue;
+      char32_t cp;
+      for (size_t pos = 0, n = 0; (n = DecodeUtf8(p, pos, &cp)) > 0; pos += n) {
+        token_table->AppendIds(std::string_view(p).substr(pos, n), &phoneme_tokens_[i]);
+      }
+    }
+    pad_token_ = token_table->UsesPiperFraming() ? token_table->TryGetId(U'_') : -1;
+    loaded_ = true;
+  }
+
+  // 单个词 -> 模型输入 id
+  void EncodeWord(const std::string& word, std::string* folded,
+                  std::vector<int64_t>* ids) const {
+    ids->clear();
+    folded->clear();
+    AppendFoldedText(word, folded);
+    ids->insert(ids->end(), prefix_ids_.begin(), prefix_ids_.end());
+    const size_t prefix_size = ids->size();
+    char32_t cp;
+    for (size_t pos = 0, n = 0; (n = DecodeUtf8(*folded, pos, &cp)) > 0; pos += n) {
+      auto it = grapheme_ids_.find(cp);
+      if (it == grapheme_ids_.end()) continue;
+      ids->insert(ids->end(), static_cast<size_t>(char_repeats_), it->second);
+    }
+    if (ids->size() == prefix_size) {  // 没有已知字符
+      ids->clear();
+      return;
+    }
+    ids->insert(ids->end(), suffix_ids_.begin(), suffix_ids_.end());
+  }
+
+  // 一个词的逐帧输出 -> token id，追加到 result
+  template <typename NextId>
+  void DecodeFrames(int64_t num_frames, NextId next_id, G2pResult* result) const {
+    int64_t prev = -1;
+    for (int64_t t = 0; t < num_frames; ++t) {
+      const int64_t id = next_id(t);
+      if (ctc_) {
+        const bool repeat = (id == prev);
+        prev = id;
+        if (repeat || id == pad_id_) continue;
+      }
+      if (id == end_id_) break;
+      if (id < 0 || static_cast<size_t>(id) >= phoneme_tokens_.size() ||
+          phoneme_special_[id]) {
+        continue;
+      }
+      result->phoneme_count += 1;
+      const std::vector<int64_t>& tokens = phoneme_tokens_[id];
+      if (tokens.empty()) continue;
+      result->matched_phoneme_count += 1;
+      for (int64_t tok : tokens) {
+        result->token_ids.push_back(tok);
+        if (pad_token_ >= 0) result->token_ids.push_back(pad_token_);
+      }
+    }
+  }
+
+  G2pResult PhonemizeWords(const std::vector<std::string>& words) const {
+    G2pResult result;
+    if (words.empty()) {
+      result.code = G2pErrorCode::kInvalidArgs;
+      return result;
+    }
+    const size_t batch = words.size();
+    std::vector<std::vector<int64_t>> encoded(batch);
+    std::string folded;
+    size_t max_len = 1;
+    bool any = false;
+    for (size_t b = 0; b < batch; ++b) {
+      EncodeWord(words[b], &folded, &encoded[b]);
+      max_len = std::max(max_len, encoded[b].size());
+      any = any || !encoded[b].empty();
+    }
+    if (!any) {
+      result.code = G2pErrorCode::kPhonemeEmpty;
+      return result;
+    }
+
+    // 补齐成 [batch, max_len]；空词按长度 1 的补齐符号送入，输出忽略
+    std::vector<int64_t> x(batch * max_len, pad_id_);
+    std::vector<int64_t> lengths(batch, 1);
+    for (size_t b = 0; b < batch; ++b) {
+      std::copy(encoded[b].begin(), encoded[b].end(), x.begin() + b * max_len);
+      if (!encoded[b].empty()) lengths[b] = static_cast<int64_t>(encoded[b].size());
+    }
+    Ort::MemoryInfo memory_info =
+        Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    std::array<int64_t, 2> x_shape = {static_cast<int64_t>(batch),
+                                      static_cast<int64_t>(max_len)};
+    const int64_t len_shape = static_cast<int64_t>(batch);
+    std::vector<Ort::Value> inputs;
+    inputs.push_back(Ort::Value::CreateTensor(memory_info, x.data(), x.size(),
+                                              x_shape.data(), x_shape.size()));
+    if (input_names_.size() >= 2) {
+      inputs.push_back(Ort::Value::CreateTensor(
+          memory_info, lengths.data(), lengths.size(), &len_shape, 1));
+    }
+
+    std::vector<Ort::Value> out;
+    try {
+      out = sess_->Run({}, input_names_ptr_.data(), inputs.data(), inputs.size(),
+                       output_names_ptr_.data(), 1);
+    } catch (const Ort::Exception&) {
+      result.code = G2pErrorCode::kRunFailed;
+      return result;
+    }
+    if (out.empty()) {
+      result.code = G2pErrorCode::kRunFailed;
+      return result;
+    }
+    Ort::TensorTypeAndShapeInfo info = out[0].GetTensorTypeAndShapeInfo();
+    const std::vector<int64_t> shape = info.GetShape();
+    const ONNXTensorElementDataType type = info.GetElementType();
+    const bool ids_out = type == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64 &&
+                         shape.size() == 2;
+    const bool logits_out = type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT &&
+                            shape.size() == 3;
+    if ((!ids_out && !logits_out) || shape[0] != static_cast<int64_t>(batch)) {
+      result.code = G2pErrorCode::kRunFailed;
+      return result;
+    }
+
+    const int64_t frames = shape[1];
+    result.word_offsets.reserve(batch + 1);
+    result.word_offsets.push_back(0);
+    for (size_t b = 0; b < batch; ++b) {
+      if (!encoded[b].empty()) {
+        if (ids_out) {
+          const int64_t* row = out[0].GetTensorData<int64_t>() + b * frames;
+          DecodeFrames(frames, [row](int64_t t) { return row[t]; }, &result);
+        } else {
+          const int64_t vocab = shape[2];
+          const float* row = out[0].GetTensorData<float>() + b * frames * vocab;
+          DecodeFrames(
+              frames,
+              [row, vocab](int64_t t) {
+                const float* p = row + t * vocab;
+                return static_cast<int64_t>(std::max_element(p, p + vocab) - p);
+              },
+              &result);
+        }
+      }
+      result.word_offsets.push_back(result.token_ids.size());
+    }
+    if (result.phoneme_count == 0) {
+      result.code = G2pErrorCode::kPhonemeEmpty;
+    } else if (result.matched_phoneme_count == 0) {
+      result.code = G2pErrorCode::kTokenMiss;
+    } else {
+      result.code = G2pErrorCode::kOk;
+    }
+    return result;
+  }
+};
+
+G2pEngine::G2pEngine(const G2pConfig& config, const TokenTable* token_table)
+    : impl_(std::make_unique<Impl>(config, token_table)) {}
+
+G2pEngine::~G2pEngine() = default;
+
+bool G2pEngine::IsLoaded() const { return impl_->loaded_; }
+
+G2pResult G2pEngine::PhonemizeWords(const std::vector<std::string>& words) const {
+  if (!impl_->loaded_) {
+    G2pResult result;
+    result.code = G2pErrorCode::kNotLoaded;
+    return result;
+  }
+  return impl_->PhonemizeWords(words);
+}
+
+const char* G2pErrorCodeToString(G2pErrorCode code) {
+  switch (code) {
+    case G2pErrorCode::kOk:
+      return "OK";
+    case G2pErrorCode::kNotLoaded:
+      return "NOT_LOADED";
+    case G2pErrorCode::kInvalidArgs:
+      return "INVALID_ARGS";
+    case G2pErrorCode::kRunFailed:
+      return "RUN_FAILED";
+    case G2pErrorCode::kPhonemeEmpty:
+      return "PHONEME_EMPTY";
+    case G2pErrorCode::kTokenMiss:
+      return "TOKEN_MISS";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+}  // namespace sherpa_tts
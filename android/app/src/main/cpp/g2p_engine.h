@@ -0,0 +1,75 @@
+#ifndef SHERPA_TTS_G2P_ENGINE_H_
+#define SHERPA_TTS_G2P_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sherpa_tts {
+
+class TokenTable;
+
+enum class G2pErrorCode : int32_t {
+  kOk = 0,
+  kNotLoaded = 1,
+  kInvalidArgs = 2,
+  kRunFailed = 3,
+  kPhonemeEmpty = 4,
+  kTokenMiss = 5,
+};
+
+struct G2pConfig {
+  std::string model_path;
+  int num_threads = 1;
+};
+
+struct G2pResult {
+  G2pErrorCode code = G2pErrorCode::kInvalidArgs;
+  // 第 i 个词的 id 为 token_ids[word_offsets[i], word_offsets[i+1])
+  std::vector<int64_t> token_ids;
+  std::vector<size_t> word_offsets;
+  int32_t phoneme_count = 0;
+  int32_t matched_phoneme_count = 0;
+};
+
+// 字素到音素（G2P）的小型 ONNX 模型，作为词典未命中词的另一种回退（与 espeak 并列）。
+// 会话建在进程共享的 Ort::Env 上；Run 可并发调用，不像 espeak 那样全局串行。
+//
+// 模型约定（自定义元数据；符号表以空格分隔，下标即 id）：
+// - "graphemes"：输入字符表；"phonemes"：输出音素表；
+// - "pad_id"（默认 0）：输入补齐用的 id，ctc=1 时同时是 blank；
+// - "char_repeats"（默认 1）：每个输入字符重复的次数（DeepPhonemizer 的 forward 模型为 3）；
+// - "ctc"（默认 0）：逐帧输出先合并相邻重复、再去掉 blank；
+// - "input_prefix" / "input_suffix"：每个词前后附加的输入符号（如语言标记 "<ru>"、"<end>"）。
+// 输入 0 为 int64 [batch, len]，若有输入 1 则为各词长度 int64 [batch]；
+// 输出 0 为 int64 [batch, len'] 的音素 id，或 float [batch, len', vocab] 的 logits（逐帧取 argmax）。
+// 形如 "<...>" 的音素是特殊符号，不输出；"<end>" 之后的帧丢弃。
+class G2pEngine {
+ public:
+  // token_table 须比本对象活得久；音素到 token id 的映射在构造时一次算好。
+  G2pEngine(const G2pConfig& config, const TokenTable* token_table);
+  ~G2pEngine();
+
+  G2pEngine(const G2pEngine&) = delete;
+  G2pEngine& operator=(const G2pEngine&) = delete;
+
+  // 模型加载成功且元数据完整
+  bool IsLoaded() const;
+
+  // 一次推理批量转换若干词（词典未命中的词按原文顺序传入）。
+  // 词先做大小写折叠；输出格式同 PhonemizeWordsWithEspeak：Piper 风格的 tokens 每个音素后跟
+  // 填充 "_"，否则不填充；不含首尾的 "^" / "$"。不含任何已知字符的词结果为空。
+  G2pResult PhonemizeWords(const std::vector<std::string>& words) const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+const char* G2pErrorCodeToString(G2pErrorCode code);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_G2P_ENGINE_H_
@@ -1,14 +1,200 @@
 #include "lexicon.h"
 
+#include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <iterator>
 #include <sstream>
-#include <unordered_set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "mapped_file.h"
+#include "text_fold.h"
+#include "text_segment.h"
 
 namespace sherpa_tts {
 
+// 词典的内存布局（文本加载时由 LexiconBuilder 生成，二进制格式按同样的段写入文件）。
+struct LexiconTables {
+  std::vector<uint32_t> key_offsets;
+  std::string key_blob;
+  std::vector<uint32_t> phone_offsets;
+  std::vector<uint32_t> phones;
+  std::vector<uint32_t> symbol_offsets;
+  std::string symbol_blob;
+  std::vector<LexiconTrieNode> trie_nodes;
+  std::vector<uint8_t> trie_first_bytes;
+};
+
 namespace {
 
+// 二进制文件头。各段偏移均相对文件起始，按 8 字节对齐；整数为小端（与 Android ABI 一致）。
+struct BinaryHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t num_entries;
+  uint32_t num_symbols;
+  uint64_t key_offsets;
+  uint64_t key_blob;
+  uint64_t key_blob_size;
+  uint64_t phone_offsets;
+  uint64_t phones;
+  uint64_t symbol_offsets;
+  uint64_t symbol_blob;
+  uint64_t symbol_blob_size;
+  uint32_t num_nodes;
+  uint32_t reserved;
+  uint64_t trie_nodes;
+  uint64_t trie_first_bytes;
+};
+
+constexpr size_t kSectionAlign = 8;
+constexpr uint32_t kNoEntry = 0xFFFFFFFFu;
+
+// 在已排序词表上按 BFS 构建压缩前缀树：同一父节点下按下一字节分组，
+// 组内最长公共前缀即为入边标签（引用组内首个词的字节，不另存字符串）。
+void BuildTrie(LexiconTables* t) {
+  const uint32_t n = static_cast<uint32_t>(t->key_offsets.size() - 1);
+  auto key = [t](uint32_t i) {
+    return std::string_view(t->key_blob.data() + t->key_offsets[i],
+                            t->key_offsets[i + 1] - t->key_offsets[i]);
+  };
+  struct Pending {
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t depth;
+  };
+  std::vector<Pending> pending = {{0, n, 0}};
+  t->trie_nodes.assign(1, {0, 0, 0, kNoEntry});
+  t->trie_first_bytes.assign(1, 0);
+  // pending[v] 与节点 v 一一对应，按下标顺序处理即为 BFS
+  for (size_t v = 0; v < pending.size(); ++v) {
+    const Pending p = pending[v];
+    t->trie_nodes[v].children = static_cast<uint32_t>(pending.size());
+    uint32_t i = p.lo;
+    // 与本节点等长的词就是本节点的词条，排在区间最前
+    if (i < p.hi && key(i).size() == p.depth) ++i;
+    while (i < p.hi) {
+      const char c = key(i)[p.depth];
+      uint32_t j = i + 1;
+      while (j < p.hi && key(j)[p.depth] == c) ++j;
+      std::string_view first = key(i);
+      std::string_view last = key(j - 1);
+      uint32_t lcp = p.depth + 1;
+      while (lcp < first.size() && lcp < last.size() && first[lcp] == last[lcp]) {
+        ++lcp;
+      }
+      t->trie_nodes.push_back({0, t->key_offsets[i] + p.depth, lcp - p.depth,
+                               first.size() == lcp ? i : kNoEntry});
+      t->trie_first_bytes.push_back(static_cast<uint8_t>(c));
+      pending.push_back({i, j, lcp});
+      i = j;
+    }
+  }
+  // 哨兵节点：给最后一个节点的子节点区间封口
+  const uint32_t num_nodes = static_cast<uint32_t>(pending.size());
+  t->trie_nodes.push_back({num_nodes, 0, 0, kNoEntry});
+}
+
+// 词条键规范化：去首尾空白，内部连续空白折叠为一个空格，再做大小写折叠与 NFC
+std::string NormalizeKey(std::string_view word) {
+  std::string out;
+  out.reserve(word.size());
+  bool pending_space = false;
+  for (char ch : word) {
+    if (std::isspace(static_cast<unsigned char>(ch))) {
+      pending_space = !out.empty();
+      continue;
+    }
+    if (pending_space) out += ' ';
+    pending_space = false;
+    out += ch;
+  }
+  // 快速路径就地折叠（逐字符先读后写，长度不变）
+  if (FoldTextFast(out, out.data())) return out;
+  std::string folded;
+  AppendFoldedText(out, &folded);
+  return folded;
+}
+
+// 收集词条（同词后写覆盖先写），结束时按词排序并驻留音素符号。
+class LexiconBuilder {
+ public:
+  // phonemes 为空时记为墓碑
+  void Add(std::string word, const std::vector<std::string>& phonemes) {
+    std::vector<uint32_t>& ids = entries_[std::move(word)];
+    ids.clear();
+    for (const auto& p : phonemes) ids.push_back(Intern(p));
+  }
+
+  void Build(LexiconTables* t) {
+    std::vector<const std::pair<const std::string, std::vector<uint32_t>>*>
+        sorted;
+    sorted.reserve(entries_.size());
+    for (const auto& kv : entries_) sorted.push_back(&kv);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    t->key_offsets.assign(1, 0);
+    t->phone_offsets.assign(1, 0);
+    t->key_blob.clear();
+    t->phones.clear();
+    t->key_offsets.reserve(sorted.size() + 1);
+    t->phone_offsets.reserve(sorted.size() + 1);
+    for (const auto* kv : sorted) {
+      t->key_blob += kv->first;
+      t->key_offsets.push_back(static_cast<uint32_t>(t->key_blob.size()));
+      t->phones.insert(t->phones.end(), kv->second.begin(), kv->second.end());
+      t->phone_offsets.push_back(static_cast<uint32_t>(t->phones.size()));
+    }
+
+    t->symbol_offsets.assign(1, 0);
+    t->symbol_blob.clear();
+    for (const auto& sym : symbols_) {
+      t->symbol_blob += sym;
+      t->symbol_offsets.push_back(static_cast<uint32_t>(t->symbol_blob.size()));
+    }
+    BuildTrie(t);
+  }
+
+ private:
+  uint32_t Intern(const std::string& sym) {
+    auto it = symbol_ids_.find(sym);
+    if (it != symbol_ids_.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(symbols_.size());
+    symbols_.push_back(sym);
+    symbol_ids_.emplace(sym, id);
+    return id;
+  }
+
+  std::unordered_map<std::string, std::vector<uint32_t>> entries_;
+  std::unordered_map<std::string, uint32_t> symbol_ids_;
+  std::vector<std::string> symbols_;
+};
+
+bool SectionFits(uint64_t off, uint64_t bytes, size_t file_size) {
+  return off <= file_size && bytes <= file_size - off;
+}
+
+bool U32SectionFits(uint64_t off, uint64_t count, size_t file_size) {
+  return off % alignof(uint32_t) == 0 && count <= file_size / 4 &&
+         SectionFits(off, count * 4, file_size);
+}
+
+// 写出一段并补齐到 kSectionAlign，返回该段起始偏移
+uint64_t WriteSection(std::ofstream& os, const void* data, size_t bytes) {
+  uint64_t off = static_cast<uint64_t>(os.tellp());
+  if (bytes > 0) os.write(static_cast<const char*>(data), bytes);
+  static const char kZeros[kSectionAlign] = {};
+  size_t pad = (kSectionAlign - bytes % kSectionAlign) % kSectionAlign;
+  if (pad > 0) os.write(kZeros, pad);
+  return off;
+}
+
 void Trim(std::string* s) {
   const char* ws = " \t\n\r\f\v";
   s->erase(0, s->find_first_not_of(ws));
@@ -23,120 +209,618 @@ std::vector<std::string> SplitLine(const std::string& line) {
   return out;
 }
 
-// UTF-8：返回从 pos 开始的字符占用的字节数，若非法则返回 1 并跳过该字节
-static size_t Utf8CharLen(const std::string& s, size_t pos) {
-  if (pos >= s.size()) return 0;
-  unsigned char c = static_cast<unsigned char>(s[pos]);
-  if (c < 0x80) return 1;
-  if (c < 0xc2) return 1;
-  if (c < 0xe0) return (pos + 2 <= s.size()) ? 2 : 1;
-  if (c < 0xf0) return (pos + 3 <= s.size()) ? 3 : 1;
-  if (c < 0xf8) return (pos + 4 <= s.size()) ? 4 : 1;
-  return 1;
-}
-
-bool IsAsciiPunct(unsigned char c) {
-  return std::ispunct(c) != 0;
-}
-
-bool IsUnicodePunct(const std::string& ch) {
-  // 中文 + 全角 + 西里尔/拉丁/法语/俄语等常用标点，便于多语言输入正确切词
-  static const std::unordered_set<std::string> kPunct = {
-      "，", "。", "！", "？", "；", "：", "、", "…", "—", "–",
-      "（", "）", "《", "》", "【", "】", "「", "」", "『", "』",
-      "\xEF\xBC\x8C", "\xEF\xBC\x8E", "\xEF\xBC\x81", "\xEF\xBC\x9F",  // 全角 ，．！？
-      "\xEF\xBC\x9B", "\xEF\xBC\x9A", "\xEF\xBC\x88", "\xEF\xBC\x89",  // 全角 ；： （）
-      "\xEF\xBD\x9E",  // 全角 ～
-      "\xC2\xAB", "\xC2\xBB",   // « »
-      "\xE2\x80\xB9", "\xE2\x80\xBA",  // ‹ ›
-      "\xE2\x80\x9A", "\xE2\x80\x9E", "\xE2\x80\x9C", "\xE2\x80\x9D",  // ‚ „ " "
-      "\xE2\x80\x98", "\xE2\x80\x99",  // ' '
-      "\xC2\xB4", "\xE2\x80\x90", "\xE2\x80\x91",  // ´ ‐ ‑
-      "\xC2\xA1", "\xC2\xBF", "\xC2\xB7",  // ¡ ¿ ·
-      "\xE2\x80\x93", "\xE2\x80\x94",  // – —
-      "\xE2\x80\xA6",  // …
+// 并行解析：单个分片小于该值时不再细分（线程启动与归并开销大于收益）
+constexpr size_t kMinShardBytes = 1 << 20;
+constexpr unsigned kMaxParseThreads = 8;
+
+inline bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' ||
+         c == '\v';
+}
+
+std::string_view TrimView(std::string_view s) {
+  size_t b = 0;
+  size_t e = s.size();
+  while (b < e && IsSpace(s[b])) ++b;
+  while (e > b && IsSpace(s[e - 1])) --e;
+  return s.substr(b, e - b);
+}
+
+// 文本词典的一个分片（若干整行）。解析规则与 ParseLexiconLine 相同，
+// 但键与音素符号直接引用文件字节，只有需要规范化的键（短语、墓碑、含大写等）另存一份。
+class TextShard {
+ public:
+  struct Entry {
+    std::string_view key;
+    uint32_t phone_begin;
+    uint32_t phone_end;
   };
-  return kPunct.count(ch) != 0;
-}
-
-// 判断整段是否为单个标点（用于 TextToTokenIds 中跳过标点，不向模型输出）
-static bool IsPunctuationSegment(const std::string& w) {
-  if (w.empty()) return true;
-  if (w.size() == 1)
-    return IsAsciiPunct(static_cast<unsigned char>(w[0]));
-  if (Utf8CharLen(w, 0) == w.size())
-    return IsUnicodePunct(w);
-  return false;
-}
-
-// 按空白和标点切分（保留标点为单独 token），避免 "word," 导致 lexicon miss。
-std::vector<std::string> SplitWords(const std::string& text) {
-  std::vector<std::string> words;
-  std::string cur;
-  for (size_t i = 0; i < text.size();) {
-    size_t clen = Utf8CharLen(text, i);
-    if (clen == 0) break;
-    std::string ch = text.substr(i, clen);
-    if (clen == 1) {
-      unsigned char c = static_cast<unsigned char>(text[i]);
-      if (std::isspace(c)) {
-        if (!cur.empty()) {
-          words.push_back(std::move(cur));
-          cur.clear();
-        }
-      } else if (IsAsciiPunct(c)) {
-        if (!cur.empty()) {
-          words.push_back(std::move(cur));
-          cur.clear();
-        }
-        words.push_back(std::move(ch));
-      } else {
-        cur += ch;
+
+  explicit TextShard(std::string_view text) : text_(text) {}
+
+  // 解析全部行，结束时按键排序并去重（同键保留分片内最后一行）
+  void Parse() {
+    size_t pos = 0;
+    while (pos < text_.size()) {
+      size_t nl = text_.find('\n', pos);
+      if (nl == std::string_view::npos) nl = text_.size();
+      ParseLine(TrimView(text_.substr(pos, nl - pos)));
+      ++num_lines_;
+      pos = nl + 1;
+    }
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const Entry& a, const Entry& b) { return a.key < b.key; });
+    size_t out = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      if (i + 1 < entries_.size() && entries_[i + 1].key == entries_[i].key) {
+        continue;
       }
+      entries_[out++] = entries_[i];
+    }
+    entries_.resize(out);
+  }
+
+  const std::vector<Entry>& entries() const { return entries_; }
+  const std::vector<uint32_t>& phones() const { return phones_; }
+  const std::vector<std::string_view>& symbols() const { return symbols_; }
+  size_t num_lines() const { return num_lines_; }
+
+ private:
+  void ParseLine(std::string_view line) {
+    if (line.empty()) return;
+    const uint32_t begin = static_cast<uint32_t>(phones_.size());
+    std::string_view key;
+    if (line[0] == '!') {
+      key = OwnKey(NormalizeKey(line.substr(1)));
     } else {
-      if (IsUnicodePunct(ch)) {
-        if (!cur.empty()) {
-          words.push_back(std::move(cur));
-          cur.clear();
-        }
-        words.push_back(std::move(ch));
+      size_t tab = line.find('\t');
+      if (tab != std::string_view::npos) {
+        key = OwnKey(NormalizeKey(line.substr(0, tab)));
+        if (key.empty()) return;
+        AddPhones(line.substr(tab + 1));
       } else {
-        cur += ch;
+        size_t end = 0;
+        while (end < line.size() && !IsSpace(line[end])) ++end;
+        key = FoldKey(line.substr(0, end));
+        AddPhones(line.substr(end));
       }
+      if (phones_.size() == begin) return;
     }
-    i += clen;
+    if (key.empty()) return;
+    entries_.push_back({key, begin, static_cast<uint32_t>(phones_.size())});
+  }
+
+  void AddPhones(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size()) {
+      while (i < s.size() && IsSpace(s[i])) ++i;
+      size_t j = i;
+      while (j < s.size() && !IsSpace(s[j])) ++j;
+      if (j > i) phones_.push_back(Intern(s.substr(i, j - i)));
+      i = j;
+    }
+  }
+
+  uint32_t Intern(std::string_view sym) {
+    auto it = symbol_ids_.find(sym);
+    if (it != symbol_ids_.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(symbols_.size());
+    symbols_.push_back(sym);
+    symbol_ids_.emplace(sym, id);
+    return id;
+  }
+
+  // 键已是折叠形式（常见情况）时直接引用文件字节，否则另存折叠结果
+  std::string_view FoldKey(std::string_view key) {
+    if (IsFoldedFast(key)) return key;
+    std::string folded;
+    AppendFoldedText(key, &folded);
+    return folded == key ? key : OwnKey(std::move(folded));
+  }
+
+  // deque 追加不移动已有元素，返回的视图在分片生命周期内有效
+  std::string_view OwnKey(std::string key) {
+    owned_keys_.push_back(std::move(key));
+    return owned_keys_.back();
+  }
+
+  std::string_view text_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> phones_;  // 分片内符号下标
+  std::vector<std::string_view> symbols_;
+  std::unordered_map<std::string_view, uint32_t> symbol_ids_;
+  std::deque<std::string> owned_keys_;
+  size_t num_lines_ = 0;
+};
+
+// 按行边界切成至多 num_shards 段
+std::vector<std::string_view> SplitShards(std::string_view text,
+                                          size_t num_shards) {
+  std::vector<std::string_view> shards;
+  size_t begin = 0;
+  for (size_t i = 1; i <= num_shards && begin < text.size(); ++i) {
+    size_t end = text.size();
+    if (i < num_shards) {
+      size_t nl = text.find('\n', std::max(begin, text.size() * i / num_shards));
+      end = nl == std::string_view::npos ? text.size() : nl + 1;
+    }
+    shards.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
+  return shards;
+}
+
+// 归并各分片（各自已按键排序去重）：同键以靠后的分片为准，即文件中最后出现的行。
+// 同时把分片内符号下标映射到全局驻留表。
+void MergeShards(const std::vector<TextShard>& shards, LexiconTables* t) {
+  const size_t n = shards.size();
+  std::unordered_map<std::string_view, uint32_t> global_ids;
+  std::vector<std::vector<uint32_t>> remap(n);
+  t->symbol_offsets.assign(1, 0);
+  t->symbol_blob.clear();
+  size_t total_entries = 0;
+  size_t total_phones = 0;
+  for (size_t s = 0; s < n; ++s) {
+    for (std::string_view sym : shards[s].symbols()) {
+      auto it = global_ids.find(sym);
+      if (it == global_ids.end()) {
+        uint32_t id = static_cast<uint32_t>(t->symbol_offsets.size() - 1);
+        it = global_ids.emplace(sym, id).first;
+        t->symbol_blob.append(sym.data(), sym.size());
+        t->symbol_offsets.push_back(static_cast<uint32_t>(t->symbol_blob.size()));
+      }
+      remap[s].push_back(it->second);
+    }
+    total_entries += shards[s].entries().size();
+    total_phones += shards[s].phones().size();
+  }
+
+  t->key_offsets.assign(1, 0);
+  t->phone_offsets.assign(1, 0);
+  t->key_blob.clear();
+  t->phones.clear();
+  t->key_offsets.reserve(total_entries + 1);
+  t->phone_offsets.reserve(total_entries + 1);
+  t->phones.reserve(total_phones);
+  std::vector<size_t> heads(n, 0);
+  for (;;) {
+    // 分片数很少（<= kMaxParseThreads），线性找最小键即可
+    size_t winner = n;
+    std::string_view key;
+    for (size_t s = 0; s < n; ++s) {
+      if (heads[s] == shards[s].entries().size()) continue;
+      std::string_view k = shards[s].entries()[heads[s]].key;
+      if (winner == n || k <= key) {
+        if (winner != n && k == key) ++heads[winner];  // 被靠后的分片覆盖
+        winner = s;
+        key = k;
+      }
+    }
+    if (winner == n) break;
+    const TextShard& shard = shards[winner];
+    const TextShard::Entry& e = shard.entries()[heads[winner]++];
+    t->key_blob.append(key.data(), key.size());
+    t->key_offsets.push_back(static_cast<uint32_t>(t->key_blob.size()));
+    for (uint32_t k = e.phone_begin; k < e.phone_end; ++k) {
+      t->phones.push_back(remap[winner][shard.phones()[k]]);
+    }
+    t->phone_offsets.push_back(static_cast<uint32_t>(t->phones.size()));
   }
-  if (!cur.empty()) words.push_back(std::move(cur));
-  return words;
 }
 
 }  // namespace
 
-bool Lexicon::LoadFromFile(const std::string& path) {
-  std::ifstream is(path);
-  if (!is) return false;
-  word_to_phonemes_.clear();
-  std::string line;
-  while (std::getline(is, line)) {
-    Trim(&line);
-    if (line.empty()) continue;
-    std::vector<std::string> parts = SplitLine(line);
-    if (parts.size() < 2) continue;
-    std::string word = std::move(parts[0]);
-    parts.erase(parts.begin());
-    word_to_phonemes_[word] = std::move(parts);
+bool ParseLexiconLine(const std::string& raw, LexiconEntry* entry) {
+  std::string line = raw;
+  Trim(&line);
+  entry->phonemes.clear();
+  if (line.empty()) return false;
+  if (line[0] == '!') {
+    // 墓碑："!" 之后整段为词条，可为多词短语
+    entry->word = NormalizeKey(std::string_view(line).substr(1));
+    return !entry->word.empty();
+  }
+  size_t tab = line.find('\t');
+  if (tab != std::string::npos) {
+    // "多词 短语<Tab>音素..."：Tab 前整段为词条
+    entry->word = NormalizeKey(std::string_view(line).substr(0, tab));
+    entry->phonemes = SplitLine(line.substr(tab + 1));
+    return !entry->word.empty() && !entry->phonemes.empty();
   }
+  std::vector<std::string> parts = SplitLine(line);
+  if (parts.size() < 2) return false;
+  entry->word = NormalizeKey(parts[0]);
+  entry->phonemes.assign(std::make_move_iterator(parts.begin() + 1),
+                         std::make_move_iterator(parts.end()));
   return true;
 }
 
+Lexicon::Lexicon() = default;
+
+Lexicon::~Lexicon() = default;
+
+void Lexicon::Clear() {
+  owned_.reset();
+  mapped_.reset();
+  num_entries_ = 0;
+  num_symbols_ = 0;
+  key_offsets_ = nullptr;
+  key_blob_ = nullptr;
+  phone_offsets_ = nullptr;
+  phones_ = nullptr;
+  symbol_offsets_ = nullptr;
+  symbol_blob_ = nullptr;
+  key_blob_size_ = 0;
+  num_nodes_ = 0;
+  trie_nodes_ = nullptr;
+  trie_first_bytes_ = nullptr;
+  id_offsets_.clear();
+  id_pool_.clear();
+  unknown_symbols_.clear();
+  num_entries_with_unknown_ = 0;
+}
+
+bool Lexicon::LoadFromFile(const std::string& path,
+                           const TokenTable* token_table,
+                           const LexiconLoadOptions& options) {
+  const auto start = std::chrono::steady_clock::now();
+  load_stats_ = {};
+  auto file = std::make_unique<MappedFile>();
+  bool ok = false;
+  if (!file->Open(path)) {
+    // 空文件无法映射，按空词典处理；不存在或不可读则失败
+    if (!std::ifstream(path)) return false;
+    ok = LoadText({}, 1);
+  } else if (file->Size() >= sizeof(kBinaryMagic) &&
+             std::memcmp(file->Data(), kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+    ok = LoadBinary(std::move(file));
+  } else {
+    // 文本也经 mmap 读取，解析结束后即释放映射
+    ok = LoadText(std::string_view(file->Data(), file->Size()),
+                  options.num_threads);
+  }
+  if (ok && token_table) ResolveTokenIds(*token_table);
+  load_stats_.seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+  return ok;
+}
+
+// 每个符号只查一次 TokenTable，再线性扫描音素池生成 id 池。
+void Lexicon::ResolveTokenIds(const TokenTable& token_table) {
+  std::vector<int64_t> symbol_to_id(num_symbols_, -1);
+  // 对应多个 id 的符号（Piper phoneme_id_map）：symbol_to_id 记为 -2，id 见 symbol_id_lists
+  std::unordered_map<uint32_t, std::vector<int64_t>> symbol_id_lists;
+  std::vector<int64_t> ids;
+  for (uint32_t s = 0; s < num_symbols_; ++s) {
+    const std::string_view sym = SymbolAt(s);
+    ids.clear();
+    if (!token_table.AppendIds(sym, &ids)) {
+      unknown_symbols_.emplace_back(sym);
+    } else if (ids.size() == 1) {
+      symbol_to_id[s] = ids[0];
+    } else {
+      symbol_to_id[s] = -2;
+      symbol_id_lists[s] = ids;
+    }
+  }
+
+  id_offsets_.assign(1, 0);
+  id_offsets_.reserve(static_cast<size_t>(num_entries_) + 1);
+  id_pool_.clear();
+  if (num_entries_ > 0) id_pool_.reserve(phone_offsets_[num_entries_]);
+  for (uint32_t i = 0; i < num_entries_; ++i) {
+    uint32_t begin = phone_offsets_[i];
+    uint32_t end = phone_offsets_[i + 1];
+    if (end < begin || end > phone_offsets_[num_entries_]) end = begin;
+    bool has_unknown = false;
+    for (uint32_t k = begin; k < end; ++k) {
+      uint32_t sym = phones_[k];
+      int64_t id = sym < num_symbols_ ? symbol_to_id[sym] : -1;
+      if (id == -2) {
+        const std::vector<int64_t>& list = symbol_id_lists[sym];
+        id_pool_.insert(id_pool_.end(), list.begin(), list.end());
+        continue;
+      }
+      if (id < 0) {
+        has_unknown = true;
+        continue;
+      }
+      id_pool_.push_back(id);
+    }
+    if (has_unknown) ++num_entries_with_unknown_;
+    id_offsets_.push_back(static_cast<uint32_t>(id_pool_.size()));
+  }
+}
+
+bool Lexicon::LoadText(std::string_view text, int num_threads) {
+  size_t threads = num_threads > 0 ? static_cast<size_t>(num_threads)
+                                   : std::max(1u, std::min(
+                                         std::thread::hardware_concurrency(),
+                                         kMaxParseThreads));
+  threads = std::max<size_t>(1, std::min(threads, text.size() / kMinShardBytes));
+
+  std::vector<TextShard> shards;
+  for (std::string_view part : SplitShards(text, threads)) {
+    shards.emplace_back(part);
+  }
+  if (shards.size() == 1) {
+    shards[0].Parse();
+  } else if (shards.size() > 1) {
+    std::vector<std::thread> workers;
+    workers.reserve(shards.size() - 1);
+    for (size_t i = 1; i < shards.size(); ++i) {
+      workers.emplace_back([&shards, i] { shards[i].Parse(); });
+    }
+    shards[0].Parse();
+    for (auto& w : workers) w.join();
+  }
+
+  auto tables = std::make_unique<LexiconTables>();
+  MergeShards(shards, tables.get());
+  BuildTrie(tables.get());
+  LoadBuilt(std::move(tables));
+  for (const auto& shard : shards) load_stats_.num_lines += shard.num_lines();
+  load_stats_.num_threads = static_cast<int>(std::max<size_t>(1, shards.size()));
+  return true;
+}
+
+bool Lexicon::LoadFromEntries(const std::vector<LexiconEntry>& entries,
+                              const TokenTable* token_table) {
+  LexiconBuilder builder;
+  for (const auto& e : entries) {
+    std::string word = NormalizeKey(e.word);
+    if (word.empty()) continue;
+    builder.Add(std::move(word), e.phonemes);
+  }
+  auto tables = std::make_unique<LexiconTables>();
+  builder.Build(tables.get());
+  LoadBuilt(std::move(tables));
+  if (token_table) ResolveTokenIds(*token_table);
+  return true;
+}
+
+void Lexicon::LoadBuilt(std::unique_ptr<LexiconTables> tables) {
+  Clear();
+  owned_ = std::move(tables);
+  BindTables(*owned_);
+}
+
+void Lexicon::BindTables(const LexiconTables& t) {
+  num_entries_ = static_cast<uint32_t>(t.key_offsets.size() - 1);
+  num_symbols_ = static_cast<uint32_t>(t.symbol_offsets.size() - 1);
+  key_offsets_ = t.key_offsets.data();
+  key_blob_ = t.key_blob.data();
+  phone_offsets_ = t.phone_offsets.data();
+  phones_ = t.phones.data();
+  symbol_offsets_ = t.symbol_offsets.data();
+  symbol_blob_ = t.symbol_blob.data();
+  key_blob_size_ = t.key_blob.size();
+  num_nodes_ = static_cast<uint32_t>(t.trie_first_bytes.size());
+  trie_nodes_ = t.trie_nodes.data();
+  trie_first_bytes_ = t.trie_first_bytes.data();
+}
+
+// 只校验文件头与各段边界（O(1)），不逐条扫描；逐条访问时再做越界保护。
+bool Lexicon::LoadBinary(std::unique_ptr<MappedFile> file) {
+  const size_t size = file->Size();
+  if (size < sizeof(BinaryHeader)) return false;
+  BinaryHeader h;
+  std::memcpy(&h, file->Data(), sizeof(h));
+  if (h.version != kBinaryVersion) return false;
+  const uint64_t n = h.num_entries;
+  const uint64_t m = h.num_symbols;
+  const uint64_t nodes = h.num_nodes;
+  if (nodes == 0 || !U32SectionFits(h.key_offsets, n + 1, size) ||
+      !U32SectionFits(h.phone_offsets, n + 1, size) ||
+      !U32SectionFits(h.symbol_offsets, m + 1, size) ||
+      !U32SectionFits(h.trie_nodes, (nodes + 1) * 4, size) ||
+      !SectionFits(h.trie_first_bytes, nodes, size) ||
+      !SectionFits(h.key_blob, h.key_blob_size, size) ||
+      !SectionFits(h.symbol_blob, h.symbol_blob_size, size)) {
+    return false;
+  }
+  const char* base = file->Data();
+  auto u32_at = [base](uint64_t off) {
+    return reinterpret_cast<const uint32_t*>(base + off);
+  };
+  const uint32_t* key_offsets = u32_at(h.key_offsets);
+  const uint32_t* phone_offsets = u32_at(h.phone_offsets);
+  const uint32_t* symbol_offsets = u32_at(h.symbol_offsets);
+  if (key_offsets[n] > h.key_blob_size ||
+      symbol_offsets[m] > h.symbol_blob_size ||
+      !U32SectionFits(h.phones, phone_offsets[n], size)) {
+    return false;
+  }
+
+  Clear();
+  mapped_ = std::move(file);
+  num_entries_ = static_cast<uint32_t>(n);
+  num_symbols_ = static_cast<uint32_t>(m);
+  key_offsets_ = key_offsets;
+  key_blob_ = base + h.key_blob;
+  phone_offsets_ = phone_offsets;
+  phones_ = u32_at(h.phones);
+  symbol_offsets_ = symbol_offsets;
+  symbol_blob_ = base + h.symbol_blob;
+  key_blob_size_ = key_offsets[n];
+  num_nodes_ = static_cast<uint32_t>(nodes);
+  trie_nodes_ = reinterpret_cast<const LexiconTrieNode*>(base + h.trie_nodes);
+  trie_first_bytes_ = reinterpret_cast<const uint8_t*>(base + h.trie_first_bytes);
+  return true;
+}
+
+bool Lexicon::SaveBinary(const std::string& path) const {
+  if (!key_offsets_) return false;
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  if (!os) return false;
+
+  BinaryHeader h = {};
+  std::memcpy(h.magic, kBinaryMagic, sizeof(h.magic));
+  h.version = kBinaryVersion;
+  h.num_entries = num_entries_;
+  h.num_symbols = num_symbols_;
+  // 先占位写头，各段写完后回填偏移
+  WriteSection(os, &h, sizeof(h));
+  const size_t n = num_entries_ + 1;
+  const size_t m = num_symbols_ + 1;
+  h.key_blob_size = key_offsets_[num_entries_];
+  h.symbol_blob_size = symbol_offsets_[num_symbols_];
+  h.key_offsets = WriteSection(os, key_offsets_, n * sizeof(uint32_t));
+  h.key_blob = WriteSection(os, key_blob_, h.key_blob_size);
+  h.phone_offsets = WriteSection(os, phone_offsets_, n * sizeof(uint32_t));
+  h.phones = WriteSection(os, phones_,
+                          phone_offsets_[num_entries_] * sizeof(uint32_t));
+  h.symbol_offsets = WriteSection(os, symbol_offsets_, m * sizeof(uint32_t));
+  h.symbol_blob = WriteSection(os, symbol_blob_, h.symbol_blob_size);
+  h.num_nodes = num_nodes_;
+  h.trie_nodes = WriteSection(os, trie_nodes_,
+                              (num_nodes_ + 1) * sizeof(LexiconTrieNode));
+  h.trie_first_bytes = WriteSection(os, trie_first_bytes_, num_nodes_);
+  os.seekp(0);
+  os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  return os.good();
+}
+
+std::string_view Lexicon::LabelAt(uint32_t node) const {
+  const LexiconTrieNode& t = trie_nodes_[node];
+  if (t.label_offset > key_blob_size_ ||
+      t.label_length > key_blob_size_ - t.label_offset) {
+    return {};
+  }
+  return std::string_view(key_blob_ + t.label_offset, t.label_length);
+}
+
+std::string_view Lexicon::SymbolAt(uint32_t i) const {
+  if (i >= num_symbols_) return {};
+  uint32_t begin = symbol_offsets_[i];
+  uint32_t end = symbol_offsets_[i + 1];
+  if (end < begin || end > symbol_offsets_[num_symbols_]) return {};
+  return std::string_view(symbol_blob_ + begin, end - begin);
+}
+
+uint32_t Lexicon::FindChild(uint32_t node, unsigned char c) const {
+  uint32_t lo = trie_nodes_[node].children;
+  uint32_t hi = std::min(trie_nodes_[node + 1].children, num_nodes_);
+  // 子节点通常很少，且首字节连续存放：线性扫描即可
+  for (uint32_t v = lo; v < hi; ++v) {
+    uint8_t first = trie_first_bytes_[v];
+    if (first == c) return v;
+    if (first > c) break;
+  }
+  return 0;
+}
+
+int64_t Lexicon::Find(std::string_view word) const {
+  if (num_nodes_ == 0 || word.empty()) return -1;
+  // 键在加载时已折叠，查询前同样折叠；常见的短词在栈上完成，不分配
+  char stack[128];
+  std::string heap;
+  if (IsFoldedFast(word)) {
+    // 已是折叠形式，直接查
+  } else if (word.size() <= sizeof(stack) && FoldTextFast(word, stack)) {
+    word = std::string_view(stack, word.size());
+  } else {
+    word = FoldText(word, &heap);
+  }
+  uint32_t node = 0;
+  size_t pos = 0;
+  while (pos < word.size()) {
+    node = FindChild(node, static_cast<unsigned char>(word[pos]));
+    if (node == 0) return -1;
+    std::string_view label = LabelAt(node);
+    if (word.compare(pos, label.size(), label) != 0) return -1;
+    pos += label.size();
+  }
+  uint32_t entry = trie_nodes_[node].entry;
+  return entry < num_entries_ ? static_cast<int64_t>(entry) : -1;
+}
+
+size_t Lexicon::PrefixMatches(std::string_view text, LexiconMatch* matches,
+                              size_t max_matches) const {
+  if (num_nodes_ == 0 || max_matches == 0) return 0;
+  size_t count = 0;
+  uint32_t node = 0;
+  size_t pos = 0;
+  // 取下一个规范化字节：连续空白读作一个空格
+  auto next_byte = [&text, &pos](unsigned char* c) {
+    if (pos >= text.size()) return false;
+    unsigned char ch = static_cast<unsigned char>(text[pos]);
+    if (!std::isspace(ch)) {
+      *c = ch;
+      ++pos;
+      return true;
+    }
+    while (pos < text.size() &&
+           std::isspace(static_cast<unsigned char>(text[pos]))) {
+      ++pos;
+    }
+    *c = ' ';
+    return true;
+  };
+  unsigned char c = 0;
+  while (next_byte(&c)) {
+    node = FindChild(node, c);
+    if (node == 0) break;
+    std::string_view label = LabelAt(node);
+    bool ok = true;
+    for (size_t k = 1; k < label.size() && ok; ++k) {
+      ok = next_byte(&c) && c == static_cast<unsigned char>(label[k]);
+    }
+    if (!ok) break;
+    uint32_t entry = trie_nodes_[node].entry;
+    if (entry >= num_entries_) continue;
+    if (count == max_matches) {
+      // 已满：丢弃最短的命中，保留更长的
+      std::memmove(matches, matches + 1, (max_matches - 1) * sizeof(*matches));
+      --count;
+    }
+    matches[count].length = pos;
+    matches[count].entry = entry;
+    ++count;
+  }
+  return count;
+}
+
 bool Lexicon::Contains(const std::string& word) const {
-  return word_to_phonemes_.count(word) != 0;
+  int64_t i = Find(word);
+  return i >= 0 && !IsTombstone(static_cast<uint32_t>(i));
+}
+
+bool Lexicon::Lookup(std::string_view word, TokenIdSpan* ids) const {
+  if (!IsBound()) return false;
+  int64_t i = Find(word);
+  if (i < 0 || IsTombstone(static_cast<uint32_t>(i))) return false;
+  *ids = EntryIds(static_cast<uint32_t>(i));
+  return true;
+}
+
+TokenIdSpan Lexicon::EntryIds(uint32_t entry) const {
+  TokenIdSpan ids;
+  if (!IsBound() || entry >= num_entries_) return ids;
+  ids.data = id_pool_.data() + id_offsets_[entry];
+  ids.size = id_offsets_[entry + 1] - id_offsets_[entry];
+  return ids;
+}
+
+bool Lexicon::IsTombstone(uint32_t entry) const {
+  return entry < num_entries_ &&
+         phone_offsets_[entry] == phone_offsets_[entry + 1];
 }
 
 std::vector<std::string> Lexicon::GetPhonemes(const std::string& word) const {
-  auto it = word_to_phonemes_.find(word);
-  if (it == word_to_phonemes_.end()) return {};
-  return it->second;
+  int64_t i = Find(word);
+  if (i < 0) return {};
+  uint32_t begin = phone_offsets_[i];
+  uint32_t end = phone_offsets_[i + 1];
+  if (end < begin || end > phone_offsets_[num_entries_]) return {};
+  std::vector<std::string> out;
+  out.reserve(end - begin);
+  for (uint32_t k = begin; k < end; ++k) {
+    std::string_view sym = SymbolAt(phones_[k]);
+    if (!sym.empty()) out.emplace_back(sym);
+  }
+  return out;
 }
 
 // 按空格切分，每段作为单个 symbol 查表（用于 "ni hao" 等音素/拼音串）
@@ -146,40 +830,178 @@ static std::vector<int64_t> TextToTokenIdsBySpaces(const std::string& text,
   std::istringstream iss(text);
   std::string tok;
   while (iss >> tok) {
-    if (token_table->Contains(tok)) {
-      ids.push_back(token_table->GetId(tok));
-    }
+    const int64_t id = token_table->TryGetId(tok);
+    if (id >= 0) ids.push_back(id);
   }
   return ids;
 }
 
+namespace {
+
+// 多层词典的最长匹配。命中须止于某个切分片段的末尾，
+// 因而可跨越多个词（"New York"）但不会截断词（"new" 不会命中 "newer"）。
+// 工作区在每次 TextToTokenIds 中分配一次，逐词复用。
+class LayeredMatcher {
+ public:
+  static constexpr size_t kMaxMatches = 8;
+
+  explicit LayeredMatcher(const std::vector<const Lexicon*>& layers)
+      : layers_(layers),
+        matches_(layers.size() * kMaxMatches),
+        counts_(layers.size()) {}
+
+  // 从 words[index] 起匹配，命中时返回覆盖的最后一个片段下标，否则返回 -1。
+  int64_t Match(std::string_view text,
+                const std::vector<std::string_view>& words, size_t index,
+                TokenIdSpan* ids) {
+    const size_t num_layers = layers_.size();
+    const size_t begin = words[index].data() - text.data();
+    for (size_t l = 0; l < num_layers; ++l) {
+      counts_[l] = layers_[l]->PrefixMatches(
+          text.substr(begin), &matches_[l * kMaxMatches], kMaxMatches);
+    }
+    for (;;) {
+      // 各层命中均按长度递增，从末尾取当前最长；同长度以最上层为准
+      size_t top = num_layers;
+      size_t length = 0;
+      for (size_t l = 0; l < num_layers; ++l) {
+        if (counts_[l] == 0) continue;
+        size_t len = Last(l).length;
+        if (top == num_layers || len > length) {
+          top = l;
+          length = len;
+        }
+      }
+      if (top == num_layers) return -1;
+      const uint32_t entry = Last(top).entry;
+      for (size_t l = 0; l < num_layers; ++l) {
+        if (counts_[l] > 0 && Last(l).length == length) --counts_[l];
+      }
+      if (layers_[top]->IsTombstone(entry)) continue;
+
+      const size_t end = begin + length;
+      for (size_t k = index; k < words.size(); ++k) {
+        size_t word_end = words[k].data() - text.data() + words[k].size();
+        if (word_end == end) {
+          *ids = layers_[top]->EntryIds(entry);
+          return static_cast<int64_t>(k);
+        }
+        if (word_end > end) break;
+      }
+    }
+  }
+
+ private:
+  const LexiconMatch& Last(size_t layer) const {
+    return matches_[layer * kMaxMatches + counts_[layer] - 1];
+  }
+
+  const std::vector<const Lexicon*>& layers_;
+  std::vector<LexiconMatch> matches_;
+  std::vector<size_t> counts_;
+};
+
+// 逐片段折叠（见 text_fold.h）拼成词典查询用的文本，片段间原有空白处补一个空格，
+// 以便匹配多词短语；folded_words[i] 与 words[i] 一一对应，指向 *folded。
+void FoldSegments(std::string_view text,
+                  const std::vector<std::string_view>& words,
+                  std::string* folded,
+                  std::vector<std::string_view>* folded_words) {
+  std::vector<std::pair<size_t, size_t>> spans;
+  spans.reserve(words.size());
+  folded->clear();
+  folded->reserve(text.size());
+  size_t prev_end = 0;
+  for (std::string_view w : words) {
+    const size_t begin = w.data() - text.data();
+    if (begin > prev_end && !folded->empty()) folded->push_back(' ');
+    const size_t folded_begin = folded->size();
+    AppendFoldedText(w, folded);
+    spans.emplace_back(folded_begin, folded->size() - folded_begin);
+    prev_end = begin + w.size();
+  }
+  folded_words->clear();
+  folded_words->reserve(spans.size());
+  for (const auto& span : spans) {
+    folded_words->push_back(
+        std::string_view(*folded).substr(span.first, span.second));
+  }
+}
+
+}  // namespace
+
 std::vector<int64_t> TextToTokenIds(const std::string& text,
                                     const Lexicon* lexicon,
                                     const TokenTable* token_table) {
-  if (!token_table || token_table->Size() == 0) return {};
-  std::vector<int64_t> ids;
+  return TextToTokenIds(text, &lexicon, 1, token_table);
+}
+
+void SegmentWithLexicon(std::string_view text, const Lexicon* const* layers,
+                        size_t num_layers,
+                        std::vector<LexiconSegment>* segments) {
+  segments->clear();
+  std::vector<const Lexicon*> active;
+  for (size_t l = 0; l < num_layers; ++l) {
+    const Lexicon* lexicon = layers[l];
+    if (lexicon && lexicon->IsBound() && lexicon->Size() > 0) {
+      active.push_back(lexicon);
+    }
+  }
+  LayeredMatcher matcher(active);
 
-  std::vector<std::string> words = SplitWords(text);
-  for (const auto& w : words) {
+  std::vector<std::string_view> words;
+  SplitWords(text, &words);
+  // 词典按折叠后的片段匹配；输出的片段仍指向原文
+  std::string folded;
+  std::vector<std::string_view> folded_words;
+  if (!active.empty()) FoldSegments(text, words, &folded, &folded_words);
+  for (size_t i = 0; i < words.size(); ++i) {
+    std::string_view w = words[i];
     if (IsPunctuationSegment(w)) continue;  // 标点不参与合成，不输出 token
-    if (lexicon && lexicon->Size() > 0 && lexicon->Contains(w)) {
-      std::vector<std::string> phonemes = lexicon->GetPhonemes(w);
-      std::vector<int64_t> sub = token_table->SymbolsToIds(phonemes, false);
-      for (int64_t id : sub) ids.push_back(id);
+    LexiconSegment seg;
+    int64_t last =
+        active.empty() ? -1 : matcher.Match(folded, folded_words, i, &seg.ids);
+    if (last >= 0) {
+      std::string_view end = words[static_cast<size_t>(last)];
+      seg.text = text.substr(w.data() - text.data(),
+                             end.data() + end.size() - w.data());
+      seg.hit = true;
+      i = static_cast<size_t>(last);
     } else {
-      // 无词典或词不在词典：先试整词，再按 UTF-8 字符
-      if (token_table->Contains(w)) {
-        ids.push_back(token_table->GetId(w));
-      } else {
-        for (size_t i = 0; i < w.size(); ) {
-          size_t clen = Utf8CharLen(w, i);
-          if (clen == 0) break;
-          std::string ch = w.substr(i, clen);
-          if (token_table->Contains(ch)) {
-            ids.push_back(token_table->GetId(ch));
-          }
-          i += clen;
-        }
+      seg.text = w;
+    }
+    segments->push_back(seg);
+  }
+}
+
+std::vector<int64_t> TextToTokenIds(const std::string& text,
+                                    const Lexicon* const* layers,
+                                    size_t num_layers,
+                                    const TokenTable* token_table) {
+  if (!token_table || token_table->Size() == 0) return {};
+  std::vector<int64_t> ids;
+  std::vector<LexiconSegment> segments;
+  SegmentWithLexicon(text, layers, num_layers, &segments);
+  for (const LexiconSegment& seg : segments) {
+    if (seg.hit) {
+      ids.insert(ids.end(), seg.ids.begin(), seg.ids.end());
+      continue;
+    }
+    // 无词典或词不在词典：先试整词，再按 UTF-8 字符
+    std::string_view w = seg.text;
+    const int64_t word_id = token_table->TryGetId(w);
+    if (word_id >= 0) {
+      ids.push_back(word_id);
+    } else {
+      for (size_t k = 0; k < w.size(); ) {
+        char32_t cp;
+        size_t clen = DecodeUtf8(w, k, &cp);
+        // 非法字节（解码为 U+FFFD）按原字节查表
+        const int64_t id = cp == 0xFFFD && clen == 1
+                               ? token_table->TryGetId(w.substr(k, clen))
+                               : token_table->TryGetId(cp);
+        if (id >= 0) ids.push_back(id);
+        k += clen;
       }
     }
   }
@@ -1,41 +1,207 @@
 #ifndef SHERPA_TTS_LEXICON_H_
 #define SHERPA_TTS_LEXICON_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 #include "token_table.h"
 
 namespace sherpa_tts {
 
+class MappedFile;
+struct LexiconTables;
+
+// 前缀树节点（内部布局，也是二进制格式中的一段，16 字节，单次访存即可取全）。
+struct LexiconTrieNode {
+  uint32_t children;      // 首个子节点下标；子节点区间止于下一节点的 children
+  uint32_t label_offset;  // 入边标签在词表字节中的偏移
+  uint32_t label_length;
+  uint32_t entry;         // 以该节点结尾的词条下标，无则为全 1
+};
+
+// 前缀匹配命中：从匹配起点算起的输入字节数，及对应词条下标。
+struct LexiconMatch {
+  size_t length = 0;
+  uint32_t entry = 0;
+};
+
+// 一条词典记录；phonemes 为空表示墓碑（在叠加层中删除下层同名词条）。
+struct LexiconEntry {
+  std::string word;
+  std::vector<std::string> phonemes;
+};
+
+// 加载选项
+struct LexiconLoadOptions {
+  // 文本词典的解析线程数；0 表示按 CPU 核数自动选择（文件足够大时才会分片并行）
+  int num_threads = 0;
+};
+
+// 最近一次 LoadFromFile 的统计
+struct LexiconLoadStats {
+  size_t num_lines = 0;  // 文本格式读取的行数；二进制格式为 0
+  int num_threads = 0;   // 实际使用的解析线程数
+  double seconds = 0;    // 含解析、建树与 token id 绑定
+
+  double LinesPerSecond() const {
+    return seconds > 0 ? static_cast<double>(num_lines) / seconds : 0;
+  }
+};
+
+// 解析文本词典的一行（格式见 Lexicon），空行或无效行返回 false。
+// "!词" 或 "!多词 短语" 解析为墓碑。
+bool ParseLexiconLine(const std::string& line, LexiconEntry* entry);
+
 // 词典：词 -> 音素符号序列。配合 TokenTable 将文本转为 token id 序列。
-// 词典文件格式：每行 "词 音素1 音素2 ..."（空格分隔）。
+// 支持两种文件格式，LoadFromFile 按文件头自动识别：
+// - 文本：每行 "词 音素1 音素2 ..."（空格分隔），同一词以最后一行为准；
+//   大文件按行切成若干分片并行解析，再按词归并（后出现的分片优先，语义与逐行读取相同）；
+//   若行内含 Tab，则 Tab 之前整段为词条，可包含空格（多词短语，如 "New York\tn j u ..."）；
+//   以 '!' 开头的行为墓碑（如 "!замок"），仅在叠加层中有意义，见 lexicon_store.h；
+// - 二进制：由 lexicon-compile 生成（见 tools/），mmap 后直接使用，加载耗时与词条数无关。
+// 两种格式在内存中是同一布局：按字节序排序的词表 + 建在词表之上的压缩前缀树
+// （边标签直接引用词表字节）+ 驻留（interned）的音素符号表。
+// 词表的键在加载时统一做大小写折叠与 NFC（见 text_fold.h），查询时输入同样折叠，
+// 因此 "Привет"、"привет" 与 NFD 分解形式命中同一词条。
+// 查询沿前缀树逐字节走，一次遍历即可得到输入某处起所有命中的词条（含多词短语）。
+// 加载时传入 TokenTable 即完成绑定：每个词条的音素被一次性解析为 token id，
+// 存于一块连续的 id 池中，Lookup 直接返回该词条的 id 片段。
 class Lexicon {
  public:
-  Lexicon() = default;
+  // 二进制格式标识与版本；格式变化时递增版本号，旧文件会被拒绝加载。
+  static constexpr char kBinaryMagic[4] = {'S', 'L', 'E', 'X'};
+  static constexpr uint32_t kBinaryVersion = 3;
+
+  Lexicon();
+  ~Lexicon();
+
+  Lexicon(const Lexicon&) = delete;
+  Lexicon& operator=(const Lexicon&) = delete;
+
+  // 从文件加载（文本或二进制），失败返回 false。
+  // token_table 非空时绑定到该表（须在 Lexicon 生命周期内有效），供 Lookup 使用；
+  // 词条中不在表内的音素符号会被跳过，并记录在 UnknownSymbols() 中。
+  bool LoadFromFile(const std::string& path,
+                    const TokenTable* token_table = nullptr,
+                    const LexiconLoadOptions& options = {});
+
+  const LexiconLoadStats& LoadStats() const { return load_stats_; }
+
+  // 由内存中的词条构建（同词以最后一条为准），用于增量修改等小词典。
+  bool LoadFromEntries(const std::vector<LexiconEntry>& entries,
+                       const TokenTable* token_table = nullptr);
 
-  // 从文件加载，失败返回 false。
-  bool LoadFromFile(const std::string& path);
+  // 写出二进制格式，供 lexicon-compile 使用。失败返回 false。
+  bool SaveBinary(const std::string& path) const;
 
-  // 是否包含该词
+  // 是否包含该词（墓碑不算）
   bool Contains(const std::string& word) const;
 
   // 获取词的音素符号序列（未找到返回空）
   std::vector<std::string> GetPhonemes(const std::string& word) const;
 
-  size_t Size() const { return word_to_phonemes_.size(); }
+  // 查词并返回已解析的 token id 片段（指向内部 id 池，随 Lexicon 失效）。
+  // 未找到、是墓碑或未绑定 TokenTable 时返回 false。
+  bool Lookup(std::string_view word, TokenIdSpan* ids) const;
+
+  // 从 text 起始处沿前缀树匹配，按长度递增写出命中的词条（含墓碑），返回个数。
+  // text 须已折叠（FoldText），此处不再处理，长度即折叠后文本的字节数。
+  // 输入中连续空白视为一个空格（与词条中的空格对应）；命中超过 max_matches 时保留最长的。
+  size_t PrefixMatches(std::string_view text, LexiconMatch* matches,
+                       size_t max_matches) const;
+
+  // 词条 entry 的 token id 片段；未绑定时为空。
+  TokenIdSpan EntryIds(uint32_t entry) const;
+
+  // 词条 entry 是否为墓碑（无音素）
+  bool IsTombstone(uint32_t entry) const;
+
+  size_t Size() const { return num_entries_; }
+  size_t NumSymbols() const { return num_symbols_; }
+
+  bool IsBound() const { return !id_offsets_.empty(); }
+
+  // 绑定时在 TokenTable 中找不到的音素符号（去重），及受影响的词条数
+  const std::vector<std::string>& UnknownSymbols() const {
+    return unknown_symbols_;
+  }
+  size_t NumEntriesWithUnknown() const { return num_entries_with_unknown_; }
+
+  // 当前数据是否来自 mmap 的二进制文件
+  bool IsMapped() const { return mapped_ != nullptr; }
 
  private:
-  std::unordered_map<std::string, std::vector<std::string>> word_to_phonemes_;
+  void Clear();
+  bool LoadText(std::string_view text, int num_threads);
+  void LoadBuilt(std::unique_ptr<LexiconTables> tables);
+  bool LoadBinary(std::unique_ptr<MappedFile> file);
+  void BindTables(const LexiconTables& t);
+  void ResolveTokenIds(const TokenTable& token_table);
+  // 返回词条下标，未找到返回 -1
+  int64_t Find(std::string_view word) const;
+  // 返回 node 下首字节为 c 的子节点，无则返回 0（根节点不会作为子节点出现）
+  uint32_t FindChild(uint32_t node, unsigned char c) const;
+  std::string_view LabelAt(uint32_t node) const;
+  std::string_view SymbolAt(uint32_t i) const;
+
+  // 文本格式加载时持有数据；二进制格式时为空，数据在 mapped_ 中
+  std::unique_ptr<LexiconTables> owned_;
+  std::unique_ptr<MappedFile> mapped_;
+
+  // 指向 owned_ 或 mapped_ 中各段的只读视图
+  uint32_t num_entries_ = 0;
+  uint32_t num_symbols_ = 0;
+  const uint32_t* key_offsets_ = nullptr;     // num_entries_ + 1
+  const char* key_blob_ = nullptr;
+  const uint32_t* phone_offsets_ = nullptr;   // num_entries_ + 1
+  const uint32_t* phones_ = nullptr;          // 音素符号下标
+  const uint32_t* symbol_offsets_ = nullptr;  // num_symbols_ + 1
+  const char* symbol_blob_ = nullptr;
+  size_t key_blob_size_ = 0;
+  // 前缀树（BFS 序，兄弟节点连续且按标签首字节升序；节点 0 为根，末尾另有一个哨兵节点）。
+  // trie_first_bytes_ 单独存放各节点标签首字节，找子节点时只需扫一小段连续字节。
+  uint32_t num_nodes_ = 0;
+  const LexiconTrieNode* trie_nodes_ = nullptr;  // num_nodes_ + 1
+  const uint8_t* trie_first_bytes_ = nullptr;    // num_nodes_
+
+  // 绑定 TokenTable 后的 id 池：词条 i 的 id 为 id_pool_[id_offsets_[i], id_offsets_[i+1])
+  std::vector<uint32_t> id_offsets_;
+  std::vector<int64_t> id_pool_;
+  std::vector<std::string> unknown_symbols_;
+  size_t num_entries_with_unknown_ = 0;
+
+  LexiconLoadStats load_stats_;
+};
+
+// 切词并查词典后的一个片段（按原文顺序；标点片段不输出）。
+struct LexiconSegment {
+  std::string_view text;  // 原文片段；命中多词短语时为首词到末词的整段
+  TokenIdSpan ids;        // 命中时为词条的 token id 片段
+  bool hit = false;
 };
 
-// 将文本按空格/标点切词，查词典得到音素序列，再通过 TokenTable 转为 id 序列。
+// 切词并按多层词典做最长匹配（规则同多层 TextToTokenIds），未命中的词原样记为片段，
+// 不做 TokenTable 回退，交由调用方处理（如批量送 espeak）。片段指向 text。
+void SegmentWithLexicon(std::string_view text, const Lexicon* const* layers,
+                        size_t num_layers,
+                        std::vector<LexiconSegment>* segments);
+
+// 将文本按空格/标点切词，查词典得到 token id 序列（lexicon 须已绑定到 token_table）。
 // 若词典为空则按字符尝试（TokenTable 中有单字符则用单字符 id）。
 std::vector<int64_t> TextToTokenIds(const std::string& text,
                                     const Lexicon* lexicon,
                                     const TokenTable* token_table);
 
+// 多层词典版本：layers[0] 优先级最高。同一匹配长度取最上层的词条，
+// 若该词条是墓碑则此长度视为未命中（下层同名词条被屏蔽）。
+std::vector<int64_t> TextToTokenIds(const std::string& text,
+                                    const Lexicon* const* layers,
+                                    size_t num_layers,
+                                    const TokenTable* token_table);
+
 }  // namespace sherpa_tts
 
 #endif  // SHERPA_TTS_LEXICON_H_
@@ -0,0 +1,166 @@
+#include "lexicon_store.h"
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <iterator>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "token_table.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+struct SharedLexiconKey {
+  uint64_t dev;
+  uint64_t ino;
+  int64_t mtime_ns;
+  int64_t size;
+  uint64_t token_fingerprint;
+
+  bool operator<(const SharedLexiconKey& o) const {
+    return std::tie(dev, ino, mtime_ns, size, token_fingerprint) <
+           std::tie(o.dev, o.ino, o.mtime_ns, o.size, o.token_fingerprint);
+  }
+};
+
+std::mutex g_shared_mutex;
+std::map<SharedLexiconKey, std::weak_ptr<const Lexicon>> g_shared_lexicons;
+
+}  // namespace
+
+std::shared_ptr<const Lexicon> AcquireSharedLexicon(
+    const std::string& path, const TokenTable* token_table) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) return nullptr;
+  const SharedLexiconKey key{
+      static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino),
+      static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec,
+      static_cast<int64_t>(st.st_size),
+      token_table ? token_table->Fingerprint() : 0};
+  {
+    std::lock_guard<std::mutex> lock(g_shared_mutex);
+    auto it = g_shared_lexicons.find(key);
+    if (it != g_shared_lexicons.end()) {
+      if (auto shared = it->second.lock()) return shared;
+    }
+  }
+
+  // 在锁外加载，不阻塞其他文件；并发加载同一文件时以先登记者为准
+  auto lexicon = std::make_shared<Lexicon>();
+  if (!lexicon->LoadFromFile(path, token_table)) return nullptr;
+  std::lock_guard<std::mutex> lock(g_shared_mutex);
+  for (auto it = g_shared_lexicons.begin(); it != g_shared_lexicons.end();) {
+    it = it->second.expired() ? g_shared_lexicons.erase(it) : std::next(it);
+  }
+  auto& slot = g_shared_lexicons[key];
+  if (auto shared = slot.lock()) return shared;
+  std::shared_ptr<const Lexicon> result = std::move(lexicon);
+  slot = result;
+  return result;
+}
+
+LexiconSnapshot::LexiconSnapshot(
+    std::vector<std::shared_ptr<const Lexicon>> layers, uint64_t version)
+    : layers_(std::move(layers)), version_(version) {
+  raw_layers_.reserve(layers_.size());
+  for (const auto& layer : layers_) raw_layers_.push_back(layer.get());
+}
+
+size_t LexiconSnapshot::NumEntries() const {
+  size_t n = 0;
+  for (const Lexicon* layer : raw_layers_) n += layer->Size();
+  return n;
+}
+
+LexiconStore::LexiconStore(const TokenTable* token_table)
+    : token_table_(token_table),
+      current_(std::make_shared<const LexiconSnapshot>(
+          std::vector<std::shared_ptr<const Lexicon>>{}, 0)) {}
+
+std::shared_ptr<const LexiconSnapshot> LexiconStore::Current() const {
+  return std::atomic_load(&current_);
+}
+
+bool LexiconStore::Reload(LexiconLayer layer, const std::string& path,
+                          std::shared_ptr<const Lexicon>* out) {
+  const uint64_t sequence = ++next_sequence_;
+  // 解析 / 映射与 token id 绑定都在锁外完成，不阻塞其他写者，更不阻塞读者
+  std::shared_ptr<const Lexicon> lexicon;
+  if (!path.empty()) {
+    if (layer == LexiconLayer::kBase) {
+      lexicon = AcquireSharedLexicon(path, token_table_);
+    } else {
+      auto user = std::make_shared<Lexicon>();
+      if (user->LoadFromFile(path, token_table_)) lexicon = std::move(user);
+    }
+    if (!lexicon) return false;
+  }
+
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  uint64_t& published = published_sequence_[static_cast<size_t>(layer)];
+  if (sequence < published) {
+    // 之后调用的重载已先完成并发布，本次结果作废
+    if (out) *out = std::move(lexicon);
+    return true;
+  }
+  published = sequence;
+  if (layer == LexiconLayer::kBase) {
+    base_ = lexicon;
+  } else {
+    user_ = lexicon;
+    // 加载期间调用的增量修改在本次重载之后，保留
+    if (delta_sequence_ < sequence) {
+      delta_.reset();
+      delta_entries_.clear();
+    }
+  }
+  PublishLocked();
+  if (out) *out = std::move(lexicon);
+  return true;
+}
+
+size_t LexiconStore::ApplyDelta(const std::string& delta_text) {
+  const uint64_t sequence = ++next_sequence_;
+  std::vector<LexiconEntry> parsed;
+  std::istringstream is(delta_text);
+  std::string line;
+  LexiconEntry entry;
+  while (std::getline(is, line)) {
+    if (ParseLexiconLine(line, &entry)) parsed.push_back(std::move(entry));
+  }
+  if (parsed.empty()) return 0;
+
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  // 调用早于已发布的用户层重载时，该重载本应清掉它
+  if (sequence < published_sequence_[static_cast<size_t>(LexiconLayer::kUser)]) {
+    return parsed.size();
+  }
+  if (sequence > delta_sequence_) delta_sequence_ = sequence;
+  for (auto& e : parsed) delta_entries_[e.word] = std::move(e.phonemes);
+  // 增量层只含累计修改的词条，重建代价与基础词典大小无关
+  std::vector<LexiconEntry> entries;
+  entries.reserve(delta_entries_.size());
+  for (const auto& kv : delta_entries_) entries.push_back({kv.first, kv.second});
+  auto delta = std::make_shared<Lexicon>();
+  delta->LoadFromEntries(entries, token_table_);
+  delta_ = std::move(delta);
+  PublishLocked();
+  return parsed.size();
+}
+
+void LexiconStore::PublishLocked() {
+  std::vector<std::shared_ptr<const Lexicon>> layers;
+  if (delta_) layers.push_back(delta_);
+  if (user_) layers.push_back(user_);
+  if (base_) layers.push_back(base_);
+  std::atomic_store(&current_,
+                    std::shared_ptr<const LexiconSnapshot>(
+                        std::make_shared<const LexiconSnapshot>(
+                            std::move(layers), ++version_)));
+}
+
+}  // namespace sherpa_tts
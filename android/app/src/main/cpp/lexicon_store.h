@@ -0,0 +1,106 @@
+#ifndef SHERPA_TTS_LEXICON_STORE_H_
+#define SHERPA_TTS_LEXICON_STORE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "lexicon.h"
+
+namespace sherpa_tts {
+
+class TokenTable;
+
+// 词典层：用户层覆盖基础层（基础层通常是随应用分发的大词典，用户层是自定义发音）。
+enum class LexiconLayer : int32_t {
+  kBase = 0,
+  kUser = 1,
+};
+
+// 进程内共享的只读词典：同一文件（按 dev/ino/mtime/size 识别）在指纹相同的 TokenTable 下
+// 只加载一次，各句柄共用同一个 Lexicon（二进制格式即同一份 mmap，不复制词表）；
+// 最后一个使用者释放后卸载。失败返回空。
+std::shared_ptr<const Lexicon> AcquireSharedLexicon(
+    const std::string& path, const TokenTable* token_table);
+
+// 词典快照：按优先级排列的只读词典层（下标 0 最高），发布后不再修改。
+// 查询见 TextToTokenIds 的多层版本：上层同名词条覆盖下层，墓碑屏蔽下层。
+class LexiconSnapshot {
+ public:
+  LexiconSnapshot(std::vector<std::shared_ptr<const Lexicon>> layers,
+                  uint64_t version);
+
+  const Lexicon* const* Layers() const { return raw_layers_.data(); }
+  size_t NumLayers() const { return raw_layers_.size(); }
+
+  // 各层词条数之和（含墓碑），用于日志
+  size_t NumEntries() const;
+
+  // 每次发布递增，可用于判断快照是否已被替换
+  uint64_t Version() const { return version_; }
+
+ private:
+  std::vector<std::shared_ptr<const Lexicon>> layers_;
+  std::vector<const Lexicon*> raw_layers_;
+  uint64_t version_;
+};
+
+// 可热替换的词典（RCU 式）：
+// - 读者用 Current() 原子地取得当前快照并持有到请求结束，全程不加锁；
+// - 写者在调用线程上构建新词典，再原子发布新快照；旧快照在最后一个读者释放后析构。
+// 快照自上而下为：增量层（ApplyDelta 累积的修改）、用户层、基础层；各层均可缺省。
+// 基础层经 AcquireSharedLexicon 在句柄间共享，用户层与增量层为本句柄私有。
+// 所有词典都绑定到构造时传入的 token_table（须在 LexiconStore 生命周期内有效且不变）。
+class LexiconStore {
+ public:
+  explicit LexiconStore(const TokenTable* token_table);
+
+  LexiconStore(const LexiconStore&) = delete;
+  LexiconStore& operator=(const LexiconStore&) = delete;
+
+  // 当前快照，永不为空（未加载时为无词条的快照）
+  std::shared_ptr<const LexiconSnapshot> Current() const;
+
+  // 从文件重新加载某一层；path 为空表示卸载该层。失败时保持原快照不变并返回 false。
+  // 重载用户层会清空在它之前调用的增量修改（增量是对用户层的修改）；重载基础层不影响上面两层。
+  // 并发重载同一层时按调用顺序生效：加载完成时该层已发布了更晚调用的结果，则丢弃本次结果
+  //（仍返回 true）。成功时 out（可为空）指向新加载的词典，便于调用方输出统计。
+  bool Reload(LexiconLayer layer, const std::string& path,
+              std::shared_ptr<const Lexicon>* out = nullptr);
+
+  // 应用增量修改：delta_text 为若干文本词典行，"!词" 表示删除（可屏蔽下层词条）。
+  // 与已有增量按词合并（后写覆盖先写），只重建增量层，不重新解析其他层。
+  // 返回有效行数；没有有效行时不发布新快照。调用早于已生效的用户层重载时修改随之作废。
+  size_t ApplyDelta(const std::string& delta_text);
+
+ private:
+  // 调用方须持有 writer_mutex_
+  void PublishLocked();
+
+  const TokenTable* token_table_;
+
+  // 写者之间串行；读者只访问 current_
+  std::mutex writer_mutex_;
+  std::shared_ptr<const Lexicon> base_;
+  std::shared_ptr<const Lexicon> user_;
+  std::shared_ptr<const Lexicon> delta_;
+  std::map<std::string, std::vector<std::string>> delta_entries_;
+  uint64_t version_ = 0;
+
+  // Reload / ApplyDelta 在入口处按调用顺序取号（加载在锁外，完成顺序可能不同）
+  std::atomic<uint64_t> next_sequence_{0};
+  uint64_t published_sequence_[2] = {0, 0};  // 各层（下标为 LexiconLayer）已发布的重载序号
+  uint64_t delta_sequence_ = 0;              // 最近一次增量修改的序号
+
+  // 只通过 std::atomic_load / std::atomic_store 访问
+  std::shared_ptr<const LexiconSnapshot> current_;
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_LEXICON_STORE_H_
@@ -0,0 +1,39 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sherpa_tts {
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string& path) {
+  Close();
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // 映射建立后即可关闭 fd，映射本身保持有效
+  ::close(fd);
+  if (p == MAP_FAILED) return false;
+  data_ = static_cast<const char*>(p);
+  size_ = size;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,33 @@
+#ifndef SHERPA_TTS_MAPPED_FILE_H_
+#define SHERPA_TTS_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace sherpa_tts {
+
+// 只读 mmap 一个文件，析构时 munmap。用于二进制词典等需要零拷贝加载的资源。
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // 映射整个文件，失败返回 false。空文件视为失败。
+  bool Open(const std::string& path);
+  void Close();
+
+  const char* Data() const { return data_; }
+  size_t Size() const { return size_; }
+  bool IsOpen() const { return data_ != nullptr; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_MAPPED_FILE_H_
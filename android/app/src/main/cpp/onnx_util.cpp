@@ -0,0 +1,101 @@
+#include "onnx_util.h"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace sherpa_tts {
+
+namespace {
+
+std::string GetInputName(Ort::Session* sess, size_t index,
+                         OrtAllocator* allocator) {
+#if ORT_API_VERSION >= 12
+  auto v = sess->GetInputNameAllocated(index, allocator);
+  return std::string(v.get());
+#else
+  auto* v = sess->GetInputName(index, allocator);
+  std::string ans = v ? v : "";
+  if (v && allocator) allocator->Free(allocator, v);
+  return ans;
+#endif
+}
+
+std::string GetOutputName(Ort::Session* sess, size_t index,
+                          OrtAllocator* allocator) {
+#if ORT_API_VERSION >= 12
+  auto v = sess->GetOutputNameAllocated(index, allocator);
+  return std::string(v.get());
+#else
+  auto* v = sess->GetOutputName(index, allocator);
+  std::string ans = v ? v : "";
+  if (v && allocator) allocator->Free(allocator, v);
+  return ans;
+#endif
+}
+
+}  // namespace
+
+Ort::Env& SharedOrtEnv() {
+  // 有意泄漏：避免与其他静态对象的析构顺序问题
+  static Ort::Env* env = new Ort::Env(ORT_LOGGING_LEVEL_WARNING, "sherpa-tts");
+  return *env;
+}
+
+std::vector<char> ReadFileBytes(const std::string& path) {
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  if (!is) return {};
+  size_t size = is.tellg();
+  is.seekg(0);
+  std::vector<char> buf(size);
+  if (!is.read(buf.data(), size)) return {};
+  return buf;
+}
+
+void GetInputNames(Ort::Session* sess, std::vector<std::string>* names,
+                   std::vector<const char*>* ptrs) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  size_t n = sess->GetInputCount();
+  names->resize(n);
+  ptrs->resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    (*names)[i] = GetInputName(sess, i, allocator);
+    (*ptrs)[i] = (*names)[i].c_str();
+  }
+}
+
+void GetOutputNames(Ort::Session* sess, std::vector<std::string>* names,
+                    std::vector<const char*>* ptrs) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  size_t n = sess->GetOutputCount();
+  names->resize(n);
+  ptrs->resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    (*names)[i] = GetOutputName(sess, i, allocator);
+    (*ptrs)[i] = (*names)[i].c_str();
+  }
+}
+
+std::string GetMetadataStr(Ort::Session* sess, const char* key) {
+  try {
+    Ort::ModelMetadata meta = sess->GetModelMetadata();
+    Ort::AllocatorWithDefaultOptions allocator;
+#if ORT_API_VERSION >= 12
+    auto v = meta.LookupCustomMetadataMapAllocated(key, allocator);
+    return v ? std::string(v.get()) : "";
+#else
+    const char* v = meta.LookupCustomMetadataMap(key, allocator);
+    return v ? std::string(v) : "";
+#endif
+  } catch (...) {
+    return "";
+  }
+}
+
+int32_t GetMetadataInt(Ort::Session* sess, const char* key,
+                       int32_t default_val) {
+  std::string s = GetMetadataStr(sess, key);
+  if (s.empty()) return default_val;
+  return static_cast<int32_t>(std::atoi(s.c_str()));
+}
+
+}  // namespace sherpa_tts
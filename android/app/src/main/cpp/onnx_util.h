@@ -0,0 +1,31 @@
+#ifndef SHERPA_TTS_ONNX_UTIL_H_
+#define SHERPA_TTS_ONNX_UTIL_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <onnxruntime_cxx_api.h>
+
+namespace sherpa_tts {
+
+// 进程内共享的 ONNX Runtime 环境：VITS 与 G2P 的会话都建在它上面（ORT 要求每进程一个 Env），
+// 首次调用时创建，进程退出前不销毁。
+Ort::Env& SharedOrtEnv();
+
+// 读取整个文件，失败返回空
+std::vector<char> ReadFileBytes(const std::string& path);
+
+// 输入 / 输出名；ptrs 指向 names 中的字符串，names 不可再修改
+void GetInputNames(Ort::Session* sess, std::vector<std::string>* names,
+                   std::vector<const char*>* ptrs);
+void GetOutputNames(Ort::Session* sess, std::vector<std::string>* names,
+                    std::vector<const char*>* ptrs);
+
+// 模型自定义元数据，不存在时返回空串 / default_val
+std::string GetMetadataStr(Ort::Session* sess, const char* key);
+int32_t GetMetadataInt(Ort::Session* sess, const char* key, int32_t default_val);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_ONNX_UTIL_H_
@@ -0,0 +1,325 @@
+#include "piper_config.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include "mapped_file.h"
+#include "token_table.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+constexpr int kMaxDepth = 64;
+
+// 只进不退的 JSON 游标：按需读取字段，不建 DOM。所有读取函数失败时返回 false。
+class JsonReader {
+ public:
+  explicit JsonReader(std::string_view s) : s_(s) {}
+
+  bool AtEnd() {
+    SkipSpace();
+    return pos_ == s_.size();
+  }
+
+  // 读一个字符串到 out（复用 out 的容量）；转义含 \uXXXX 与代理对
+  bool ReadString(std::string* out) {
+    SkipSpace();
+    if (!Consume('"')) return false;
+    out->clear();
+    while (pos_ < s_.size()) {
+      const size_t run = s_.find_first_of("\"\\", pos_);
+      if (run == std::string_view::npos) return false;
+      out->append(s_.data() + pos_, run - pos_);
+      pos_ = run + 1;
+      if (s_[run] == '"') return true;
+      if (pos_ >= s_.size()) return false;
+      const char e = s_[pos_++];
+      switch (e) {
+        case '"':
+        case '\\':
+        case '/':
+          out->push_back(e);
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t cp = 0;
+          if (!ReadHex4(&cp)) return false;
+          if (cp >= 0xD800 && cp < 0xDC00) {  // 高代理，后面须跟低代理
+            uint32_t low = 0;
+            if (!Consume('\\') || !Consume('u') || !ReadHex4(&low) ||
+                low < 0xDC00 || low >= 0xE000) {
+              return false;
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(cp, out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  bool ReadInt(int64_t* out) {
+    SkipSpace();
+    bool negative = Consume('-');
+    const size_t start = pos_;
+    int64_t v = 0;
+    while (pos_ < s_.size() && s_[pos_] >= '0' && s_[pos_] <= '9') {
+      v = v * 10 + (s_[pos_++] - '0');
+      if (v > (int64_t{1} << 53)) return false;
+    }
+    if (pos_ == start) return false;
+    *out = negative ? -v : v;
+    return true;
+  }
+
+  bool ReadDouble(double* out) {
+    SkipSpace();
+    // 拷到本地缓冲再 strtod：映射的文件不以 '\0' 结尾
+    char buf[64];
+    size_t n = 0;
+    while (pos_ < s_.size() && n + 1 < sizeof(buf) && IsNumberChar(s_[pos_])) {
+      buf[n++] = s_[pos_++];
+    }
+    if (n == 0) return false;
+    buf[n] = '\0';
+    char* end = nullptr;
+    *out = std::strtod(buf, &end);
+    return end == buf + n;
+  }
+
+  // 逐个读取对象的键，on_key(key) 须读掉对应的值
+  template <typename OnKey>
+  bool ReadObject(std::string* key, OnKey&& on_key) {
+    SkipSpace();
+    if (!Consume('{')) return false;
+    SkipSpace();
+    if (Consume('}')) return true;
+    do {
+      if (!ReadString(key)) return false;
+      SkipSpace();
+      if (!Consume(':')) return false;
+      if (!on_key(*key)) return false;
+      SkipSpace();
+    } while (Consume(','));
+    SkipSpace();
+    return Consume('}');
+  }
+
+  // 跳过任意值（对象 / 数组递归，深度受限）
+  bool SkipValue(int depth = 0) {
+    if (depth > kMaxDepth) return false;
+    SkipSpace();
+    if (pos_ >= s_.size()) return false;
+    const char c = s_[pos_];
+    if (c == '"') return ReadString(&scratch_);
+    if (c == '{') {
+      std::string key;
+      return ReadObject(&key, [&](const std::string&) { return SkipValue(depth + 1); });
+    }
+    if (c == '[') {
+      ++pos_;
+      SkipSpace();
+      if (Consume(']')) return true;
+      do {
+        if (!SkipValue(depth + 1)) return false;
+        SkipSpace();
+      } while (Consume(','));
+      SkipSpace();
+      return Consume(']');
+    }
+    if (ConsumeWord("true") || ConsumeWord("false") || ConsumeWord("null")) return true;
+    double ignored;
+    return ReadDouble(&ignored);
+  }
+
+  // 读一个整数数组到 out（复用 out 的容量）
+  bool ReadIntArray(std::vector<int64_t>* out) {
+    out->clear();
+    SkipSpace();
+    if (!Consume('[')) return false;
+    SkipSpace();
+    if (Consume(']')) return true;
+    do {
+      int64_t v = 0;
+      if (!ReadInt(&v)) return false;
+      out->push_back(v);
+      SkipSpace();
+    } while (Consume(','));
+    SkipSpace();
+    return Consume(']');
+  }
+
+ private:
+  static bool IsNumberChar(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+           c == 'e' || c == 'E';
+  }
+
+  static void AppendUtf8(uint32_t cp, std::string* out) {
+    if (cp <= 0x7F) {
+      out->push_back(static_cast<char>(cp));
+    } else if (cp <= 0x7FF) {
+      out->push_back(static_cast<char>(0xC0 | (cp >> 6)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp <= 0xFFFF) {
+      out->push_back(static_cast<char>(0xE0 | (cp >> 12)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+      out->push_back(static_cast<char>(0xF0 | (cp >> 18)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+  }
+
+  void SkipSpace() {
+    while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\n' ||
+                                s_[pos_] == '\r' || s_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    if (pos_ < s_.size() && s_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeWord(std::string_view word) {
+    if (s_.substr(pos_, word.size()) != word) return false;
+    pos_ += word.size();
+    return true;
+  }
+
+  bool ReadHex4(uint32_t* out) {
+    if (pos_ + 4 > s_.size()) return false;
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+      const char c = s_[pos_++];
+      v <<= 4;
+      if (c >= '0' && c <= '9') {
+        v |= static_cast<uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        v |= static_cast<uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        v |= static_cast<uint32_t>(c - 'A' + 10);
+      } else {
+        return false;
+      }
+    }
+    *out = v;
+    return true;
+  }
+
+  std::string_view s_;
+  size_t pos_ = 0;
+  std::string scratch_;
+};
+
+bool ReadFloat(JsonReader* reader, float* out) {
+  double v = 0;
+  if (!reader->ReadDouble(&v)) return false;
+  *out = static_cast<float>(v);
+  return true;
+}
+
+}  // namespace
+
+bool ParsePiperVoiceConfig(std::string_view json, PiperVoiceConfig* config,
+                           TokenTable* token_table) {
+  if (!config || !token_table) return false;
+  *config = PiperVoiceConfig();
+  config->phoneme_type = "espeak";
+  token_table->Clear();
+
+  JsonReader reader(json);
+  std::string key;
+  std::string inner_key;
+  std::string phoneme;
+  std::vector<int64_t> ids;
+  bool has_map = false;
+  const bool ok = reader.ReadObject(&key, [&](const std::string& k) {
+    if (k == "phoneme_id_map") {
+      has_map = true;
+      return reader.ReadObject(&phoneme, [&](const std::string& p) {
+        if (!reader.ReadIntArray(&ids)) return false;
+        if (!ids.empty()) {
+          token_table->Add(p, ids.data(), ids.size());
+          ++config->num_phonemes;
+        }
+        return true;
+      });
+    }
+    if (k == "audio") {
+      return reader.ReadObject(&inner_key, [&](const std::string& a) {
+        if (a != "sample_rate") return reader.SkipValue();
+        int64_t v = 0;
+        if (!reader.ReadInt(&v)) return false;
+        config->sample_rate = static_cast<int32_t>(v);
+        return true;
+      });
+    }
+    if (k == "espeak") {
+      return reader.ReadObject(&inner_key, [&](const std::string& e) {
+        return e == "voice" ? reader.ReadString(&config->espeak_voice)
+                            : reader.SkipValue();
+      });
+    }
+    if (k == "inference") {
+      return reader.ReadObject(&inner_key, [&](const std::string& i) {
+        if (i == "noise_scale") return ReadFloat(&reader, &config->noise_scale);
+        if (i == "length_scale") return ReadFloat(&reader, &config->length_scale);
+        if (i == "noise_w") return ReadFloat(&reader, &config->noise_w);
+        return reader.SkipValue();
+      });
+    }
+    if (k == "phoneme_type") return reader.ReadString(&config->phoneme_type);
+    if (k == "num_speakers") {
+      int64_t v = 0;
+      if (!reader.ReadInt(&v)) return false;
+      config->num_speakers = static_cast<int32_t>(v);
+      return true;
+    }
+    return reader.SkipValue();
+  });
+  if (!ok || !reader.AtEnd() || !has_map) return false;
+  return token_table->Finish();
+}
+
+bool LoadPiperVoiceConfig(const std::string& path, PiperVoiceConfig* config,
+                          TokenTable* token_table) {
+  MappedFile file;
+  if (!file.Open(path)) return false;
+  return ParsePiperVoiceConfig(std::string_view(file.Data(), file.Size()),
+                               config, token_table);
+}
+
+bool IsPiperVoiceConfigPath(std::string_view path) {
+  constexpr std::string_view kSuffix = ".json";
+  return path.size() >= kSuffix.size() &&
+         path.substr(path.size() - kSuffix.size()) == kSuffix;
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,41 @@
+#ifndef SHERPA_TTS_PIPER_CONFIG_H_
+#define SHERPA_TTS_PIPER_CONFIG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sherpa_tts {
+
+class TokenTable;
+
+// Piper 音色随模型发布的 model.onnx.json 中本项目用到的字段
+struct PiperVoiceConfig {
+  int32_t sample_rate = 0;  // audio.sample_rate；0 表示未给出
+  float noise_scale = 0.667f;  // inference.noise_scale
+  float length_scale = 1.0f;   // inference.length_scale
+  float noise_w = 0.8f;        // inference.noise_w
+  std::string espeak_voice;    // espeak.voice
+  // "espeak"（默认）或 "text"（文本逐码点即音素，见 TextCodepointsToTokenIds）
+  std::string phoneme_type;
+  int32_t num_speakers = 1;  // 多说话人音色的 sid 须小于它
+  size_t num_phonemes = 0;  // phoneme_id_map 的条目数
+};
+
+// 单遍解析 JSON：phoneme_id_map 的每个条目直接 Add 进 token_table（一个音素可对应多个 id），
+// 不构造 DOM，其余字段只取上面几项，未知字段整体跳过。
+// JSON 非法、缺少 phoneme_id_map 或其为空时返回 false（token_table 内容不确定）。
+bool ParsePiperVoiceConfig(std::string_view json, PiperVoiceConfig* config,
+                           TokenTable* token_table);
+
+// 从文件加载（mmap，不复制文件内容）
+bool LoadPiperVoiceConfig(const std::string& path, PiperVoiceConfig* config,
+                          TokenTable* token_table);
+
+// 路径是否像 Piper 配置（以 .json 结尾）
+bool IsPiperVoiceConfigPath(std::string_view path);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_PIPER_CONFIG_H_
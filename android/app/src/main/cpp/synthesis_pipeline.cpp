@@ -0,0 +1,221 @@
+#include "synthesis_pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace sherpa_tts {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 有界阻塞队列：满时 Push 等待，空时 Pop 等待；Close 后 Push 失败，Pop 取完剩余元素后失败。
+// PushNoWait 不等空位，供已在 WaitForRoom 处等过的生产者把同一批元素一次放入。
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+  bool Push(T item) {
+    if (!WaitForRoom()) return false;
+    return PushNoWait(std::move(item));
+  }
+
+  // 等到有空位；Close 后返回 false
+  bool WaitForRoom() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+    return !closed_;
+  }
+
+  // 不等空位直接入队（可超出容量）；Close 后失败
+  bool PushNoWait(T item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) return false;
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  bool Pop(T* item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) return false;
+    *item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> items_;
+  bool closed_ = false;
+};
+
+struct TokenItem {
+  size_t index = 0;
+  std::vector<int64_t> ids;
+};
+
+struct AudioItem {
+  size_t index = 0;
+  std::vector<float> samples;
+};
+
+}  // namespace
+
+int RunSentencePipeline(const std::vector<std::string>& sentences,
+                        const PipelineOptions& options,
+                        const PipelineFrontendFn& frontend,
+                        const PipelineInferenceFn& inference,
+                        const PipelineWriterFn& writer,
+                        PipelineStats* stats) {
+  return RunChunkedSentencePipeline(
+      sentences, options,
+      [&frontend](size_t /*index*/, const std::string& sentence,
+                  const PipelineEmitFn& emit) {
+        std::vector<int64_t> ids;
+        const int code = frontend(sentence, &ids);
+        if (code == 0 && !ids.empty()) emit(std::move(ids));
+        return code;
+      },
+      inference, writer, stats);
+}
+
+int RunChunkedSentencePipeline(const std::vector<std::string>& sentences,
+                               const PipelineOptions& options,
+                               const PipelineChunkedFrontendFn& frontend,
+                               const PipelineInferenceFn& inference,
+                               const PipelineWriterFn& writer,
+                               PipelineStats* stats) {
+  PipelineStats local;
+  PipelineStats& st = stats ? *stats : local;
+  st = {};
+  st.num_sentences = sentences.size();
+  const Clock::time_point start = Clock::now();
+
+  int frontend_error = 0;
+  int inference_error = 0;
+  int writer_error = 0;
+  // 前端出错后通知推理线程丢弃已排队的段
+  std::atomic<bool> frontend_failed{false};
+
+  // 前端耗时扣除 emit 内的时间（串行时为推理与写出，流水线时为等待队列）
+  auto run_frontend = [&](size_t i, const PipelineEmitFn& emit) {
+    const Clock::time_point t = Clock::now();
+    double emit_seconds = 0;
+    int code = frontend(i, sentences[i], [&](std::vector<int64_t> ids) {
+      const Clock::time_point e = Clock::now();
+      const bool ok = emit(std::move(ids));
+      emit_seconds += SecondsSince(e);
+      return ok;
+    });
+    st.frontend_seconds += SecondsSince(t) - emit_seconds;
+    if (code == 0) return true;
+    frontend_error = code;
+    frontend_failed.store(true, std::memory_order_relaxed);
+    return false;
+  };
+  auto run_inference = [&](const std::vector<int64_t>& ids,
+                           std::vector<float>* samples) {
+    const Clock::time_point t = Clock::now();
+    inference_error = inference(ids, samples);
+    st.inference_seconds += SecondsSince(t);
+    ++st.num_chunks;
+    return inference_error == 0;
+  };
+  size_t last_written = sentences.size();  // 上一段所属的句，用于按句计数
+  auto run_writer = [&](size_t i, const std::vector<float>& samples) {
+    const Clock::time_point t = Clock::now();
+    writer_error = writer(i, samples);
+    st.writer_seconds += SecondsSince(t);
+    if (writer_error != 0) return false;
+    if (st.num_written == 0) st.first_audio_seconds = SecondsSince(start);
+    if (i != last_written) ++st.num_written;
+    last_written = i;
+    return true;
+  };
+
+  if (!options.pipelined) {
+    bool stopped = false;
+    for (size_t i = 0; i < sentences.size() && !stopped; ++i) {
+      // emit 不能在前端回调内推理（前端可能正占用 espeak 实例），先收下，前端返回后再推理
+      std::vector<std::vector<int64_t>> chunks;
+      stopped = !run_frontend(i, [&](std::vector<int64_t> ids) {
+        chunks.push_back(std::move(ids));
+        return true;
+      });
+      for (size_t k = 0; k < chunks.size() && !stopped; ++k) {
+        std::vector<float> samples;
+        stopped = !run_inference(chunks[k], &samples) || !run_writer(i, samples);
+      }
+    }
+  } else {
+    // 各阶段只在自己的线程上写各自的计数与错误码，join 之后再汇总读取
+    BoundedQueue<TokenItem> tokens(options.queue_capacity);
+    BoundedQueue<AudioItem> audio(options.queue_capacity);
+    std::thread frontend_thread([&] {
+      bool stopped = false;
+      for (size_t i = 0; i < sentences.size() && !stopped; ++i) {
+        // 只在句间等待推理腾出空位，emit 本身不阻塞
+        if (!tokens.WaitForRoom()) break;  // 下游已停止
+        const bool ok = run_frontend(i, [&](std::vector<int64_t> ids) {
+          TokenItem item;
+          item.index = i;
+          item.ids = std::move(ids);
+          stopped = stopped || !tokens.PushNoWait(std::move(item));  // 下游已停止
+          return !stopped;
+        });
+        stopped = stopped || !ok;
+      }
+      tokens.Close();
+    });
+    std::thread writer_thread([&] {
+      AudioItem item;
+      while (audio.Pop(&item)) {
+        if (!run_writer(item.index, item.samples)) break;
+      }
+      audio.Close();
+    });
+
+    TokenItem item;
+    while (tokens.Pop(&item)) {
+      if (frontend_failed.load(std::memory_order_relaxed)) break;
+      AudioItem out;
+      out.index = item.index;
+      if (!run_inference(item.ids, &out.samples)) break;
+      if (!audio.Push(std::move(out))) break;  // 写出失败
+    }
+    tokens.Close();
+    audio.Close();
+    frontend_thread.join();
+    writer_thread.join();
+  }
+
+  st.total_seconds = SecondsSince(start);
+  if (inference_error != 0) return inference_error;
+  if (writer_error != 0) return writer_error;
+  return frontend_error;
+}
+
+}  // namespace sherpa_tts
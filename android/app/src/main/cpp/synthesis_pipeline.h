@@ -0,0 +1,77 @@
+#ifndef SHERPA_TTS_SYNTHESIS_PIPELINE_H_
+#define SHERPA_TTS_SYNTHESIS_PIPELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sherpa_tts {
+
+// 逐句合成的三个阶段。返回 0 表示成功，否则为调用方自定义的错误码。
+// 任一阶段返回非 0 时整条流水线停止并返回该错误码（一句读不出来即整体失败，不静默丢句）。
+// 需要跳过的句子（如只含标点）由前端返回 0 且不输出 id。
+using PipelineFrontendFn =
+    std::function<int(const std::string& sentence, std::vector<int64_t>* ids)>;
+using PipelineInferenceFn = std::function<int(const std::vector<int64_t>& ids,
+                                              std::vector<float>* samples)>;
+using PipelineWriterFn =
+    std::function<int(size_t index, const std::vector<float>& samples)>;
+
+// 分段前端：一句可拆成若干段分别推理（如 espeak 逐子句输出），每段调用一次 emit，
+// 首段交出后推理即可开始，不必等整句的前端完成。emit 不阻塞（前端可能正占用 espeak 实例）：
+// 流水线在每句开始前等待队列有空位，同一句的各段直接入队；串行执行时各段在前端返回后才推理。
+// emit 返回 false 表示下游已停止，前端应尽快返回。
+// 已交出部分段后返回非 0 时同样使流水线失败。
+// 写出回调对同一句的各段以相同的 index 依次调用。
+using PipelineEmitFn = std::function<bool(std::vector<int64_t> ids)>;
+// index 为句号（同写出回调），各句在同一线程上按句序各调用一次。
+using PipelineChunkedFrontendFn = std::function<int(
+    size_t index, const std::string& sentence, const PipelineEmitFn& emit)>;
+
+struct PipelineOptions {
+  // 相邻阶段之间的队列容量（句数，同一句的各段可超出）；限制前端跑在推理前面的距离与缓存的音频量
+  size_t queue_capacity = 2;
+  // false 时在调用线程上逐句串行执行三个阶段（用于对比与调试）
+  bool pipelined = true;
+};
+
+struct PipelineStats {
+  size_t num_sentences = 0;
+  size_t num_written = 0;      // 实际写出的句数（前端跳过的句子不计）
+  size_t num_chunks = 0;       // 推理的段数（分段前端下一句可有多段）
+  double frontend_seconds = 0;  // 各阶段累计耗时（前端不含 emit 中等待下游的时间）
+  double inference_seconds = 0;
+  double writer_seconds = 0;
+  double total_seconds = 0;  // 端到端墙钟时间
+  double first_audio_seconds = 0;  // 首句写出完成的时刻
+
+  // 串行执行时的耗时（三阶段之和）与实际墙钟之差，即流水线省下的时间
+  double OverlapSeconds() const {
+    return frontend_seconds + inference_seconds + writer_seconds - total_seconds;
+  }
+};
+
+// 按句流水线：前端线程、推理（调用线程）、写出线程经有界队列相连，
+// 第 i 句推理时第 i+1 句在做前端、第 i-1 句在写出。写出严格按句序进行。
+// 返回 0 表示成功，否则为首个失败阶段的错误码（推理、写出、前端依次优先）。
+// 出错后前端不再处理后续句子，已排队的段也不再推理。
+int RunSentencePipeline(const std::vector<std::string>& sentences,
+                        const PipelineOptions& options,
+                        const PipelineFrontendFn& frontend,
+                        const PipelineInferenceFn& inference,
+                        const PipelineWriterFn& writer,
+                        PipelineStats* stats);
+
+// 同上，前端可把一句分段交出（见 PipelineChunkedFrontendFn）
+int RunChunkedSentencePipeline(const std::vector<std::string>& sentences,
+                               const PipelineOptions& options,
+                               const PipelineChunkedFrontendFn& frontend,
+                               const PipelineInferenceFn& inference,
+                               const PipelineWriterFn& writer,
+                               PipelineStats* stats);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_SYNTHESIS_PIPELINE_H_
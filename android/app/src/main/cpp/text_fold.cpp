@@ -0,0 +1,117 @@
+#include "text_fold.h"
+
+#if SHERPA_TTS_USE_UNI_ALGO
+#include "uni_algo.h"
+#endif
+
+namespace sherpa_tts {
+
+namespace {
+
+// 折叠 text[i] 起的一个 ASCII / 基本西里尔字符到 out[i]，返回字节数；不属于这两类返回 0。
+inline size_t FoldFastChar(std::string_view text, size_t i, char* out) {
+  const unsigned char c = static_cast<unsigned char>(text[i]);
+  if (c < 0x80) {
+    out[i] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    return 1;
+  }
+  if ((c != 0xD0 && c != 0xD1) || i + 1 >= text.size()) return 0;
+  const unsigned char b = static_cast<unsigned char>(text[i + 1]);
+  if (c == 0xD0) {
+    if (b < 0x80 || b > 0xBF) return 0;
+    if (b < 0x90) {  // Ѐ..Џ -> ѐ..џ
+      out[i] = static_cast<char>(0xD1);
+      out[i + 1] = static_cast<char>(b + 0x10);
+    } else if (b < 0xA0) {  // А..П -> а..п
+      out[i] = static_cast<char>(0xD0);
+      out[i + 1] = static_cast<char>(b + 0x20);
+    } else if (b < 0xB0) {  // Р..Я -> р..я
+      out[i] = static_cast<char>(0xD1);
+      out[i + 1] = static_cast<char>(b - 0x20);
+    } else {  // а..п
+      out[i] = static_cast<char>(c);
+      out[i + 1] = static_cast<char>(b);
+    }
+    return 2;
+  }
+  if (b < 0x80 || b > 0x9F) return 0;  // р..я、ѐ..џ；Ѡ 起的扩展西里尔字母走完整路径
+  out[i] = static_cast<char>(c);
+  out[i + 1] = static_cast<char>(b);
+  return 2;
+}
+
+}  // namespace
+
+bool FoldTextFast(std::string_view text, char* out) {
+  for (size_t i = 0; i < text.size();) {
+    size_t n = FoldFastChar(text, i, out);
+    if (n == 0) return false;
+    i += n;
+  }
+  return true;
+}
+
+bool IsFoldedFast(std::string_view text) {
+  for (size_t i = 0; i < text.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(text[i]);
+    if (c < 0x80) {
+      if (c >= 'A' && c <= 'Z') return false;
+      continue;
+    }
+    if (i + 1 >= text.size()) return false;
+    const unsigned char b = static_cast<unsigned char>(text[++i]);
+    if (!(c == 0xD0 && b >= 0xB0 && b <= 0xBF) &&
+        !(c == 0xD1 && b >= 0x80 && b <= 0x9F)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AppendFoldedText(std::string_view text, std::string* out) {
+  const size_t base = out->size();
+  out->resize(base + text.size());
+  if (FoldTextFast(text, &(*out)[base])) return;
+#if SHERPA_TTS_USE_UNI_ALGO
+  // 先折叠再组合：输入可能是 NFD 分解形式，casefold 本身也会展开部分字符，最后统一为 NFC
+  out->resize(base);
+  out->append(una::norm::to_nfc_utf8(una::cases::to_casefold_utf8(text)));
+#else
+  // 逐字符：能快速折叠的就地折叠，其余字节原样保留（长度不变）
+  char* dst = &(*out)[base];
+  for (size_t i = 0; i < text.size();) {
+    size_t n = FoldFastChar(text, i, dst);
+    if (n == 0) {
+      dst[i] = text[i];
+      n = 1;
+    }
+    i += n;
+  }
+#endif
+}
+
+void AppendLowercaseNfd(std::string_view text, std::string* out) {
+#if SHERPA_TTS_USE_UNI_ALGO
+  out->append(una::norm::to_nfd_utf8(una::cases::to_lowercase_utf8(text)));
+#else
+  const size_t base = out->size();
+  out->resize(base + text.size());
+  char* dst = &(*out)[base];
+  for (size_t i = 0; i < text.size();) {
+    size_t n = FoldFastChar(text, i, dst);
+    if (n == 0) {
+      dst[i] = text[i];
+      n = 1;
+    }
+    i += n;
+  }
+#endif
+}
+
+std::string_view FoldText(std::string_view text, std::string* buffer) {
+  buffer->clear();
+  AppendFoldedText(text, buffer);
+  return *buffer;
+}
+
+}  // namespace sherpa_tts
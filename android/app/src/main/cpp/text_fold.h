@@ -0,0 +1,35 @@
+#ifndef SHERPA_TTS_TEXT_FOLD_H_
+#define SHERPA_TTS_TEXT_FOLD_H_
+
+#include <string>
+#include <string_view>
+
+namespace sherpa_tts {
+
+// 词典键的规范形式：Unicode 大小写折叠（casefold）后再做 NFC。
+// 这样 "Привет"、"привет" 以及 NFD 分解输入（"и" + U+0306）都落到同一个键上。
+// Lexicon 在加载时折叠所有键，查询时折叠输入。
+
+// 快速路径：text 只含 ASCII 与基本西里尔字母（U+0400..U+045F）时，
+// 将折叠结果写入 out[0, text.size())（这两类字符折叠后字节数不变）并返回 true；
+// 遇到其他字符返回 false，此时 out 内容未定义。不分配内存。
+bool FoldTextFast(std::string_view text, char* out);
+
+// text 是否已是折叠形式：只认 ASCII（无大写）与小写基本西里尔字母，其余一律返回 false。
+// 用于跳过复制（词典中绝大多数键本就是小写）。
+bool IsFoldedFast(std::string_view text);
+
+// 完整折叠，结果追加到 *out。先试快速路径，否则经 uni_algo 处理
+// （未编入 uni_algo 时只折叠 ASCII 与基本西里尔字母，其余字符原样保留）。
+void AppendFoldedText(std::string_view text, std::string* out);
+
+// 返回 text 的折叠结果：必要时写入 *buffer（复用其容量）并返回指向它的视图。
+std::string_view FoldText(std::string_view text, std::string* buffer);
+
+// Piper "text" 音色的输入形式：转小写后做 NFD 分解（与 piper-phonemize 的 phonemize_codepoints 一致，
+// "й" -> "и" + U+0306），结果追加到 *out。未编入 uni_algo 时只转换 ASCII 与基本西里尔字母的大小写，不分解。
+void AppendLowercaseNfd(std::string_view text, std::string* out);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_TEXT_FOLD_H_
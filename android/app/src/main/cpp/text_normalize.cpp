@@ -0,0 +1,1487 @@
+#include "text_normalize.h"
+
+#include <algorithm>
+
+#include "text_fold.h"
+#include "text_segment.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// 规则表
+// ---------------------------------------------------------------------------
+
+enum class Gender : uint8_t { kMasc = 0, kFem = 1, kNeut = 2 };
+
+// 俄语序数词的格 / 性 / 数（只列文本后缀能区分出的形式）
+enum class OrdinalForm : uint8_t {
+  kMascNom = 0,  // пятый
+  kFemNom,       // пятая
+  kNeutNom,      // пятое
+  kMascGen,      // пятого
+  kFemGen,       // пятой
+  kDat,          // пятому
+  kInstr,        // пятым
+  kPrep,         // пятом
+  kFemAcc,       // пятую
+  kPluralNom,    // пятые
+  kPluralGen,    // пятых
+};
+
+// 序数词词干的变格类型：硬变化（-ый）、重音在词尾（-ой）、третий 的软变化
+enum class StemClass : uint8_t { kHard = 0, kStressed = 1, kSoft = 2 };
+
+constexpr const char* kRuOrdinalEndings[3][11] = {
+    {"ый", "ая", "ое", "ого", "ой", "ому", "ым", "ом", "ую", "ые", "ых"},
+    {"ой", "ая", "ое", "ого", "ой", "ому", "ым", "ом", "ую", "ые", "ых"},
+    {"ий", "ья", "ье", "ьего", "ьей", "ьему", "ьим", "ьем", "ью", "ьи", "ьих"},
+};
+
+struct OrdinalStem {
+  const char* stem;
+  StemClass cls;
+};
+
+constexpr OrdinalStem kRuOrdinalUnits[10] = {
+    {"нулев", StemClass::kStressed}, {"перв", StemClass::kHard},
+    {"втор", StemClass::kStressed},  {"трет", StemClass::kSoft},
+    {"четвёрт", StemClass::kHard},   {"пят", StemClass::kHard},
+    {"шест", StemClass::kStressed},  {"седьм", StemClass::kStressed},
+    {"восьм", StemClass::kStressed}, {"девят", StemClass::kHard},
+};
+constexpr OrdinalStem kRuOrdinalTeens[10] = {
+    {"десят", StemClass::kHard},       {"одиннадцат", StemClass::kHard},
+    {"двенадцат", StemClass::kHard},   {"тринадцат", StemClass::kHard},
+    {"четырнадцат", StemClass::kHard}, {"пятнадцат", StemClass::kHard},
+    {"шестнадцат", StemClass::kHard},  {"семнадцат", StemClass::kHard},
+    {"восемнадцат", StemClass::kHard}, {"девятнадцат", StemClass::kHard},
+};
+constexpr OrdinalStem kRuOrdinalTens[10] = {
+    {nullptr, StemClass::kHard},        {nullptr, StemClass::kHard},
+    {"двадцат", StemClass::kHard},      {"тридцат", StemClass::kHard},
+    {"сороков", StemClass::kStressed},  {"пятидесят", StemClass::kHard},
+    {"шестидесят", StemClass::kHard},   {"семидесят", StemClass::kHard},
+    {"восьмидесят", StemClass::kHard},  {"девяност", StemClass::kHard},
+};
+constexpr OrdinalStem kRuOrdinalHundreds[10] = {
+    {nullptr, StemClass::kHard},       {"сот", StemClass::kHard},
+    {"двухсот", StemClass::kHard},     {"трёхсот", StemClass::kHard},
+    {"четырёхсот", StemClass::kHard},  {"пятисот", StemClass::kHard},
+    {"шестисот", StemClass::kHard},    {"семисот", StemClass::kHard},
+    {"восьмисот", StemClass::kHard},   {"девятисот", StemClass::kHard},
+};
+
+constexpr const char* kRuUnits[3][10] = {
+    {"ноль", "один", "два", "три", "четыре", "пять", "шесть", "семь", "восемь",
+     "девять"},
+    {"ноль", "одна", "две", "три", "четыре", "пять", "шесть", "семь", "восемь",
+     "девять"},
+    {"ноль", "одно", "два", "три", "четыре", "пять", "шесть", "семь", "восемь",
+     "девять"},
+};
+constexpr const char* kRuTeens[10] = {
+    "десять",     "одиннадцать", "двенадцать",  "тринадцать",   "четырнадцать",
+    "пятнадцать", "шестнадцать", "семнадцать", "восемнадцать", "девятнадцать",
+};
+constexpr const char* kRuTens[10] = {
+    "",          "",          "двадцать",    "тридцать",     "сорок",
+    "пятьдесят", "шестьдесят", "семьдесят", "восемьдесят", "девяносто",
+};
+constexpr const char* kRuHundreds[10] = {
+    "",        "сто",      "двести",  "триста",    "четыреста",
+    "пятьсот", "шестьсот", "семьсот", "восемьсот", "девятьсот",
+};
+
+struct RuScale {
+  uint64_t value;
+  Gender gender;
+  const char* forms[3];  // 1 / 2-4 / 5+
+  const char* ordinal_stem;
+};
+
+// 从大到小
+constexpr RuScale kRuScales[] = {
+    {1000000000000ULL, Gender::kMasc, {"триллион", "триллиона", "триллионов"},
+     "триллионн"},
+    {1000000000ULL, Gender::kMasc, {"миллиард", "миллиарда", "миллиардов"},
+     "миллиардн"},
+    {1000000ULL, Gender::kMasc, {"миллион", "миллиона", "миллионов"},
+     "миллионн"},
+    {1000ULL, Gender::kFem, {"тысяча", "тысячи", "тысяч"}, "тысячн"},
+};
+
+// 整千 / 整百万序数的合成前缀（"двухтысячный"）；只支持 1..9
+constexpr const char* kRuGenitivePrefix[10] = {
+    "", "", "двух", "трёх", "четырёх", "пяти", "шести", "семи", "восьми", "девяти",
+};
+
+constexpr const char* kRuFractionNames[3][2] = {
+    {"десятая", "десятых"},
+    {"сотая", "сотых"},
+    {"тысячная", "тысячных"},
+};
+
+constexpr const char* kRuMonthsGenitive[12] = {
+    "января", "февраля", "марта",    "апреля",  "мая",    "июня",
+    "июля",   "августа", "сентября", "октября", "ноября", "декабря",
+};
+
+constexpr const char* kRuHourForms[3] = {"час", "часа", "часов"};
+constexpr const char* kRuMinuteForms[3] = {"минута", "минуты", "минут"};
+
+// 数字后的后缀（"5-й"、"90-х"），长的在前
+struct RuOrdinalSuffix {
+  const char* text;
+  OrdinalForm form;
+};
+
+constexpr RuOrdinalSuffix kRuOrdinalSuffixes[] = {
+    {"ого", OrdinalForm::kMascGen},   {"его", OrdinalForm::kMascGen},
+    {"ому", OrdinalForm::kDat},       {"ему", OrdinalForm::kDat},
+    {"го", OrdinalForm::kMascGen},    {"му", OrdinalForm::kDat},
+    {"ый", OrdinalForm::kMascNom},    {"ий", OrdinalForm::kMascNom},
+    {"ой", OrdinalForm::kFemGen},     {"ей", OrdinalForm::kFemGen},
+    {"ая", OrdinalForm::kFemNom},     {"ья", OrdinalForm::kFemNom},
+    {"ое", OrdinalForm::kNeutNom},    {"ье", OrdinalForm::kNeutNom},
+    {"ые", OrdinalForm::kPluralNom},  {"ие", OrdinalForm::kPluralNom},
+    {"ым", OrdinalForm::kInstr},      {"им", OrdinalForm::kInstr},
+    {"ом", OrdinalForm::kPrep},       {"ем", OrdinalForm::kPrep},
+    {"ую", OrdinalForm::kFemAcc},     {"ых", OrdinalForm::kPluralGen},
+    {"их", OrdinalForm::kPluralGen},  {"й", OrdinalForm::kMascNom},
+    {"я", OrdinalForm::kFemNom},      {"е", OrdinalForm::kNeutNom},
+    {"м", OrdinalForm::kPrep},        {"ю", OrdinalForm::kFemAcc},
+    {"х", OrdinalForm::kPluralGen},
+};
+
+// 四位数后的 "год" 各格：数字按序数读（"в 2026 году" -> "в две тысячи двадцать шестом году"）。
+// range_form 为年份区间（"1990–2000 годах"）中每个年份的形式：序数词用单数，与复数名词同格。
+// expansion 非空时同时展开缩写本身；"гг." 用于区间时按前置词定格（见 kRuYearRangeCases）。
+struct RuYearWord {
+  const char* text;
+  OrdinalForm form;
+  OrdinalForm range_form;
+  const char* expansion;
+};
+
+constexpr RuYearWord kRuYearWords[] = {
+    {"годами", OrdinalForm::kInstr, OrdinalForm::kInstr, nullptr},
+    {"годам", OrdinalForm::kDat, OrdinalForm::kDat, nullptr},
+    {"годом", OrdinalForm::kInstr, OrdinalForm::kInstr, nullptr},
+    {"годах", OrdinalForm::kPluralGen, OrdinalForm::kPrep, nullptr},
+    {"годов", OrdinalForm::kPluralGen, OrdinalForm::kMascGen, nullptr},
+    {"году", OrdinalForm::kPrep, OrdinalForm::kPrep, nullptr},
+    {"года", OrdinalForm::kMascGen, OrdinalForm::kMascGen, nullptr},
+    {"годы", OrdinalForm::kPluralNom, OrdinalForm::kMascNom, nullptr},
+    {"год", OrdinalForm::kMascNom, OrdinalForm::kMascNom, nullptr},
+    {"гг.", OrdinalForm::kPluralGen, OrdinalForm::kMascNom, "годов"},
+    {"г.", OrdinalForm::kMascGen, OrdinalForm::kMascGen, "года"},
+};
+
+// "X–Y гг." 的格由区间前的前置词决定（"в 1990–2000 гг." -> "в … девяностом-двухтысячном годах"），
+// 没有前置词时按主格读
+struct RuYearRangeCase {
+  const char* preposition;
+  OrdinalForm form;
+  const char* years;
+};
+
+constexpr RuYearRangeCase kRuYearRangeCases[] = {
+    {"в", OrdinalForm::kPrep, "годах"},      {"во", OrdinalForm::kPrep, "годах"},
+    {"о", OrdinalForm::kPrep, "годах"},      {"об", OrdinalForm::kPrep, "годах"},
+    {"при", OrdinalForm::kPrep, "годах"},    {"к", OrdinalForm::kDat, "годам"},
+    {"до", OrdinalForm::kMascGen, "годов"},  {"от", OrdinalForm::kMascGen, "годов"},
+    {"с", OrdinalForm::kMascGen, "годов"},   {"со", OrdinalForm::kMascGen, "годов"},
+    {"из", OrdinalForm::kMascGen, "годов"},  {"после", OrdinalForm::kMascGen, "годов"},
+    {"около", OrdinalForm::kMascGen, "годов"}, {"для", OrdinalForm::kMascGen, "годов"},
+    {"за", OrdinalForm::kMascNom, "годы"},   {"на", OrdinalForm::kMascNom, "годы"},
+    {"через", OrdinalForm::kMascNom, "годы"}, {"про", OrdinalForm::kMascNom, "годы"},
+    {"между", OrdinalForm::kInstr, "годами"}, {"перед", OrdinalForm::kInstr, "годами"},
+};
+
+constexpr const char* kEnOnes[20] = {
+    "zero",    "one",     "two",       "three",    "four",
+    "five",    "six",     "seven",     "eight",    "nine",
+    "ten",     "eleven",  "twelve",    "thirteen", "fourteen",
+    "fifteen", "sixteen", "seventeen", "eighteen", "nineteen",
+};
+constexpr const char* kEnTens[10] = {
+    "", "", "twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty",
+    "ninety",
+};
+
+struct EnScale {
+  uint64_t value;
+  const char* name;
+};
+
+constexpr EnScale kEnScales[] = {
+    {1000000000000ULL, "trillion"},
+    {1000000000ULL, "billion"},
+    {1000000ULL, "million"},
+    {1000ULL, "thousand"},
+};
+
+struct EnIrregularOrdinal {
+  const char* cardinal;
+  const char* ordinal;
+};
+
+constexpr EnIrregularOrdinal kEnIrregularOrdinals[] = {
+    {"one", "first"}, {"two", "second"}, {"three", "third"}, {"five", "fifth"},
+    {"eight", "eighth"}, {"nine", "ninth"}, {"twelve", "twelfth"},
+};
+
+constexpr const char* kEnMonths[12] = {
+    "January", "February", "March",     "April",   "May",      "June",
+    "July",    "August",   "September", "October", "November", "December",
+};
+
+// 数字后的单位 / 货币符号。forms：俄语为 1 / 2-4 / 5+，英语为 单数 / 复数 / 复数。
+// 同前缀的符号长的在前（"км/ч" 在 "км" 前，"мм" 在 "м" 前）。
+struct UnitRule {
+  const char* symbol;
+  Gender gender;
+  const char* forms[3];
+  bool allow_dot = false;  // 可带缩写点（"руб."）
+  bool prefix = false;     // 货币符号可前置（"$5"）
+  Gender minor_gender = Gender::kMasc;
+  const char* minor[3] = {nullptr, nullptr, nullptr};  // 辅币：两位小数读作 "… рублей … копеек"
+};
+
+const UnitRule kRuUnitRules[] = {
+    {"%", Gender::kMasc, {"процент", "процента", "процентов"}},
+    {"км/ч", Gender::kMasc,
+     {"километр в час", "километра в час", "километров в час"}},
+    {"км", Gender::kMasc, {"километр", "километра", "километров"}},
+    {"мм", Gender::kMasc, {"миллиметр", "миллиметра", "миллиметров"}},
+    {"мг", Gender::kMasc, {"миллиграмм", "миллиграмма", "миллиграммов"}},
+    {"млрд", Gender::kMasc, {"миллиард", "миллиарда", "миллиардов"}, true},
+    {"млн", Gender::kMasc, {"миллион", "миллиона", "миллионов"}, true},
+    {"мл", Gender::kMasc, {"миллилитр", "миллилитра", "миллилитров"}},
+    {"мин", Gender::kFem, {"минута", "минуты", "минут"}, true},
+    {"мс", Gender::kFem, {"миллисекунда", "миллисекунды", "миллисекунд"}},
+    {"м", Gender::kMasc, {"метр", "метра", "метров"}},
+    {"см", Gender::kMasc, {"сантиметр", "сантиметра", "сантиметров"}},
+    {"кг", Gender::kMasc, {"килограмм", "килограмма", "килограммов"}},
+    {"г", Gender::kMasc, {"грамм", "грамма", "граммов"}, true},
+    {"т", Gender::kFem, {"тонна", "тонны", "тонн"}},
+    {"л", Gender::kMasc, {"литр", "литра", "литров"}},
+    {"ч", Gender::kMasc, {"час", "часа", "часов"}},
+    {"сек", Gender::kFem, {"секунда", "секунды", "секунд"}, true},
+    {"тыс", Gender::kFem, {"тысяча", "тысячи", "тысяч"}, true},
+    {"шт", Gender::kFem, {"штука", "штуки", "штук"}, true},
+    {"ГБ", Gender::kMasc, {"гигабайт", "гигабайта", "гигабайт"}},
+    {"МБ", Gender::kMasc, {"мегабайт", "мегабайта", "мегабайт"}},
+    {"°C", Gender::kMasc,
+     {"градус Цельсия", "градуса Цельсия", "градусов Цельсия"}},
+    {"°С", Gender::kMasc,  // 西里尔字母 С
+     {"градус Цельсия", "градуса Цельсия", "градусов Цельсия"}},
+    {"°", Gender::kMasc, {"градус", "градуса", "градусов"}},
+    {"руб", Gender::kMasc, {"рубль", "рубля", "рублей"}, true, false,
+     Gender::kFem, {"копейка", "копейки", "копеек"}},
+    {"коп", Gender::kFem, {"копейка", "копейки", "копеек"}, true},
+    {"₽", Gender::kMasc, {"рубль", "рубля", "рублей"}, false, true,
+     Gender::kFem, {"копейка", "копейки", "копеек"}},
+    {"$", Gender::kMasc, {"доллар", "доллара", "долларов"}, false, true,
+     Gender::kMasc, {"цент", "цента", "центов"}},
+    {"€", Gender::kNeut, {"евро", "евро", "евро"}, false, true,
+     Gender::kMasc, {"цент", "цента", "центов"}},
+    {"£", Gender::kMasc, {"фунт", "фунта", "фунтов"}, false, true,
+     Gender::kMasc, {"пенс", "пенса", "пенсов"}},
+};
+
+const UnitRule kEnUnitRules[] = {
+    {"%", Gender::kMasc, {"percent", "percent", "percent"}},
+    {"km/h", Gender::kMasc,
+     {"kilometer per hour", "kilometers per hour", "kilometers per hour"}},
+    {"km", Gender::kMasc, {"kilometer", "kilometers", "kilometers"}},
+    {"kg", Gender::kMasc, {"kilogram", "kilograms", "kilograms"}},
+    {"cm", Gender::kMasc, {"centimeter", "centimeters", "centimeters"}},
+    {"mm", Gender::kMasc, {"millimeter", "millimeters", "millimeters"}},
+    {"mg", Gender::kMasc, {"milligram", "milligrams", "milligrams"}},
+    {"ml", Gender::kMasc, {"milliliter", "milliliters", "milliliters"}},
+    {"ms", Gender::kMasc, {"millisecond", "milliseconds", "milliseconds"}},
+    {"mph", Gender::kMasc, {"mile per hour", "miles per hour", "miles per hour"}},
+    {"min", Gender::kMasc, {"minute", "minutes", "minutes"}, true},
+    {"m", Gender::kMasc, {"meter", "meters", "meters"}},
+    {"g", Gender::kMasc, {"gram", "grams", "grams"}},
+    {"h", Gender::kMasc, {"hour", "hours", "hours"}},
+    {"sec", Gender::kMasc, {"second", "seconds", "seconds"}, true},
+    {"KB", Gender::kMasc, {"kilobyte", "kilobytes", "kilobytes"}},
+    {"MB", Gender::kMasc, {"megabyte", "megabytes", "megabytes"}},
+    {"GB", Gender::kMasc, {"gigabyte", "gigabytes", "gigabytes"}},
+    {"TB", Gender::kMasc, {"terabyte", "terabytes", "terabytes"}},
+    {"°C", Gender::kMasc,
+     {"degree Celsius", "degrees Celsius", "degrees Celsius"}},
+    {"°F", Gender::kMasc,
+     {"degree Fahrenheit", "degrees Fahrenheit", "degrees Fahrenheit"}},
+    {"°", Gender::kMasc, {"degree", "degrees", "degrees"}},
+    {"$", Gender::kMasc, {"dollar", "dollars", "dollars"}, false, true,
+     Gender::kMasc, {"cent", "cents", "cents"}},
+    {"€", Gender::kMasc, {"euro", "euros", "euros"}, false, true,
+     Gender::kMasc, {"cent", "cents", "cents"}},
+    {"£", Gender::kMasc, {"pound", "pounds", "pounds"}, false, true,
+     Gender::kMasc, {"penny", "pence", "pence"}},
+    {"₽", Gender::kMasc, {"ruble", "rubles", "rubles"}, false, true,
+     Gender::kMasc, {"kopeck", "kopecks", "kopecks"}},
+};
+
+// 缩写：pattern 为小写（匹配时输入先折叠），内部的 "." 后允许一个空格（"т. е."）。
+// ends_sentence：缩写点可兼作句末（"и т.д." 在句尾时补回 "."）；称谓类不会出现在句末。
+struct AbbreviationRule {
+  const char* pattern;
+  const char* expansion;
+  bool ends_sentence;
+};
+
+constexpr AbbreviationRule kRuAbbreviations[] = {
+    {"т.е.", "то есть", false},
+    {"т.д.", "так далее", true},
+    {"т.п.", "тому подобное", true},
+    {"т.к.", "так как", false},
+    {"т.н.", "так называемый", false},
+    {"и.о.", "исполняющий обязанности", false},
+    {"г-н", "господин", false},
+    {"г-жа", "госпожа", false},
+    {"напр.", "например", false},
+    {"см.", "смотри", false},
+    {"др.", "другие", true},
+    {"стр.", "страница", false},
+    {"рис.", "рисунок", false},
+    {"ул.", "улица", false},
+    {"тел.", "телефон", false},
+    {"им.", "имени", false},
+    {"проф.", "профессор", false},
+    {"акад.", "академик", false},
+};
+
+constexpr AbbreviationRule kEnAbbreviations[] = {
+    {"e.g.", "for example", false},
+    {"i.e.", "that is", false},
+    {"etc.", "et cetera", true},
+    {"vs.", "versus", false},
+    {"mrs.", "missus", false},
+    {"mr.", "mister", false},
+    {"ms.", "miss", false},
+    {"dr.", "doctor", false},
+    {"prof.", "professor", false},
+    {"approx.", "approximately", false},
+    {"jr.", "junior", true},
+    {"sr.", "senior", true},
+};
+
+constexpr size_t kMaxAbbreviationBytes = 32;
+// 超过 15 位（千万亿）的数字串逐位读
+constexpr size_t kMaxNumberDigits = 15;
+
+template <typename T, size_t N>
+constexpr size_t ArraySize(const T (&)[N]) {
+  return N;
+}
+
+// ---------------------------------------------------------------------------
+// 数词
+// ---------------------------------------------------------------------------
+
+void AppendWord(std::string_view word, std::string* out) {
+  if (word.empty()) return;
+  if (!out->empty() && out->back() != ' ') out->push_back(' ');
+  out->append(word.data(), word.size());
+}
+
+uint64_t ParseDigits(std::string_view digits) {
+  uint64_t v = 0;
+  for (char c : digits) v = v * 10 + static_cast<uint64_t>(c - '0');
+  return v;
+}
+
+// 名词随数量的变格：1 / 2-4 / 5+（11..14 归入 5+）
+size_t RuPluralIndex(uint64_t n) {
+  const uint64_t n100 = n % 100;
+  if (n100 >= 11 && n100 <= 14) return 2;
+  const uint64_t n10 = n % 10;
+  if (n10 == 1) return 0;
+  if (n10 >= 2 && n10 <= 4) return 1;
+  return 2;
+}
+
+// 1..999
+void AppendRuTriple(uint32_t n, Gender gender, std::string* out) {
+  AppendWord(kRuHundreds[n / 100], out);
+  const uint32_t t = n % 100;
+  if (t >= 10 && t < 20) {
+    AppendWord(kRuTeens[t - 10], out);
+    return;
+  }
+  AppendWord(kRuTens[t / 10], out);
+  if (t % 10 != 0) AppendWord(kRuUnits[static_cast<size_t>(gender)][t % 10], out);
+}
+
+// n < 10^15。"тысяча"、"миллион" 前的 "одна / один" 省略
+void AppendRuCardinal(uint64_t n, Gender gender, std::string* out) {
+  if (n == 0) {
+    AppendWord(kRuUnits[0][0], out);
+    return;
+  }
+  for (const RuScale& scale : kRuScales) {
+    const uint64_t k = n / scale.value;
+    if (k == 0) continue;
+    if (k > 1) AppendRuTriple(static_cast<uint32_t>(k), scale.gender, out);
+    AppendWord(scale.forms[RuPluralIndex(k)], out);
+    n %= scale.value;
+  }
+  if (n > 0) AppendRuTriple(static_cast<uint32_t>(n), gender, out);
+}
+
+void AppendRuOrdinalWord(std::string_view prefix, const OrdinalStem& stem,
+                         OrdinalForm form, std::string* out) {
+  std::string word(prefix);
+  word += stem.stem;
+  word += kRuOrdinalEndings[static_cast<size_t>(stem.cls)]
+                           [static_cast<size_t>(form)];
+  AppendWord(word, out);
+}
+
+// 只有最后一个词变为序数："две тысячи двадцать шестой"。
+// 整千 / 整百万合成一个词（"двухтысячный"），倍数超过 9 时不支持，返回 false。
+bool AppendRuOrdinal(uint64_t n, OrdinalForm form, std::string* out) {
+  const uint32_t rem = static_cast<uint32_t>(n % 1000);
+  if (n == 0) {
+    AppendRuOrdinalWord({}, kRuOrdinalUnits[0], form, out);
+    return true;
+  }
+  if (rem != 0) {
+    if (n >= 1000) AppendRuCardinal(n - rem, Gender::kMasc, out);
+    const uint32_t t = rem % 100;
+    const OrdinalStem* stem = nullptr;
+    if (t == 0) {
+      stem = &kRuOrdinalHundreds[rem / 100];
+    } else {
+      AppendWord(kRuHundreds[rem / 100], out);
+      if (t < 10) {
+        stem = &kRuOrdinalUnits[t];
+      } else if (t < 20) {
+        stem = &kRuOrdinalTeens[t - 10];
+      } else if (t % 10 == 0) {
+        stem = &kRuOrdinalTens[t / 10];
+      } else {
+        AppendWord(kRuTens[t / 10], out);
+        stem = &kRuOrdinalUnits[t % 10];
+      }
+    }
+    AppendRuOrdinalWord({}, *stem, form, out);
+    return true;
+  }
+  for (size_t i = ArraySize(kRuScales); i-- > 0;) {
+    const RuScale& scale = kRuScales[i];
+    const uint64_t k = n / scale.value % 1000;
+    if (k == 0) continue;
+    if (k > 9) return false;
+    const uint64_t high = n - k * scale.value;
+    if (high > 0) AppendRuCardinal(high, Gender::kMasc, out);
+    AppendRuOrdinalWord(kRuGenitivePrefix[k], {scale.ordinal_stem, StemClass::kHard},
+                        form, out);
+    return true;
+  }
+  return false;
+}
+
+// "3,14" -> "три целых четырнадцать сотых"；超过三位小数时逐位读
+void AppendRuDecimal(uint64_t value, std::string_view frac, std::string* out) {
+  AppendRuCardinal(value, Gender::kFem, out);
+  AppendWord(RuPluralIndex(value) == 0 ? "целая" : "целых", out);
+  if (frac.size() > 3) {
+    for (char c : frac) AppendWord(kRuUnits[0][c - '0'], out);
+    return;
+  }
+  const uint64_t f = ParseDigits(frac);
+  AppendRuCardinal(f, Gender::kFem, out);
+  AppendWord(kRuFractionNames[frac.size() - 1][RuPluralIndex(f) == 0 ? 0 : 1],
+             out);
+}
+
+// 1..999，美式读法（不加 "and"）
+void AppendEnTriple(uint32_t n, std::string* out) {
+  if (n >= 100) {
+    AppendWord(kEnOnes[n / 100], out);
+    AppendWord("hundred", out);
+    n %= 100;
+  }
+  if (n == 0) return;
+  if (n < 20) {
+    AppendWord(kEnOnes[n], out);
+    return;
+  }
+  std::string word = kEnTens[n / 10];
+  if (n % 10 != 0) {
+    word += '-';
+    word += kEnOnes[n % 10];
+  }
+  AppendWord(word, out);
+}
+
+void AppendEnCardinal(uint64_t n, std::string* out) {
+  if (n == 0) {
+    AppendWord(kEnOnes[0], out);
+    return;
+  }
+  for (const EnScale& scale : kEnScales) {
+    const uint64_t k = n / scale.value;
+    if (k == 0) continue;
+    AppendEnTriple(static_cast<uint32_t>(k), out);
+    AppendWord(scale.name, out);
+    n %= scale.value;
+  }
+  if (n > 0) AppendEnTriple(static_cast<uint32_t>(n), out);
+}
+
+// 基数词的最后一个词（连字符后的部分）改为序数
+void AppendEnOrdinal(uint64_t n, std::string* out) {
+  const size_t start = out->size();
+  AppendEnCardinal(n, out);
+  size_t last = out->find_last_of(" -");
+  last = (last == std::string::npos || last < start) ? start : last + 1;
+  std::string word = out->substr(last);
+  out->resize(last);
+  bool irregular = false;
+  for (const EnIrregularOrdinal& rule : kEnIrregularOrdinals) {
+    if (word == rule.cardinal) {
+      word = rule.ordinal;
+      irregular = true;
+      break;
+    }
+  }
+  if (!irregular) {
+    if (word.back() == 'y') {
+      word.pop_back();
+      word += "ieth";
+    } else {
+      word += "th";
+    }
+  }
+  out->append(word);
+}
+
+// 年份两位一读："2026" -> "twenty twenty-six"，"1905" -> "nineteen oh five"；
+// 2000..2009 之类按基数读
+void AppendEnYear(uint64_t n, std::string* out) {
+  if (n < 1000 || n > 9999 || n % 1000 < 10) {
+    AppendEnCardinal(n, out);
+    return;
+  }
+  AppendEnCardinal(n / 100, out);
+  const uint32_t r = static_cast<uint32_t>(n % 100);
+  if (r == 0) {
+    AppendWord("hundred", out);
+  } else if (r < 10) {
+    AppendWord("oh", out);
+    AppendWord(kEnOnes[r], out);
+  } else {
+    AppendEnTriple(r, out);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 扫描
+// ---------------------------------------------------------------------------
+
+inline bool IsAsciiDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool IsContinuation(char c) {
+  return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// 字母与数字；单位 / 货币等符号虽属 So / Sc 类，也不算词内字符（"№5"、"5°"）
+bool IsWordChar(char32_t cp) {
+  if (cp < 0x80) {
+    return (cp >= '0' && cp <= '9') || ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z');
+  }
+  switch (cp) {
+    case 0x00A3:  // £
+    case 0x00A7:  // §
+    case 0x00B0:  // °
+    case 0x20AC:  // €
+    case 0x20BD:  // ₽
+    case 0x2116:  // №
+      return false;
+    default:
+      return ClassifyCodepoint(cp) == CharClass::kOther;
+  }
+}
+
+inline bool IsUpperLetter(char32_t cp) {
+  return (cp >= 'A' && cp <= 'Z') || (cp >= 0x0410 && cp <= 0x042F) ||
+         cp == 0x0401;
+}
+
+struct NumberToken {
+  std::string digits;     // 整数部分（已去掉分组符）
+  std::string_view frac;  // 小数部分，无则为空
+  size_t end = 0;
+};
+
+class Normalizer {
+ public:
+  Normalizer(std::string_view text, NormalizeLanguage language,
+             std::string* out)
+      : text_(text), russian_(language == NormalizeLanguage::kRussian),
+        out_(out) {}
+
+  size_t Run() {
+    out_->clear();
+    out_->reserve(text_.size() + text_.size() / 4);
+    size_t count = 0;
+    std::string exp;
+    for (size_t pos = 0; pos < text_.size();) {
+      size_t end = 0;
+      exp.clear();
+      if (MayStartRule(text_[pos]) && AtWordStart(pos)) {
+        if (TryExpand(pos, &exp, &end)) {
+          Emit(exp, end);
+          ++count;
+          pos = end;
+          continue;
+        }
+        if (StartsNumber(pos)) {
+          // 数字开头的词没有整体匹配任何规则（"10:30pm"、"5'11"、"123-45"）：整词原样保留，
+          // 不把其中的数字片段单独展开
+          end = TokenEnd(pos);
+          out_->append(text_.data() + pos, end - pos);
+          pos = end;
+          continue;
+        }
+      }
+      char32_t cp;
+      const size_t len = DecodeUtf8(text_, pos, &cp);
+      out_->append(text_.data() + pos, len);
+      pos += len;
+    }
+    return count;
+  }
+
+ private:
+  char CharAt(size_t pos) const { return pos < text_.size() ? text_[pos] : '\0'; }
+
+  bool IsDigitAt(size_t pos) const { return IsAsciiDigit(CharAt(pos)); }
+
+  bool IsWordCharAt(size_t pos) const {
+    char32_t cp;
+    return DecodeUtf8(text_, pos, &cp) > 0 && IsWordChar(cp);
+  }
+
+  bool MatchAt(size_t pos, std::string_view s) const {
+    return text_.compare(pos, s.size(), s) == 0;
+  }
+
+  size_t ScanDigits(size_t pos) const {
+    size_t n = 0;
+    while (IsDigitAt(pos + n)) ++n;
+    return n;
+  }
+
+  // 数字、符号与字母才可能触发规则；空白与 ASCII 标点直接复制
+  static bool MayStartRule(char c) {
+    const unsigned char u = static_cast<unsigned char>(c);
+    return u >= 0x80 || IsAsciiDigit(c) || ((u | 0x20) >= 'a' && (u | 0x20) <= 'z') ||
+           c == '-' || c == '+' || c == '(' || c == '$' || c == '%' || c == '&';
+  }
+
+  // pos 之前一个字符的起始位置（pos > 0）
+  size_t PrevCharStart(size_t pos) const {
+    size_t p = pos - 1;
+    while (p > 0 && IsContinuation(text_[p])) --p;
+    return p;
+  }
+
+  bool AtWordStart(size_t pos) const {
+    return pos == 0 || !IsWordCharAt(PrevCharStart(pos));
+  }
+
+  static bool IsSpaceChar(char32_t cp) {
+    return cp == ' ' || cp == '\t' || cp == '\n' || cp == '\r' || cp == 0x00A0 ||
+           cp == 0x202F;
+  }
+
+  // 词之间以空白分隔；词内的标点两侧都是字母 / 数字时不断开（"10:30pm"、"v1.2.3"、"123-45-67"）。
+  // 数字规则只对整词生效：起点须是词首，终点须是词尾。
+  bool GluedAt(size_t pos) const {
+    char32_t cp;
+    const size_t len = DecodeUtf8(text_, pos, &cp);
+    if (len == 0 || IsSpaceChar(cp)) return false;
+    return IsWordChar(cp) || IsWordCharAt(pos + len);
+  }
+
+  // pos 处（前一个字符不是字母 / 数字）是否在词中间，即前面是被标点粘连的字母 / 数字
+  bool InsideToken(size_t pos) const {
+    if (pos == 0) return false;
+    const size_t p = PrevCharStart(pos);
+    char32_t cp;
+    DecodeUtf8(text_, p, &cp);
+    return !IsSpaceChar(cp) && p > 0 && IsWordCharAt(PrevCharStart(p));
+  }
+
+  size_t TokenEnd(size_t pos) const {
+    char32_t cp;
+    for (size_t len = 0; (len = DecodeUtf8(text_, pos, &cp)) > 0; pos += len) {
+      if (!IsWordChar(cp) && !GluedAt(pos)) break;
+    }
+    return pos;
+  }
+
+  bool StartsNumber(size_t pos) const {
+    if (IsDigitAt(pos)) return true;
+    if (text_[pos] == '-' || text_[pos] == '+') return IsDigitAt(pos + 1);
+    return MatchAt(pos, "\xE2\x88\x92") && IsDigitAt(pos + 3);
+  }
+
+  // start 之前的一个词（折叠为小写），用于按前置词定格；没有时返回空
+  std::string PrecedingWord(size_t start) const {
+    size_t e = start;
+    while (e > 0 && text_[e - 1] == ' ') --e;
+    size_t b = e;
+    while (b > 0 && IsWordCharAt(PrevCharStart(b))) b = PrevCharStart(b);
+    std::string word;
+    AppendFoldedText(text_.substr(b, e - b), &word);
+    return word;
+  }
+
+  // 数字与单位之间至多一个（不换行）空格
+  size_t SkipSpace(size_t pos) const {
+    if (CharAt(pos) == ' ') return pos + 1;
+    if (MatchAt(pos, "\xC2\xA0")) return pos + 2;      // U+00A0
+    if (MatchAt(pos, "\xE2\x80\xAF")) return pos + 3;  // U+202F
+    return pos;
+  }
+
+  // pos 紧跟在被吃掉的缩写点之后：该点是否同时是句末（文本结束，或空白后接大写字母）
+  bool DotEndsSentence(size_t pos) const {
+    if (pos >= text_.size()) return true;
+    const char c = text_[pos];
+    if (c != ' ' && c != '\n' && c != '\t' && c != '\r') return false;
+    while (pos < text_.size() && (text_[pos] == ' ' || text_[pos] == '\n' ||
+                                  text_[pos] == '\t' || text_[pos] == '\r')) {
+      ++pos;
+    }
+    char32_t cp;
+    return DecodeUtf8(text_, pos, &cp) == 0 || IsUpperLetter(cp);
+  }
+
+  // 展开结果与前后的词之间补空格（"5км" -> "пять километров"，"№5" -> "номер пять"）
+  void Emit(const std::string& exp, size_t end) {
+    if (!out_->empty()) {
+      size_t p = out_->size() - 1;
+      while (p > 0 && IsContinuation((*out_)[p])) --p;
+      char32_t cp;
+      DecodeUtf8(*out_, p, &cp);
+      if (IsWordChar(cp)) out_->push_back(' ');
+    }
+    out_->append(exp);
+    if (IsWordCharAt(end)) out_->push_back(' ');
+  }
+
+  bool TryExpand(size_t pos, std::string* exp, size_t* end) {
+    if (StartsNumber(pos)) {
+      return !InsideToken(pos) && TryNumber(pos, exp, end) && !GluedAt(*end);
+    }
+    if (text_[pos] == '(') return TryPhone(pos, exp, end) && !GluedAt(*end);
+    return TryCurrencyPrefix(pos, exp, end) || TryAbbreviation(pos, exp, end) ||
+           TrySymbol(pos, exp, end);
+  }
+
+  void AppendCardinal(uint64_t n, Gender gender, std::string* exp) const {
+    if (russian_) {
+      AppendRuCardinal(n, gender, exp);
+    } else {
+      AppendEnCardinal(n, exp);
+    }
+  }
+
+  void AppendDigits(std::string_view digits, std::string* exp) const {
+    for (char c : digits) {
+      AppendWord(russian_ ? kRuUnits[0][c - '0'] : kEnOnes[c - '0'], exp);
+    }
+  }
+
+  // 整数部分可带千位分组（俄语空格 / 不换行空格，英语逗号），小数点俄语为 "," 或 "."。
+  // "1.2.3"、"192.168.0.1" 之类的点分串不按小数读（之后整词因不匹配任何规则而原样保留）。
+  void ScanNumber(size_t pos, NumberToken* num) const {
+    size_t n = ScanDigits(pos);
+    num->digits.assign(text_.data() + pos, n);
+    pos += n;
+    if (n <= 3) {
+      for (;;) {
+        size_t sep = 0;
+        if (russian_ ? CharAt(pos) == ' ' : CharAt(pos) == ',') {
+          sep = 1;
+        } else if (MatchAt(pos, "\xC2\xA0")) {
+          sep = 2;
+        } else if (MatchAt(pos, "\xE2\x80\xAF")) {
+          sep = 3;
+        }
+        if (sep == 0 || ScanDigits(pos + sep) != 3) break;
+        num->digits.append(text_.data() + pos + sep, 3);
+        pos += sep + 3;
+      }
+    }
+    const char c = CharAt(pos);
+    if (c == '.' || (russian_ && c == ',')) {
+      const size_t f = ScanDigits(pos + 1);
+      const size_t q = pos + 1 + f;
+      const bool chain =
+          (CharAt(q) == '.' || CharAt(q) == ',') && IsDigitAt(q + 1);
+      if (f > 0 && !chain) {
+        num->frac = text_.substr(pos + 1, f);
+        pos = q;
+      }
+    }
+    num->end = pos;
+  }
+
+  bool TryNumber(size_t pos, std::string* exp, size_t* end) {
+    size_t p = pos;
+    const char* sign = nullptr;
+    if (text_[p] == '-' || text_[p] == '+') {
+      sign = text_[p] == '-' ? (russian_ ? "минус" : "minus")
+                             : (russian_ ? "плюс" : "plus");
+      ++p;
+    } else if (MatchAt(p, "\xE2\x88\x92")) {  // U+2212
+      sign = russian_ ? "минус" : "minus";
+      p += 3;
+    }
+    if (!IsDigitAt(p)) return false;
+    if (!sign && (TryDate(p, exp, end) || TryTime(p, exp, end))) return true;
+    if (text_[pos] != '-' && TryPhone(pos, exp, end)) return true;
+
+    NumberToken num;
+    ScanNumber(p, &num);
+    const size_t q = num.end;
+    if (sign) AppendWord(sign, exp);
+    if (num.digits.size() > kMaxNumberDigits ||
+        (num.digits.size() > 1 && num.digits[0] == '0')) {
+      // 过长或有前导零（编号、电话）：逐位读
+      if (IsWordCharAt(q)) return false;
+      AppendDigits(num.digits, exp);
+      if (!num.frac.empty()) {
+        AppendWord(russian_ ? "запятая" : "point", exp);
+        AppendDigits(num.frac, exp);
+      }
+      *end = q;
+      return true;
+    }
+    const uint64_t value = ParseDigits(num.digits);
+    if (!sign && num.frac.empty()) {
+      if (TryOrdinalSuffix(value, q, exp, end)) return true;
+      if (!russian_ && TryEnMeridiem(num, value, q, exp, end)) return true;
+      if (russian_ && (TryRuYear(num, value, q, exp, end) ||
+                       TryRuYearRange(num, value, p, exp, end) ||
+                       TryRuDayOfMonth(value, q, exp, end))) {
+        return true;
+      }
+      if (TryRange(value, q, exp, end)) return true;
+    }
+    size_t unit_end = 0;
+    bool sentence_dot = false;
+    const UnitRule* unit = MatchUnit(q, &unit_end, &sentence_dot);
+    if (!unit && IsWordCharAt(q)) return false;  // "5G"、"3D"
+    AppendAmount(num, value, unit, exp);
+    if (sentence_dot) exp->push_back('.');
+    *end = unit ? unit_end : q;
+    return true;
+  }
+
+  bool TryOrdinalSuffix(uint64_t value, size_t pos, std::string* exp,
+                        size_t* end) const {
+    if (russian_) {
+      if (CharAt(pos) != '-') return false;
+      for (const RuOrdinalSuffix& suffix : kRuOrdinalSuffixes) {
+        const std::string_view s = suffix.text;
+        if (!MatchAt(pos + 1, s) || IsWordCharAt(pos + 1 + s.size())) continue;
+        // 以 0 结尾的数后的 "-е" 多为年代（"в 1990-е годы"、"20-е"），读复数
+        const OrdinalForm form = s == "е" && value % 10 == 0 ? OrdinalForm::kPluralNom
+                                                              : suffix.form;
+        if (!AppendRuOrdinal(value, form, exp)) {
+          AppendRuCardinal(value, Gender::kMasc, exp);
+        }
+        *end = pos + 1 + s.size();
+        return true;
+      }
+      return false;
+    }
+    // "1st"、"22nd"、"3RD"：不校验后缀与数字是否匹配
+    const char a = static_cast<char>(CharAt(pos) | 0x20);
+    const char b = static_cast<char>(CharAt(pos + 1) | 0x20);
+    const bool suffix = (a == 's' && b == 't') || (a == 'n' && b == 'd') ||
+                        (a == 'r' && b == 'd') || (a == 't' && b == 'h');
+    if (!suffix || IsWordCharAt(pos + 2)) return false;
+    AppendEnOrdinal(value, exp);
+    *end = pos + 2;
+    return true;
+  }
+
+  // "2026 году" / "2026 г."：四位数后跟 "год" 的某个格时按序数读
+  bool TryRuYear(const NumberToken& num, uint64_t value, size_t pos,
+                 std::string* exp, size_t* end) const {
+    if (num.digits.size() != 4 || value < 1000) return false;
+    const size_t p = SkipSpace(pos);
+    for (const RuYearWord& word : kRuYearWords) {
+      const std::string_view s = word.text;
+      if (!MatchAt(p, s)) continue;
+      const size_t e = p + s.size();
+      if (!word.expansion && IsWordCharAt(e)) continue;
+      AppendRuOrdinal(value, word.form, exp);
+      if (word.expansion) {
+        AppendWord(word.expansion, exp);
+        if (DotEndsSentence(e)) exp->push_back('.');
+        *end = e;
+      } else {
+        *end = pos;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // 区间的连接符："5-7"（连字符两侧不留空格）或 "1990 – 2000"（短 / 长破折号，可各隔一个空格）。
+  // 返回第二个数的起点，不是区间时返回 0。
+  size_t MatchRangeDash(size_t pos) const {
+    if (CharAt(pos) == '-') return IsDigitAt(pos + 1) ? pos + 1 : 0;
+    const size_t p = SkipSpace(pos);
+    if (!MatchAt(p, "\xE2\x80\x93") && !MatchAt(p, "\xE2\x80\x94")) return 0;  // – —
+    const size_t q = SkipSpace(p + 3);
+    return IsDigitAt(q) ? q : 0;
+  }
+
+  // "1990–2000 гг."、"с 1990 по 2000 год"：年份区间，两个年份都按序数读。
+  // 破折号区间两个年份同格（"гг." 的格由区间前的前置词决定）；"с X по Y" 中 X 为属格、Y 为宾格。
+  bool TryRuYearRange(const NumberToken& num, uint64_t value, size_t start,
+                      std::string* exp, size_t* end) const {
+    if (num.digits.size() != 4 || value < 1000) return false;
+    const std::string preposition = PrecedingWord(start);
+    size_t p = MatchRangeDash(num.end);
+    const bool from_to = p == 0;
+    if (from_to) {
+      const std::string_view po = "по";
+      const size_t s = SkipSpace(num.end);
+      if (s == num.end || !MatchAt(s, po) || (preposition != "с" && preposition != "со")) {
+        return false;
+      }
+      p = SkipSpace(s + po.size());
+      if (p == s + po.size()) return false;
+    }
+    if (ScanDigits(p) != 4) return false;
+    const uint64_t to = ParseDigits(text_.substr(p, 4));
+    if (to < 1000) return false;
+    const size_t w = SkipSpace(p + 4);
+    for (const RuYearWord& word : kRuYearWords) {
+      const std::string_view s = word.text;
+      if (!MatchAt(w, s)) continue;
+      const size_t e = w + s.size();
+      if (!word.expansion && IsWordCharAt(e)) continue;
+      OrdinalForm form = word.range_form;
+      const char* years = word.expansion;
+      if (s == "гг.") {
+        years = "годы";
+        if (!from_to) {
+          for (const RuYearRangeCase& c : kRuYearRangeCases) {
+            if (preposition != c.preposition) continue;
+            form = c.form;
+            years = c.years;
+            break;
+          }
+        }
+      }
+      AppendRuOrdinal(value, from_to ? OrdinalForm::kMascGen : form, exp);
+      if (from_to) {
+        AppendWord("по", exp);
+        AppendRuOrdinal(to, form, exp);
+      } else {
+        std::string tail;
+        AppendRuOrdinal(to, form, &tail);
+        exp->push_back('-');
+        exp->append(tail);
+      }
+      if (years) {
+        AppendWord(years, exp);
+        if (DotEndsSentence(e)) exp->push_back('.');
+        *end = e;
+      } else {
+        *end = p + 4;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // "5-7 лет"、"1–2 т"、"5-7 km"：数量区间，单位随第二个数变格；俄语以连字符相连，英语读作 "to"
+  bool TryRange(uint64_t value, size_t pos, std::string* exp, size_t* end) const {
+    const size_t p = MatchRangeDash(pos);
+    if (p == 0) return false;
+    NumberToken to;
+    ScanNumber(p, &to);
+    if (!to.frac.empty() || to.digits.size() > kMaxNumberDigits ||
+        (to.digits.size() > 1 && to.digits[0] == '0')) {
+      return false;
+    }
+    size_t unit_end = 0;
+    bool sentence_dot = false;
+    const UnitRule* unit = MatchUnit(to.end, &unit_end, &sentence_dot);
+    if (!unit && IsWordCharAt(to.end)) return false;
+    std::string tail;
+    if (!russian_ && !unit && to.digits.size() == 4 && value >= 1000 && value <= 9999) {
+      AppendEnYear(value, exp);  // "1990-2000" -> "nineteen ninety to two thousand"
+      AppendEnYear(ParseDigits(to.digits), &tail);
+    } else {
+      AppendCardinal(value, unit ? unit->gender : Gender::kMasc, exp);
+      AppendAmount(to, ParseDigits(to.digits), unit, &tail);
+    }
+    if (russian_) {
+      exp->push_back('-');
+      exp->append(tail);
+    } else {
+      AppendWord("to", exp);
+      AppendWord(tail, exp);
+    }
+    if (sentence_dot) exp->push_back('.');
+    *end = unit ? unit_end : to.end;
+    return true;
+  }
+
+  // 电话号码的一组数字：英语逐位读；俄语按基数读，有前导零或超过三位时逐位读
+  void AppendPhoneGroup(std::string_view digits, std::string* exp) const {
+    if (!russian_ || digits.size() > 3 || (digits.size() > 1 && digits[0] == '0')) {
+      AppendDigits(digits, exp);
+    } else {
+      AppendRuCardinal(ParseDigits(digits), Gender::kMasc, exp);
+    }
+  }
+
+  // 电话号码："+7 (999) 123-45-67"、"8 (800) 555-35-35"、"555-123-4567"。
+  // 有国家码或区号时本地号码可用空格或连字符分组；两者都没有时须至少两个连字符
+  // （英语另认 "555-1234"），以免与 "5-7" 之类的区间混淆。
+  bool TryPhone(size_t pos, std::string* exp, size_t* end) const {
+    constexpr size_t kMaxGroups = 8;
+    std::string_view groups[kMaxGroups];
+    size_t num_groups = 0;
+    bool plus = false;
+    bool prefixed = false;
+    size_t p = pos;
+    size_t n = 0;
+    if (CharAt(p) == '+') {
+      n = ScanDigits(p + 1);
+      if (n < 1 || n > 3) return false;
+      plus = prefixed = true;
+      groups[num_groups++] = text_.substr(p + 1, n);
+      p = SkipSpace(p + 1 + n);
+    } else if ((n = ScanDigits(p)) >= 1 && n <= 3 && SkipSpace(p + n) != p + n &&
+               CharAt(SkipSpace(p + n)) == '(') {
+      prefixed = true;
+      groups[num_groups++] = text_.substr(p, n);
+      p = SkipSpace(p + n);
+    }
+    if (CharAt(p) == '(') {
+      n = ScanDigits(p + 1);
+      if (n < 3 || n > 5 || CharAt(p + 1 + n) != ')') return false;
+      prefixed = true;
+      groups[num_groups++] = text_.substr(p + 1, n);
+      p = SkipSpace(p + 2 + n);
+    }
+    const size_t local = num_groups;
+    n = ScanDigits(p);
+    if (n < 1 || n > 4) return false;
+    groups[num_groups++] = text_.substr(p, n);
+    p += n;
+    size_t hyphens = 0;
+    size_t digits = 0;
+    for (size_t i = 0; i < num_groups; ++i) digits += groups[i].size();
+    while (num_groups < kMaxGroups) {
+      const char sep = CharAt(p);
+      if (sep != '-' && !(prefixed && sep == ' ')) break;
+      n = ScanDigits(p + 1);
+      if (n < 2 || n > 4) break;
+      groups[num_groups++] = text_.substr(p + 1, n);
+      hyphens += sep == '-';
+      digits += n;
+      p += 1 + n;
+    }
+    if (IsWordCharAt(p) || (CharAt(p) == '-' && IsDigitAt(p + 1)) || digits > 15) {
+      return false;
+    }
+    const size_t num_local = num_groups - local;
+    bool ok = false;
+    if (prefixed) {
+      ok = num_local >= 2 || groups[local].size() >= 4;
+    } else {
+      ok = hyphens >= 2 || (!russian_ && num_local == 2 && groups[local].size() == 3 &&
+                            groups[local + 1].size() == 4);
+    }
+    if (!ok) return false;
+    if (plus) AppendWord(russian_ ? "плюс" : "plus", exp);
+    for (size_t i = 0; i < num_groups; ++i) AppendPhoneGroup(groups[i], exp);
+    *end = p;
+    return true;
+  }
+
+  // 12 小时制后缀 "am" / "pm" / "a.m." / "p.m."（可隔一个空格，不区分大小写）
+  bool MatchMeridiem(size_t pos, bool* pm, size_t* end, bool* sentence_dot) const {
+    const size_t p = SkipSpace(pos);
+    const char a = static_cast<char>(CharAt(p) | 0x20);
+    if (a != 'a' && a != 'p') return false;
+    *pm = a == 'p';
+    *sentence_dot = false;
+    if ((CharAt(p + 1) | 0x20) == 'm' && !IsWordCharAt(p + 2)) {
+      *end = p + 2;
+      return true;
+    }
+    if (CharAt(p + 1) == '.' && (CharAt(p + 2) | 0x20) == 'm' && CharAt(p + 3) == '.') {
+      *end = p + 4;
+      *sentence_dot = DotEndsSentence(*end);
+      return true;
+    }
+    return false;
+  }
+
+  // 按字母读（"ay em"、"pee em"），单字母 "a" 在词典中是冠词的读音
+  static void AppendMeridiem(bool pm, bool sentence_dot, std::string* exp) {
+    AppendWord(pm ? "pee" : "ay", exp);
+    AppendWord("em", exp);
+    if (sentence_dot) exp->push_back('.');
+  }
+
+  // "7am"、"10 p.m."：整点
+  bool TryEnMeridiem(const NumberToken& num, uint64_t value, size_t pos,
+                     std::string* exp, size_t* end) const {
+    bool pm = false;
+    bool sentence_dot = false;
+    if (num.digits.size() > 2 || value < 1 || value > 12 ||
+        !MatchMeridiem(pos, &pm, end, &sentence_dot)) {
+      return false;
+    }
+    AppendEnCardinal(value, exp);
+    AppendMeridiem(pm, sentence_dot, exp);
+    return true;
+  }
+
+  // "19 октября"：日期按中性主格序数读
+  bool TryRuDayOfMonth(uint64_t value, size_t pos, std::string* exp,
+                       size_t* end) const {
+    if (value < 1 || value > 31) return false;
+    const size_t p = SkipSpace(pos);
+    if (p == pos) return false;
+    for (const char* month : kRuMonthsGenitive) {
+      const std::string_view s = month;
+      if (!MatchAt(p, s) || IsWordCharAt(p + s.size())) continue;
+      AppendRuOrdinal(value, OrdinalForm::kNeutNom, exp);
+      *end = pos;
+      return true;
+    }
+    return false;
+  }
+
+  // 俄语 dd.mm.yyyy，英语 mm/dd/yyyy，两者都认 ISO yyyy-mm-dd
+  bool TryDate(size_t pos, std::string* exp, size_t* end) const {
+    const size_t d1 = ScanDigits(pos);
+    if (d1 == 4 && CharAt(pos + 4) == '-' && ScanDigits(pos + 5) == 2 &&
+        CharAt(pos + 7) == '-' && ScanDigits(pos + 8) == 2 &&
+        !IsWordCharAt(pos + 10)) {
+      return AppendDate(ParseDigits(text_.substr(pos + 8, 2)),
+                        ParseDigits(text_.substr(pos + 5, 2)),
+                        ParseDigits(text_.substr(pos, 4)), pos + 10, exp, end);
+    }
+    if (d1 < 1 || d1 > 2) return false;
+    const char sep = russian_ ? '.' : '/';
+    size_t p = pos + d1;
+    if (CharAt(p) != sep) return false;
+    const size_t d2 = ScanDigits(p + 1);
+    if (d2 < 1 || d2 > 2 || CharAt(p + 1 + d2) != sep) return false;
+    const size_t y = p + 2 + d2;
+    if (ScanDigits(y) != 4) return false;
+    const size_t e = y + 4;
+    if (IsWordCharAt(e) || (CharAt(e) == sep && IsDigitAt(e + 1))) return false;
+    const uint64_t a = ParseDigits(text_.substr(pos, d1));
+    const uint64_t b = ParseDigits(text_.substr(p + 1, d2));
+    const uint64_t year = ParseDigits(text_.substr(y, 4));
+    return russian_ ? AppendDate(a, b, year, e, exp, end)
+                    : AppendDate(b, a, year, e, exp, end);
+  }
+
+  bool AppendDate(uint64_t day, uint64_t month, uint64_t year, size_t pos,
+                  std::string* exp, size_t* end) const {
+    if (day < 1 || day > 31 || month < 1 || month > 12 || year == 0) {
+      return false;
+    }
+    *end = pos;
+    if (!russian_) {
+      AppendWord(kEnMonths[month - 1], exp);
+      AppendEnOrdinal(day, exp);
+      exp->push_back(',');
+      AppendEnYear(year, exp);
+      return true;
+    }
+    AppendRuOrdinal(day, OrdinalForm::kNeutNom, exp);
+    AppendWord(kRuMonthsGenitive[month - 1], exp);
+    AppendRuOrdinal(year, OrdinalForm::kMascGen, exp);
+    AppendWord("года", exp);
+    const size_t p = SkipSpace(pos);
+    if (MatchAt(p, "г.")) {  // "19.10.2026 г." 不重复读 "года"
+      *end = p + std::string_view("г.").size();
+      if (DotEndsSentence(*end)) exp->push_back('.');
+    }
+    return true;
+  }
+
+  // hh:mm（不含秒）；英语可带 am / pm（"10:30pm" -> "ten thirty pee em"）
+  bool TryTime(size_t pos, std::string* exp, size_t* end) const {
+    const size_t d1 = ScanDigits(pos);
+    if (d1 < 1 || d1 > 2 || CharAt(pos + d1) != ':' ||
+        ScanDigits(pos + d1 + 1) != 2) {
+      return false;
+    }
+    const size_t e = pos + d1 + 3;
+    const uint64_t h = ParseDigits(text_.substr(pos, d1));
+    const uint64_t m = ParseDigits(text_.substr(pos + d1 + 1, 2));
+    bool pm = false;
+    bool sentence_dot = false;
+    size_t meridiem_end = 0;
+    if (!russian_ && MatchMeridiem(e, &pm, &meridiem_end, &sentence_dot)) {
+      if (h < 1 || h > 12 || m > 59) return false;
+      AppendEnCardinal(h, exp);
+      if (m > 0 && m < 10) {
+        AppendWord("oh", exp);
+        AppendWord(kEnOnes[m], exp);
+      } else if (m >= 10) {
+        AppendEnTriple(static_cast<uint32_t>(m), exp);
+      }
+      AppendMeridiem(pm, sentence_dot, exp);
+      *end = meridiem_end;
+      return true;
+    }
+    if (IsWordCharAt(e) || (CharAt(e) == ':' && IsDigitAt(e + 1))) return false;
+    if (h > 24 || m > 59 || (h == 24 && m != 0)) return false;
+    if (russian_) {
+      AppendRuCardinal(h, Gender::kMasc, exp);
+      AppendWord(kRuHourForms[RuPluralIndex(h)], exp);
+      if (m > 0) {
+        AppendRuCardinal(m, Gender::kFem, exp);
+        AppendWord(kRuMinuteForms[RuPluralIndex(m)], exp);
+      }
+    } else {
+      AppendEnCardinal(h, exp);
+      if (m == 0) {
+        AppendWord("o'clock", exp);
+      } else if (m < 10) {
+        AppendWord("oh", exp);
+        AppendWord(kEnOnes[m], exp);
+      } else {
+        AppendEnTriple(static_cast<uint32_t>(m), exp);
+      }
+    }
+    *end = e;
+    return true;
+  }
+
+  const UnitRule* UnitRules(size_t* count) const {
+    if (russian_) {
+      *count = ArraySize(kRuUnitRules);
+      return kRuUnitRules;
+    }
+    *count = ArraySize(kEnUnitRules);
+    return kEnUnitRules;
+  }
+
+  // 数字后（可隔一个空格）的单位；单位后须是词界。
+  // "5 т.е." 中的 "т" 后紧跟 "." 与字母，不当作单位。
+  const UnitRule* MatchUnit(size_t pos, size_t* end, bool* sentence_dot) const {
+    const size_t p = SkipSpace(pos);
+    size_t count = 0;
+    const UnitRule* rules = UnitRules(&count);
+    for (size_t i = 0; i < count; ++i) {
+      const UnitRule& rule = rules[i];
+      const std::string_view s = rule.symbol;
+      if (!MatchAt(p, s)) continue;
+      size_t e = p + s.size();
+      if (IsWordCharAt(e)) continue;
+      if (CharAt(e) == '.') {
+        if (IsWordCharAt(e + 1)) continue;
+        if (rule.allow_dot) {
+          ++e;
+          *sentence_dot = DotEndsSentence(e);
+        }
+      }
+      *end = e;
+      return &rule;
+    }
+    return nullptr;
+  }
+
+  // 数量 + 单位，单位随数量变格；小数时俄语名词用单数属格（"1,5 км" -> "… километра"）
+  void AppendAmount(const NumberToken& num, uint64_t value, const UnitRule* unit,
+                    std::string* exp) const {
+    const bool minor =
+        unit && unit->minor[0] != nullptr && num.frac.size() == 2;
+    if (russian_) {
+      const Gender gender = unit ? unit->gender : Gender::kMasc;
+      if (!num.frac.empty() && !minor) {
+        AppendRuDecimal(value, num.frac, exp);
+        if (unit) AppendWord(unit->forms[1], exp);
+        return;
+      }
+      AppendRuCardinal(value, gender, exp);
+      if (unit) AppendWord(unit->forms[RuPluralIndex(value)], exp);
+      if (minor) {
+        const uint64_t m = ParseDigits(num.frac);
+        if (m > 0) {
+          AppendRuCardinal(m, unit->minor_gender, exp);
+          AppendWord(unit->minor[RuPluralIndex(m)], exp);
+        }
+      }
+      return;
+    }
+    AppendEnCardinal(value, exp);
+    if (!num.frac.empty() && !minor) {
+      AppendWord("point", exp);
+      AppendDigits(num.frac, exp);
+      if (unit) AppendWord(unit->forms[1], exp);
+      return;
+    }
+    if (unit) AppendWord(unit->forms[value == 1 ? 0 : 1], exp);
+    if (minor) {
+      const uint64_t m = ParseDigits(num.frac);
+      if (m > 0) {
+        AppendWord("and", exp);
+        AppendEnCardinal(m, exp);
+        AppendWord(unit->minor[m == 1 ? 0 : 1], exp);
+      }
+    }
+  }
+
+  // "$5"、"€ 10,50"：前置货币符号
+  bool TryCurrencyPrefix(size_t pos, std::string* exp, size_t* end) const {
+    size_t count = 0;
+    const UnitRule* rules = UnitRules(&count);
+    for (size_t i = 0; i < count; ++i) {
+      const UnitRule& rule = rules[i];
+      if (!rule.prefix || !MatchAt(pos, rule.symbol)) continue;
+      const size_t p = SkipSpace(pos + std::string_view(rule.symbol).size());
+      if (!IsDigitAt(p)) return false;
+      NumberToken num;
+      ScanNumber(p, &num);
+      if (num.digits.size() > kMaxNumberDigits || IsWordCharAt(num.end)) {
+        return false;
+      }
+      AppendAmount(num, ParseDigits(num.digits), &rule, exp);
+      *end = num.end;
+      return true;
+    }
+    return false;
+  }
+
+  bool TryAbbreviation(size_t pos, std::string* exp, size_t* end) const {
+    // 逐字符折叠（只认 ASCII / 基本西里尔字母，折叠后字节数不变），得到与 text_ 对齐的窗口
+    char folded[kMaxAbbreviationBytes];
+    size_t n = 0;
+    const size_t limit = std::min(kMaxAbbreviationBytes, text_.size() - pos);
+    while (n < limit) {
+      char32_t cp;
+      const size_t len = DecodeUtf8(text_, pos + n, &cp);
+      if (n + len > limit ||
+          !FoldTextFast(text_.substr(pos + n, len), folded + n)) {
+        break;
+      }
+      n += len;
+    }
+    const std::string_view window(folded, n);
+    const AbbreviationRule* rules = russian_ ? kRuAbbreviations : kEnAbbreviations;
+    const size_t count = russian_ ? ArraySize(kRuAbbreviations)
+                                  : ArraySize(kEnAbbreviations);
+    for (size_t r = 0; r < count; ++r) {
+      const AbbreviationRule& rule = rules[r];
+      size_t i = 0;
+      bool matched = true;
+      for (const char* p = rule.pattern; *p != '\0'; ++p) {
+        if (i >= window.size() || window[i] != *p) {
+          matched = false;
+          break;
+        }
+        ++i;
+        if (*p == '.' && p[1] != '\0' && i < window.size() && window[i] == ' ') {
+          ++i;
+        }
+      }
+      if (!matched) continue;
+      const bool dot = window[i - 1] == '.';
+      if (!dot && IsWordCharAt(pos + i)) continue;
+      AppendWord(rule.expansion, exp);
+      if (dot && rule.ends_sentence && DotEndsSentence(pos + i)) {
+        exp->push_back('.');
+      }
+      *end = pos + i;
+      return true;
+    }
+    return false;
+  }
+
+  bool TrySymbol(size_t pos, std::string* exp, size_t* end) const {
+    const char* word = nullptr;
+    size_t len = 0;
+    if (MatchAt(pos, "№")) {
+      word = russian_ ? "номер" : "number";
+      len = std::string_view("№").size();
+    } else if (MatchAt(pos, "§")) {
+      word = russian_ ? "параграф" : "section";
+      len = std::string_view("§").size();
+    } else if (text_[pos] == '%' || (text_[pos] == '&' && !IsWordCharAt(pos + 1))) {
+      // 单独的 "%"（"5%" 已在数字规则中处理）与两侧为词界的 "&"（"AT&T" 不改）
+      word = text_[pos] == '%' ? (russian_ ? "процент" : "percent")
+                               : (russian_ ? "и" : "and");
+      len = 1;
+    } else {
+      return false;
+    }
+    AppendWord(word, exp);
+    *end = pos + len;
+    return true;
+  }
+
+  std::string_view text_;
+  bool russian_;
+  std::string* out_;
+};
+
+}  // namespace
+
+NormalizeLanguage NormalizeLanguageFromVoice(std::string_view voice) {
+  auto is = [voice](std::string_view lang) {
+    return voice.substr(0, lang.size()) == lang &&
+           (voice.size() == lang.size() || voice[lang.size()] == '-' ||
+            voice[lang.size()] == '_');
+  };
+  if (is("ru")) return NormalizeLanguage::kRussian;
+  if (is("en")) return NormalizeLanguage::kEnglish;
+  return NormalizeLanguage::kNone;
+}
+
+size_t NormalizeText(std::string_view text, NormalizeLanguage language,
+                     std::string* out) {
+  if (language == NormalizeLanguage::kNone) {
+    out->assign(text.data(), text.size());
+    return 0;
+  }
+  return Normalizer(text, language, out).Run();
+}
+
+const char* NormalizeLanguageToString(NormalizeLanguage language) {
+  switch (language) {
+    case NormalizeLanguage::kNone:
+      return "none";
+    case NormalizeLanguage::kRussian:
+      return "ru";
+    case NormalizeLanguage::kEnglish:
+      return "en";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace sherpa_tts
@@ -0,0 +1,36 @@
+#ifndef SHERPA_TTS_TEXT_NORMALIZE_H_
+#define SHERPA_TTS_TEXT_NORMALIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sherpa_tts {
+
+enum class NormalizeLanguage : int32_t {
+  kNone = 0,  // 不改写
+  kRussian = 1,
+  kEnglish = 2,
+};
+
+// 按 voice（espeak 语音名，如 "ru"、"en-us"）选择规则表；其他语言返回 kNone。
+NormalizeLanguage NormalizeLanguageFromVoice(std::string_view voice);
+
+// 文本规范化（词典前端之前的一步）：把数字、小数、序数（"5-й"、"21st"）、日期、时间、
+// 度量单位 / 货币 / 百分号及常见缩写（"т.е."、"e.g."）展开为单词，使这些片段能在词典中命中，
+// 而不是让整句回退到 espeak。规则表编译在程序内，按文本单次扫描，不回溯。
+//
+// 规则只看局部上下文：俄语数词按主格读（"в 5 км" 读作 "в пять километров"），
+// 只有紧跟 "году"、"-м" 之类可判定的后缀（或年份区间前的前置词）时才变格。
+// 数字所在的整个词须整体匹配某条规则（日期、时间、电话、区间、单位等），否则整词原样保留，
+// 不会只展开其中一段（"10:30pm" 在俄语中、"v1.2.3" 不改写）。
+// 结果写入 *out（覆盖），返回改写的片段数；kNone 时原样复制并返回 0。
+size_t NormalizeText(std::string_view text, NormalizeLanguage language,
+                     std::string* out);
+
+const char* NormalizeLanguageToString(NormalizeLanguage language);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_TEXT_NORMALIZE_H_
@@ -0,0 +1,150 @@
+#include "text_segment.h"
+
+namespace sherpa_tts {
+
+namespace {
+
+#include "text_segment_table.inc"
+
+inline CharClass Classify(char32_t cp) {
+  if (cp >= kCharClassLimit) return CharClass::kOther;
+  const uint8_t* block = kCharClassStage2[kCharClassStage1[cp >> 8]];
+  return static_cast<CharClass>((block[(cp & 0xFF) >> 2] >> ((cp & 3) * 2)) & 3);
+}
+
+inline bool IsContinuation(unsigned char c) { return (c & 0xC0) == 0x80; }
+
+// 全角终止符之后不要求空白（中日文句间通常不加空格）
+inline bool IsWideSentenceEnd(char32_t cp) {
+  return cp == 0x3002 || cp == 0xFF01 || cp == 0xFF1F;
+}
+
+inline bool IsSentenceEnd(char32_t cp) {
+  return cp == '.' || cp == '!' || cp == '?' || cp == 0x2026 ||
+         IsWideSentenceEnd(cp);
+}
+
+// 可跟在句末终止符之后、仍属于本句的收尾符号
+inline bool IsClosingMark(char32_t cp) {
+  switch (cp) {
+    case '"':
+    case '\'':
+    case ')':
+    case ']':
+    case 0x00BB:  // »
+    case 0x2019:  // ’
+    case 0x201D:  // ”
+    case 0x300D:  // 」
+    case 0x300F:  // 』
+    case 0xFF09:  // ）
+      return true;
+    default:
+      return false;
+  }
+}
+
+void PushTrimmed(std::string_view s, std::vector<std::string_view>* out) {
+  const char* ws = " \t\n\r\f\v";
+  size_t b = s.find_first_not_of(ws);
+  if (b == std::string_view::npos) return;
+  size_t e = s.find_last_not_of(ws);
+  out->push_back(s.substr(b, e + 1 - b));
+}
+
+}  // namespace
+
+size_t DecodeUtf8(std::string_view s, size_t pos, char32_t* cp) {
+  if (pos >= s.size()) return 0;
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data()) + pos;
+  const size_t left = s.size() - pos;
+  const unsigned char c = p[0];
+  if (c < 0x80) {
+    *cp = c;
+    return 1;
+  }
+  if (c >= 0xC2 && c < 0xE0 && left >= 2 && IsContinuation(p[1])) {
+    *cp = (static_cast<char32_t>(c & 0x1F) << 6) | (p[1] & 0x3F);
+    return 2;
+  }
+  if (c >= 0xE0 && c < 0xF0 && left >= 3 && IsContinuation(p[1]) &&
+      IsContinuation(p[2])) {
+    *cp = (static_cast<char32_t>(c & 0x0F) << 12) |
+          (static_cast<char32_t>(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+    return 3;
+  }
+  if (c >= 0xF0 && c < 0xF5 && left >= 4 && IsContinuation(p[1]) &&
+      IsContinuation(p[2]) && IsContinuation(p[3])) {
+    *cp = (static_cast<char32_t>(c & 0x07) << 18) |
+          (static_cast<char32_t>(p[1] & 0x3F) << 12) |
+          (static_cast<char32_t>(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    return 4;
+  }
+  *cp = 0xFFFD;
+  return 1;
+}
+
+CharClass ClassifyCodepoint(char32_t cp) { return Classify(cp); }
+
+void SplitWords(std::string_view text, std::vector<std::string_view>* words) {
+  words->clear();
+  size_t word_begin = 0;
+  bool in_word = false;
+  for (size_t i = 0; i < text.size();) {
+    char32_t cp;
+    size_t clen = DecodeUtf8(text, i, &cp);
+    CharClass cls = Classify(cp);
+    if (cls == CharClass::kOther) {
+      if (!in_word) word_begin = i;
+      in_word = true;
+    } else {
+      if (in_word) words->push_back(text.substr(word_begin, i - word_begin));
+      in_word = false;
+      if (cls == CharClass::kPunct) words->push_back(text.substr(i, clen));
+    }
+    i += clen;
+  }
+  if (in_word) words->push_back(text.substr(word_begin));
+}
+
+void SplitSentences(std::string_view text,
+                    std::vector<std::string_view>* sentences) {
+  sentences->clear();
+  size_t begin = 0;
+  for (size_t i = 0; i < text.size();) {
+    char32_t cp;
+    size_t clen = DecodeUtf8(text, i, &cp);
+    i += clen;
+    if (!IsSentenceEnd(cp)) continue;
+    bool wide = IsWideSentenceEnd(cp);
+    while (i < text.size()) {
+      clen = DecodeUtf8(text, i, &cp);
+      if (!IsSentenceEnd(cp) && !IsClosingMark(cp)) break;
+      wide = wide || IsWideSentenceEnd(cp);
+      i += clen;
+    }
+    if (i < text.size() && !wide) {
+      DecodeUtf8(text, i, &cp);
+      if (Classify(cp) != CharClass::kSpace) continue;
+    }
+    PushTrimmed(text.substr(begin, i - begin), sentences);
+    begin = i;
+  }
+  if (begin < text.size()) PushTrimmed(text.substr(begin), sentences);
+}
+
+bool IsPunctuationSegment(std::string_view w) {
+  if (w.empty()) return true;
+  char32_t cp;
+  size_t clen = DecodeUtf8(w, 0, &cp);
+  return clen == w.size() && Classify(cp) == CharClass::kPunct;
+}
+
+bool IsPunctuationOnly(std::string_view text) {
+  char32_t cp;
+  for (size_t pos = 0, n = 0; (n = DecodeUtf8(text, pos, &cp)) > 0; pos += n) {
+    if (Classify(cp) == CharClass::kOther) return false;
+  }
+  return true;
+}
+
+}  // namespace sherpa_tts
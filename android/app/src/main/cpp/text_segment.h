@@ -0,0 +1,45 @@
+#ifndef SHERPA_TTS_TEXT_SEGMENT_H_
+#define SHERPA_TTS_TEXT_SEGMENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sherpa_tts {
+
+// 码点类别：空白（词间分隔）、标点（单独成段）、其余（词内字符）。
+enum class CharClass : uint8_t {
+  kOther = 0,
+  kSpace = 1,
+  kPunct = 2,
+};
+
+// 解码 s[pos] 处的一个 UTF-8 字符，返回占用字节数（pos 越界返回 0）。
+// 非法或截断的序列按 1 字节处理，码点记为 U+FFFD。
+size_t DecodeUtf8(std::string_view s, size_t pos, char32_t* cp);
+
+// 查两级分类表（由 ucd-tools 的 Unicode 类别生成，见 tools/gen_char_class_table.cpp）。
+// ASCII 与 C locale 的 isspace / ispunct 一致；非 ASCII 的 Z* 为空白，P* 为标点。
+CharClass ClassifyCodepoint(char32_t cp);
+
+// 按空白和标点切分（保留标点为单独片段），避免 "word," 导致 lexicon miss。
+// 只解码一次、不分配字符串；返回指向 text 的片段，调用方需保证 text 在使用期间有效。
+void SplitWords(std::string_view text, std::vector<std::string_view>* words);
+
+// 按句切分：句末为一串 . ! ? … 及全角 。！？（可带收尾的引号 / 括号），
+// 半角终止符须后接空白或位于结尾（"3.14"、"e.g" 不切）。去掉句首尾空白，不输出空句。
+// 返回指向 text 的片段。
+void SplitSentences(std::string_view text,
+                    std::vector<std::string_view>* sentences);
+
+// 判断片段是否为单个标点（TextToTokenIds 中跳过，不向模型输出）
+bool IsPunctuationSegment(std::string_view w);
+
+// 文本是否只由标点与空白组成（SplitWords 的每个片段都满足 IsPunctuationSegment），
+// 如单独成句的 "..."、"—"；逐句合成时这类句子读不出音，直接跳过
+bool IsPunctuationOnly(std::string_view text);
+
+}  // namespace sherpa_tts
+
+#endif  // SHERPA_TTS_TEXT_SEGMENT_H_
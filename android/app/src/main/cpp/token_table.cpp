@@ -1,24 +1,76 @@
 #include "token_table.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <sstream>
 
+#include "text_segment.h"
+
 namespace sherpa_tts {
 
 namespace {
 
+// 单码点符号进数组的上限：覆盖 BMP，数组最多 256KB；
+// 实际长度取最大单码点符号 + 1，IPA 音素表通常只有几十 KB。
+constexpr char32_t kMaxDenseCodepoint = 0xFFFF;
+
 void Trim(std::string* s) {
   const char* ws = " \t\n\r\f\v";
   s->erase(0, s->find_first_not_of(ws));
   s->erase(s->find_last_not_of(ws) + 1);
 }
 
+// symbol 恰为一个合法 UTF-8 码点时返回 true
+bool DecodeSingleCodepoint(std::string_view symbol, char32_t* cp) {
+  const size_t n = DecodeUtf8(symbol, 0, cp);
+  if (n == 0 || n != symbol.size()) return false;
+  return !(n == 1 && *cp == 0xFFFD);  // 非法字节被解码为 U+FFFD，长度 1
+}
+
+// FNV-1a：与平台 / 标准库无关，内置表的指纹可在生成时算好
+uint64_t HashSymbol(std::string_view s) {
+  uint64_t h = 0xCBF29CE484222325ull;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 0x100000001B3ull;
+  }
+  return h;
+}
+
+// 码点编码为 UTF-8，返回字节数（最多 4）
+size_t EncodeUtf8(char32_t cp, char* out) {
+  if (cp <= 0x7F) {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp <= 0x7FF) {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp <= 0xFFFF) {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  if (cp <= 0x10FFFF) {
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 4;
+  }
+  return 0;
+}
+
 }  // namespace
 
 bool TokenTable::LoadFromFile(const std::string& path) {
   std::ifstream is(path);
   if (!is) return false;
-  symbol_to_id_.clear();
+  Clear();
   std::string line;
   while (std::getline(is, line)) {
     Trim(&line);
@@ -34,19 +86,273 @@ bool TokenTable::LoadFromFile(const std::string& path) {
       iss >> id;
     }
     if (id < 0) continue;
-    symbol_to_id_[std::move(sym)] = id;
+    Add(sym, &id, 1);
+  }
+  return Finish();
+}
+
+void TokenTable::Clear() {
+  owned_dense_.clear();
+  multi_pool_.clear();
+  multi_ids_.clear();
+  pending_multi_.clear();
+  id_lists_.clear();
+  builtin_ = false;
+  builtin_multi_ = nullptr;
+  builtin_multi_size_ = 0;
+  has_multi_codepoint_ = false;
+  multi_first_.clear();
+  max_symbol_codepoints_ = 1;
+  max_ids_per_symbol_ = 1;
+  dense_ = nullptr;
+  dense_size_ = 0;
+  size_ = 0;
+  max_id_ = -1;
+  fingerprint_ = 0;
+}
+
+void TokenTable::Add(std::string_view symbol, const int64_t* ids, size_t num_ids) {
+  if (num_ids == 0 || ids[0] < 0) return;
+  if (num_ids > 1) {
+    id_lists_[std::string(symbol)].assign(ids, ids + num_ids);
+  } else if (!id_lists_.empty()) {
+    auto it = id_lists_.find(symbol);
+    if (it != id_lists_.end()) id_lists_.erase(it);
+  }
+  const int64_t id = ids[0];
+  char32_t cp = 0;
+  if (DecodeSingleCodepoint(symbol, &cp) && cp <= kMaxDenseCodepoint &&
+      id <= std::numeric_limits<int32_t>::max()) {
+    if (cp >= owned_dense_.size()) owned_dense_.resize(cp + 1, -1);
+    owned_dense_[cp] = static_cast<int32_t>(id);
+  } else {
+    pending_multi_[std::string(symbol)] = id;
+  }
+}
+
+bool TokenTable::Finish() {
+  // 指纹逐条求和，与加载顺序无关；只有一个 id 的条目与旧版本算法一致
+  auto add_fingerprint = [this](std::string_view sym, int64_t id) {
+    uint64_t mixed = static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull;
+    if (!id_lists_.empty()) {
+      auto it = id_lists_.find(sym);
+      if (it != id_lists_.end()) {
+        mixed = 0;
+        for (size_t i = 0; i < it->second.size(); ++i) {
+          mixed += static_cast<uint64_t>(it->second[i]) * 0x9E3779B97F4A7C15ull * (i + 1);
+          max_id_ = std::max(max_id_, it->second[i]);
+        }
+      }
+    }
+    fingerprint_ += (HashSymbol(sym) ^ mixed) * 0xBF58476D1CE4E5B9ull;
+    max_id_ = std::max(max_id_, id);
+    ++size_;
+  };
+  size_ = 0;
+  max_id_ = -1;
+  fingerprint_ = 0;
+  multi_first_.clear();
+  max_symbol_codepoints_ = 1;
+  max_ids_per_symbol_ = 1;
+  for (size_t cp = 0; cp < owned_dense_.size(); ++cp) {
+    if (owned_dense_[cp] < 0) continue;
+    char utf8[4];
+    const size_t n = EncodeUtf8(static_cast<char32_t>(cp), utf8);
+    add_fingerprint(std::string_view(utf8, n), owned_dense_[cp]);
+  }
+  size_t multi_bytes = 0;
+  for (const auto& kv : pending_multi_) {
+    add_fingerprint(kv.first, kv.second);
+    multi_bytes += kv.first.size();
+    char32_t cp = 0;
+    if (DecodeSingleCodepoint(kv.first, &cp)) {
+      has_multi_codepoint_ = true;
+    } else {
+      NoteMatchSymbol(kv.first);
+    }
+  }
+  fingerprint_ += size_;
+  for (const auto& kv : id_lists_) {
+    max_ids_per_symbol_ = std::max(max_ids_per_symbol_, kv.second.size());
+  }
+  FinishMatchSymbols();
+
+  // 一次分配好池再建表，保证键（string_view）不因扩容失效
+  multi_pool_.reserve(multi_bytes);
+  for (const auto& kv : pending_multi_) multi_pool_ += kv.first;
+  multi_ids_.reserve(pending_multi_.size());
+  size_t offset = 0;
+  for (const auto& kv : pending_multi_) {
+    multi_ids_.emplace(std::string_view(multi_pool_).substr(offset, kv.first.size()),
+                       kv.second);
+    offset += kv.first.size();
+  }
+  pending_multi_ = {};
+  dense_ = owned_dense_.data();
+  dense_size_ = owned_dense_.size();
+  return size_ != 0;
+}
+
+bool TokenTable::AppendIds(char32_t cp, std::vector<int64_t>* out) const {
+  const int64_t id = TryGetId(cp);
+  if (id < 0) return false;
+  if (id_lists_.empty()) {
+    out->push_back(id);
+    return true;
+  }
+  char utf8[4];
+  return AppendIds(std::string_view(utf8, EncodeUtf8(cp, utf8)), out);
+}
+
+bool TokenTable::AppendIds(std::string_view symbol, std::vector<int64_t>* out) const {
+  if (!id_lists_.empty()) {
+    auto it = id_lists_.find(symbol);
+    if (it != id_lists_.end()) {
+      out->insert(out->end(), it->second.begin(), it->second.end());
+      return true;
+    }
+  }
+  const int64_t id = TryGetId(symbol);
+  if (id < 0) return false;
+  out->push_back(id);
+  return true;
+}
+
+void TokenTable::UseBuiltin(const BuiltinTokenTable& builtin) {
+  owned_dense_ = {};
+  multi_pool_ = {};
+  multi_ids_ = {};
+  pending_multi_ = {};
+  id_lists_ = {};
+  builtin_ = true;
+  dense_ = builtin.dense_ids;
+  dense_size_ = builtin.dense_size;
+  builtin_multi_ = builtin.multi;
+  builtin_multi_size_ = builtin.multi_size;
+  has_multi_codepoint_ = false;
+  multi_first_ = {};
+  max_symbol_codepoints_ = 1;
+  max_ids_per_symbol_ = 1;
+  max_id_ = -1;
+  for (size_t i = 0; i < builtin.dense_size; ++i) {
+    max_id_ = std::max<int64_t>(max_id_, builtin.dense_ids[i]);
   }
-  return !symbol_to_id_.empty();
+  char32_t cp = 0;
+  for (size_t i = 0; i < builtin.multi_size; ++i) {
+    if (DecodeSingleCodepoint(builtin.multi[i].symbol, &cp)) {
+      has_multi_codepoint_ = true;
+    } else {
+      NoteMatchSymbol(builtin.multi[i].symbol);
+    }
+    max_id_ = std::max(max_id_, builtin.multi[i].id);
+  }
+  FinishMatchSymbols();
+  size_ = builtin.size;
+  fingerprint_ = builtin.fingerprint;
 }
 
-bool TokenTable::Contains(const std::string& symbol) const {
-  return symbol_to_id_.count(symbol) != 0;
+std::vector<std::pair<std::string, int64_t>> TokenTable::Entries() const {
+  std::vector<std::pair<std::string, int64_t>> out;
+  out.reserve(size_);
+  for (size_t cp = 0; cp < dense_size_; ++cp) {
+    if (dense_[cp] < 0) continue;
+    char utf8[4];
+    const size_t n = EncodeUtf8(static_cast<char32_t>(cp), utf8);
+    out.emplace_back(std::string(utf8, n), dense_[cp]);
+  }
+  if (builtin_) {
+    for (size_t i = 0; i < builtin_multi_size_; ++i) {
+      out.emplace_back(std::string(builtin_multi_[i].symbol), builtin_multi_[i].id);
+    }
+  } else {
+    for (const auto& kv : multi_ids_) out.emplace_back(std::string(kv.first), kv.second);
+  }
+  std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+    return a.second != b.second ? a.second < b.second : a.first < b.first;
+  });
+  return out;
 }
 
-int64_t TokenTable::GetId(const std::string& symbol) const {
-  auto it = symbol_to_id_.find(symbol);
-  if (it == symbol_to_id_.end()) return -1;
-  return it->second;
+int64_t TokenTable::FindMulti(std::string_view symbol) const {
+  if (builtin_) {
+    const BuiltinToken* end = builtin_multi_ + builtin_multi_size_;
+    const BuiltinToken* it = std::lower_bound(
+        builtin_multi_, end, symbol,
+        [](const BuiltinToken& t, std::string_view s) { return t.symbol < s; });
+    return it != end && it->symbol == symbol ? it->id : -1;
+  }
+  auto it = multi_ids_.find(symbol);
+  return it == multi_ids_.end() ? -1 : it->second;
+}
+
+int64_t TokenTable::TryGetId(std::string_view symbol) const {
+  char32_t cp = 0;
+  if (DecodeSingleCodepoint(symbol, &cp)) return TryGetId(cp);
+  return FindMulti(symbol);
+}
+
+int64_t TokenTable::TryGetMultiId(char32_t cp) const {
+  if (!has_multi_codepoint_) return -1;
+  // 单码点符号进不了数组的少见情形（码点或 id 超范围），编码到栈上，不分配
+  char utf8[4];
+  const size_t n = EncodeUtf8(cp, utf8);
+  return FindMulti(std::string_view(utf8, n));
+}
+
+void TokenTable::NoteMatchSymbol(std::string_view symbol) {
+  char32_t first = 0;
+  char32_t cp = 0;
+  size_t count = 0;
+  for (size_t pos = 0, n = 0; (n = DecodeUtf8(symbol, pos, &cp)) > 0; pos += n) {
+    if (count == 0) first = cp;
+    ++count;
+  }
+  if (count < 2 || count > kMaxMatchCodepoints) return;
+  multi_first_.push_back(first);
+  max_symbol_codepoints_ = std::max(max_symbol_codepoints_, count);
+}
+
+void TokenTable::FinishMatchSymbols() {
+  std::sort(multi_first_.begin(), multi_first_.end());
+  multi_first_.erase(std::unique(multi_first_.begin(), multi_first_.end()),
+                     multi_first_.end());
+  multi_first_.shrink_to_fit();
+}
+
+size_t TokenTable::MatchLongest(const char32_t* text, size_t size, int64_t* out,
+                                size_t* num_ids) const {
+  // 首码点不是任何多码点符号的开头时只试单码点
+  size_t limit = 1;
+  if (std::binary_search(multi_first_.begin(), multi_first_.end(), text[0])) {
+    limit = std::min(size, max_symbol_codepoints_);
+  }
+  // 前 k 个码点的 UTF-8 编码在栈上，ends[k - 1] 为其字节数
+  char utf8[kMaxMatchCodepoints * 4];
+  size_t ends[kMaxMatchCodepoints];
+  size_t count = 0;
+  for (size_t bytes = 0; count < limit; ++count) {
+    const size_t n = EncodeUtf8(text[count], utf8 + bytes);
+    if (n == 0) break;
+    bytes += n;
+    ends[count] = bytes;
+  }
+  for (size_t k = count; k > 0; --k) {
+    const std::string_view symbol(utf8, ends[k - 1]);
+    const int64_t id = k == 1 ? TryGetId(text[0]) : FindMulti(symbol);
+    if (id < 0) continue;
+    if (!id_lists_.empty()) {
+      auto it = id_lists_.find(symbol);
+      if (it != id_lists_.end()) {
+        std::copy(it->second.begin(), it->second.end(), out);
+        *num_ids = it->second.size();
+        return k;
+      }
+    }
+    *out = id;
+    *num_ids = 1;
+    return k;
+  }
+  return 0;
 }
 
 std::vector<int64_t> TokenTable::SymbolsToIds(
@@ -54,7 +360,7 @@ std::vector<int64_t> TokenTable::SymbolsToIds(
   std::vector<int64_t> ids;
   ids.reserve(symbols.size());
   for (const auto& s : symbols) {
-    int64_t id = GetId(s);
+    int64_t id = TryGetId(s);
     if (id < 0) {
       if (strict) return {};
       continue;
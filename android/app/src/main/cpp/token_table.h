@@ -1,35 +1,176 @@
 #ifndef SHERPA_TTS_TOKEN_TABLE_H_
 #define SHERPA_TTS_TOKEN_TABLE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace sherpa_tts {
 
+// 连续 token id 的只读视图（C++17 无 std::span），指向的数据由提供方持有。
+struct TokenIdSpan {
+  const int64_t* data = nullptr;
+  size_t size = 0;
+
+  const int64_t* begin() const { return data; }
+  const int64_t* end() const { return data + size; }
+  bool empty() const { return size == 0; }
+};
+
+// 多码点符号及其 id（内置表中按 symbol 字节序排序）
+struct BuiltinToken {
+  std::string_view symbol;
+  int64_t id;
+};
+
+// 由 tools/gen_token_table.cpp 从 tokens.txt 生成的只读表（token_table_<name>.inc），
+// 全部为 constexpr 常量，TokenTable 直接引用、不复制。
+struct BuiltinTokenTable {
+  std::string_view name;
+  const int32_t* dense_ids;  // 下标为码点，不存在为 -1
+  size_t dense_size;
+  const BuiltinToken* multi;  // 多码点符号，可为空
+  size_t multi_size;
+  size_t size;  // 符号总数
+  uint64_t fingerprint;
+};
+
+// 按名字查找编译进库的内置表（如 "ru"），没有返回 nullptr。
+const BuiltinTokenTable* FindBuiltinTokenTable(std::string_view name);
+
 // 从 tokens 文件（每行 "symbol id" 或 "symbol\tid"）加载 symbol -> id 映射。
 // 与常见 VITS/Piper tokens.txt 格式兼容。
+// 单个码点的符号（音素 token 几乎都是）存在按码点下标的数组里，查询只做一次下标访问；
+// 多码点符号（或超出数组范围、非法 UTF-8 的符号）另存一张哈希表。
+// 也可直接引用内置表（BuiltinTokenTable），此时不解析文件、不分配内存（有多码点符号时
+// 只另建一张首码点表），接口不变。
+// espeak 输出的音素码点序列用 MatchSymbol 按最长匹配转为 id，多码点符号（如 "tʃ"）也能命中。
 class TokenTable {
  public:
   TokenTable() = default;
 
+  // 引用内置表，不分配内存；builtin 为静态常量
+  explicit TokenTable(const BuiltinTokenTable& builtin) { UseBuiltin(builtin); }
+
+  // 引用内置表 / 持有指针，禁止复制
+  TokenTable(const TokenTable&) = delete;
+  TokenTable& operator=(const TokenTable&) = delete;
+
   // 从文件路径加载，失败返回 false。
   bool LoadFromFile(const std::string& path);
 
-  // 符号是否存在
-  bool Contains(const std::string& symbol) const;
+  // 逐条构建（tokens.txt、Piper 配置等加载器共用）：Clear 后逐条 Add，最后 Finish。
+  // 同名符号后者覆盖前者；id 为负的条目忽略。一个符号可对应多个 id（Piper 的 phoneme_id_map），
+  // 此时 TryGetId 返回第一个，AppendIds 追加全部。Finish 在表为空时返回 false。
+  void Clear();
+  void Add(std::string_view symbol, const int64_t* ids, size_t num_ids);
+  bool Finish();
+
+  // 改为引用内置表（丢弃之前加载的内容）
+  void UseBuiltin(const BuiltinTokenTable& builtin);
+
+  // 全部 (symbol, 第一个 id)，按 id、再按 symbol 排序（供生成内置表与调试，会分配内存）
+  std::vector<std::pair<std::string, int64_t>> Entries() const;
 
-  // 取 id，若不存在返回 -1
-  int64_t GetId(const std::string& symbol) const;
+  // 单码点符号的 id，若不存在返回 -1
+  int64_t TryGetId(char32_t cp) const {
+    if (cp < dense_size_ && dense_[cp] >= 0) return dense_[cp];
+    return TryGetMultiId(cp);
+  }
+
+  // 任意符号的 id，若不存在返回 -1；单码点符号不经过哈希。不分配内存
+  int64_t TryGetId(std::string_view symbol) const;
+
+  // 把符号的全部 id 追加到 out，不存在返回 false。音素映射用这个，以支持一个符号多个 id
+  bool AppendIds(char32_t cp, std::vector<int64_t>* out) const;
+  bool AppendIds(std::string_view symbol, std::vector<int64_t>* out) const;
+
+  // 是否有对应多个 id 的符号（内置表不支持这种条目）
+  bool HasIdLists() const { return !id_lists_.empty(); }
+
+  // 多码点符号参与最长匹配的码点数上限，更长的符号只能按 UTF-8 串查询
+  static constexpr size_t kMaxMatchCodepoints = 8;
+
+  // 从码点序列 text（size >= 1）开头按最长匹配取一个符号：多码点符号优先于其首码点单独成符号。
+  // 命中时把该符号的全部 id 写入 out（容量须 >= MaxIdsPerSymbol()）、个数写入 *num_ids，
+  // 返回消耗的码点数；无匹配返回 0。不分配内存，没有多码点符号时只做一次数组下标访问
+  size_t MatchSymbol(const char32_t* text, size_t size, int64_t* out, size_t* num_ids) const {
+    if (multi_first_.empty() && id_lists_.empty()) {
+      const int64_t id = TryGetId(text[0]);
+      if (id < 0) return 0;
+      *out = id;
+      *num_ids = 1;
+      return 1;
+    }
+    return MatchLongest(text, size, out, num_ids);
+  }
+
+  // 单个符号最多对应的 id 数（MatchSymbol 输出缓冲的大小）
+  size_t MaxIdsPerSymbol() const { return max_ids_per_symbol_; }
+
+  // 符号是否存在（等价于 TryGetId(symbol) >= 0）
+  bool Contains(const std::string& symbol) const { return TryGetId(symbol) >= 0; }
+
+  // 取 id，若不存在返回 -1（同 TryGetId）
+  int64_t GetId(const std::string& symbol) const { return TryGetId(symbol); }
 
   // 将一串符号转为 id 序列，未知符号跳过或返回空（由 strict 决定）
   std::vector<int64_t> SymbolsToIds(const std::vector<std::string>& symbols,
                                     bool strict = false) const;
 
-  size_t Size() const { return symbol_to_id_.size(); }
+  size_t Size() const { return size_; }
+
+  // 最大的 id（空表为 -1）；直接输入 token id 时据此校验，越界的 id 会让模型的 embedding 越界
+  int64_t MaxId() const { return max_id_; }
+
+  // 是否为 Piper 风格的表（含 "^"、"$"、"_"）：一次推理的输入以 "^" / "$" 包围、每个音素后跟
+  // 填充 "_"。否则（词典式模型）各词的 token id 直接拼接，不加填充与首尾
+  bool UsesPiperFraming() const {
+    return TryGetId(U'^') >= 0 && TryGetId(U'$') >= 0 && TryGetId(U'_') >= 0;
+  }
+
+  // 内容指纹（与加载顺序无关）：指纹相同的两张表视为等价，
+  // 绑定到其中一张的 Lexicon 可供另一张共用（见 AcquireSharedLexicon）。
+  uint64_t Fingerprint() const { return fingerprint_; }
 
  private:
-  std::unordered_map<std::string, int64_t> symbol_to_id_;
+  // 数组未命中时查多码点表（其中没有单码点符号时直接返回 -1）
+  int64_t TryGetMultiId(char32_t cp) const;
+  int64_t FindMulti(std::string_view symbol) const;
+  size_t MatchLongest(const char32_t* text, size_t size, int64_t* out, size_t* num_ids) const;
+  // 登记一个多码点符号的首码点与码点数（供 MatchSymbol），Finish / UseBuiltin 中调用
+  void NoteMatchSymbol(std::string_view symbol);
+  void FinishMatchSymbols();
+
+  // 下标为码点；不存在为 -1。长度 = 最大单码点符号 + 1（上限 kMaxDenseCodepoint）。
+  // 指向 owned_dense_ 或内置表
+  const int32_t* dense_ = nullptr;
+  size_t dense_size_ = 0;
+  std::vector<int32_t> owned_dense_;
+  // 文件加载的其余符号；键指向 multi_pool_，加载完成后不再修改
+  std::string multi_pool_;
+  std::unordered_map<std::string_view, int64_t> multi_ids_;
+  // 构建期间的多码点符号，Finish 时转入 multi_pool_ / multi_ids_
+  std::unordered_map<std::string, int64_t> pending_multi_;
+  // 对应多个 id 的符号（少见，只在 AppendIds 中查）；单个 id 的符号不在此表
+  std::map<std::string, std::vector<int64_t>, std::less<>> id_lists_;
+  // 内置表的其余符号（有序，二分查找）；builtin_ 时不用 multi_ids_
+  bool builtin_ = false;
+  const BuiltinToken* builtin_multi_ = nullptr;
+  size_t builtin_multi_size_ = 0;
+  bool has_multi_codepoint_ = false;
+  // 多码点符号的首码点（有序、去重）与最长的码点数（不超过 kMaxMatchCodepoints）
+  std::vector<char32_t> multi_first_;
+  size_t max_symbol_codepoints_ = 1;
+  size_t max_ids_per_symbol_ = 1;
+  size_t size_ = 0;
+  int64_t max_id_ = -1;
+  uint64_t fingerprint_ = 0;
 };
 
 }  // namespace sherpa_tts
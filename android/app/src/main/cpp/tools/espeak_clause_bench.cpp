@@ -0,0 +1,128 @@
+/**
+ * espeak-clause-bench：长文本逐子句音素化的耗时随文本长度的变化（1 KB - 1 MB）。
+ * 对比两种子句翻译：
+ * - rescan：espeak_TextToPhonemesWithTerminator，每个子句都对剩余文本 strlen，
+ *   整篇耗时随长度平方增长；
+ * - range：espeak_ng_TextToPhonemesInRange，整篇文本的末尾只求一次，线性时间。
+ * 文本由内置段落（或给定文件）重复拼接到目标长度，校验两者逐子句的音素一致。
+ * 每 KB 耗时（us/KB）基本不变即为线性。
+ *
+ * 需以 -DSHERPA_TTS_TOOLS_ENABLE_ESPEAK_NG=ON 构建。
+ * 用法：espeak-clause-bench <espeak-ng-data 目录> [voice，默认 ru] [UTF-8 文本文件] [最大 KB，默认 1024；按 1、4、16 ... KB 递增]
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "espeak-ng/espeak_ng.h"
+#include "espeak-ng/speak_lib.h"
+#include "phonemize.hpp"  // piper-phonemize
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char kDefaultText[] =
+    "Мороз и солнце; день чудесный! Ещё ты дремлешь, друг прелестный? "
+    "Пора, красавица, проснись: открой сомкнуты негой взоры навстречу северной Авроры, "
+    "звездою севера явись! Вечор, ты помнишь, вьюга злилась, на мутном небе мгла носилась; "
+    "луна, как бледное пятно, сквозь тучи мрачные желтела, и ты печальная сидела. "
+    "А нынче погляди в окно: под голубыми небесами великолепными коврами, "
+    "блестя на солнце, снег лежит; прозрачный лес один чернеет, и ель сквозь иней зеленеет, "
+    "и речка подо льдом блестит. ";
+
+struct Run {
+  double seconds = 0;
+  size_t clauses = 0;
+  uint64_t hash = 1469598103934665603ull;  // FNV-1a，逐子句的音素与终止符
+};
+
+// 重复 base 直到至少 size 字节，在其后第一个空白处截断（不切开 UTF-8 字符）
+std::string MakeText(const std::string& base, size_t size) {
+  std::string text;
+  text.reserve(size + base.size());
+  while (text.size() < size) text += base;
+  const size_t cut = text.find(' ', size);
+  if (cut != std::string::npos) text.resize(cut);
+  return text;
+}
+
+template <typename Translator>
+Run Phonemize(const std::string& text, piper::eSpeakPhonemeConfig& config,
+              const Translator& translate) {
+  Run run;
+  const auto start = Clock::now();
+  piper::phonemize_eSpeak_clauses(
+      text, config, translate,
+      [&run](const std::vector<piper::Phoneme>& phonemes, int terminator) {
+        for (piper::Phoneme p : phonemes) {
+          run.hash = (run.hash ^ static_cast<uint32_t>(p)) * 1099511628211ull;
+        }
+        run.hash = (run.hash ^ static_cast<uint32_t>(terminator)) * 1099511628211ull;
+        ++run.clauses;
+        return true;
+      });
+  run.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return run;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <espeak-ng-data> [voice] [text file] [max KB]\n", argv[0]);
+    return 1;
+  }
+  const std::string data_dir = argv[1];
+  const std::string voice = argc > 2 ? argv[2] : "ru";
+  std::string base = kDefaultText;
+  if (argc > 3) {
+    std::ifstream in(argv[3], std::ios::binary);
+    if (!in) {
+      std::fprintf(stderr, "cannot read %s\n", argv[3]);
+      return 1;
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    base = ss.str() + " ";
+  }
+  const size_t max_kb = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1024;
+
+  if (espeak_Initialize(AUDIO_OUTPUT_SYNCHRONOUS, 0, data_dir.c_str(), 0) != 22050) {
+    std::fprintf(stderr, "cannot initialize espeak-ng with %s\n", data_dir.c_str());
+    return 1;
+  }
+  if (espeak_SetVoiceByName(voice.c_str()) != EE_OK) {
+    std::fprintf(stderr, "unknown voice %s\n", voice.c_str());
+    return 1;
+  }
+  piper::eSpeakPhonemeConfig config;
+  config.voice = voice;
+  const piper::eSpeakClauseFn rescan(espeak_TextToPhonemesWithTerminator);
+  const piper::eSpeakClauseRangeFn range(espeak_ng_TextToPhonemesInRange);
+
+  // 预热
+  Phonemize(MakeText(base, 1024), config, range);
+
+  std::printf("%8s %8s %12s %10s %12s %10s %8s\n", "KB", "clauses", "rescan ms", "us/KB",
+              "range ms", "us/KB", "speedup");
+  bool ok = true;
+  for (size_t kb = 1; kb <= max_kb; kb *= 4) {
+    const std::string text = MakeText(base, kb * 1024);
+    const Run a = Phonemize(text, config, rescan);
+    const Run b = Phonemize(text, config, range);
+    const double size_kb = text.size() / 1024.0;
+    std::printf("%8zu %8zu %12.2f %10.1f %12.2f %10.1f %7.2fx%s\n", kb, b.clauses,
+                a.seconds * 1e3, a.seconds * 1e6 / size_kb, b.seconds * 1e3,
+                b.seconds * 1e6 / size_kb, a.seconds / b.seconds,
+                a.hash == b.hash && a.clauses == b.clauses ? "" : "  MISMATCH");
+    ok = ok && a.hash == b.hash && a.clauses == b.clauses;
+  }
+  espeak_Terminate();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * espeak-pool-bench：EspeakPool 在 1 / 2 / 4 / 8 个 espeak 实例下的音素化吞吐（句/秒）。
+ * 8 个客户端线程并发提交句子，实例数不足时在池中排队；同时校验各实例数下的音素与
+ * 单实例结果逐句一致（各实例的翻译状态互不干扰）。libs 为加载的库份数，
+ * 上下文模式下所有实例共用一份。
+ *
+ * 需以 -DSHERPA_TTS_TOOLS_ENABLE_ESPEAK_NG=ON 构建。
+ * 用法：espeak-pool-bench <espeak-ng-data 目录> [voice，默认 ru] [每轮句数，默认 2000]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "espeak_pool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kClients = 8;
+
+const char* kSentences[] = {
+    "Привет, мир!",
+    "Съешь же ещё этих мягких французских булок, да выпей чаю.",
+    "Сегодня хорошая погода, и мы идём гулять в парк.",
+    "В лесу родилась ёлочка, в лесу она росла.",
+    "Зимой и летом стройная, зелёная была.",
+    "Мороз и солнце; день чудесный!",
+    "Ещё ты дремлешь, друг прелестный?",
+    "Пора, красавица, проснись.",
+    "Открой сомкнуты негой взоры навстречу северной Авроры.",
+    "Вечор, ты помнишь, вьюга злилась, на мутном небе мгла носилась.",
+};
+constexpr size_t kNumSentences = sizeof(kSentences) / sizeof(kSentences[0]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <espeak-ng-data> [voice] [sentences]\n", argv[0]);
+    return 1;
+  }
+  const std::string data_dir = argv[1];
+  const std::string voice = argc > 2 ? argv[2] : "ru";
+  const size_t total = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 2000;
+
+  std::vector<sherpa_tts::EspeakSentences> expected(kNumSentences);
+  double base_rate = 0;
+  for (int workers : {1, 2, 4, 8}) {
+    sherpa_tts::EspeakPool pool(SHERPA_TTS_ESPEAK_LIBRARY);
+    const auto load_start = Clock::now();
+    if (pool.Reserve(workers) != workers) {
+      std::fprintf(stderr, "failed to reserve %d instances of %s\n", workers,
+                   SHERPA_TTS_ESPEAK_LIBRARY);
+      return 1;
+    }
+    const double load_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - load_start).count();
+
+    // 预热：每个实例都完成初始化与 voice 加载，不计入吞吐
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workers; ++i) {
+      threads.emplace_back([&] {
+        sherpa_tts::EspeakSentences out;
+        pool.Phonemize(kSentences[0], data_dir, voice, &out);
+      });
+    }
+    for (auto& t : threads) t.join();
+    threads.clear();
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> mismatches{0};
+    std::atomic<size_t> failures{0};
+    const auto start = Clock::now();
+    for (int c = 0; c < kClients; ++c) {
+      threads.emplace_back([&] {
+        sherpa_tts::EspeakSentences out;
+        for (size_t i = next++; i < total; i = next++) {
+          const size_t k = i % kNumSentences;
+          if (!pool.Phonemize(kSentences[k], data_dir, voice, &out)) {
+            ++failures;
+          } else if (workers > 1 && out != expected[k]) {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (workers == 1) {
+      for (size_t k = 0; k < kNumSentences; ++k) {
+        pool.Phonemize(kSentences[k], data_dir, voice, &expected[k]);
+      }
+    }
+    const double rate = total / seconds;
+    if (workers == 1) base_rate = rate;
+    const sherpa_tts::EspeakPoolStats stats = pool.Stats();
+    std::printf("workers=%d libs=%d load=%.1f ms %.0f sentences/s (x%.2f) queued=%.0f%% failures=%zu mismatches=%zu\n",
+                workers, stats.libraries, load_ms, rate, base_rate > 0 ? rate / base_rate : 0,
+                stats.requests ? 100.0 * stats.waits / stats.requests : 0.0,
+                failures.load(), mismatches.load());
+    if (failures > 0 || mismatches > 0) return 1;
+  }
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * espeak-word-cache-bench：PhonemizeWordsWithEspeak 前的词级缓存（espeak_word_cache.h）。
+ * 按句切分文本、每句的词整批音素化（同 Hybrid 模式下词典全部未命中），分三轮：
+ * - cold：每次调用前清空缓存，全部经过 espeak；
+ * - first pass：缓存从空开始顺序处理全文，命中率即文本自身的重复词比例；
+ * - warm：再处理一遍全文；
+ * - restart：开启持久化（espeak_word_store.h）后首遍处理全文写入文件，再清空内存缓存、重新打开
+ *   文件（模拟进程重启），处理一遍全文：命中来自 mmap 的文件，不经 espeak。
+ * 校验各轮的 token id 与 cold 逐句一致。
+ *
+ * 需以 -DSHERPA_TTS_TOOLS_ENABLE_ESPEAK_NG=ON 构建。
+ * 用法：espeak-word-cache-bench <espeak-ng-data 目录> [voice，默认 ru] [UTF-8 文本文件] [轮数，默认 5]
+ *       [持久化目录，默认在 /tmp 下新建]
+ */
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "espeak_phonemize.h"
+#include "espeak_word_cache.h"
+#include "text_segment.h"
+#include "token_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char kDefaultText[] =
+    "Мороз и солнце; день чудесный! Ещё ты дремлешь, друг прелестный? "
+    "Пора, красавица, проснись: открой сомкнуты негой взоры навстречу северной Авроры, "
+    "звездою севера явись! Вечор, ты помнишь, вьюга злилась, на мутном небе мгла носилась; "
+    "луна, как бледное пятно, сквозь тучи мрачные желтела, и ты печальная сидела. "
+    "А нынче погляди в окно: под голубыми небесами великолепными коврами, "
+    "блестя на солнце, снег лежит; прозрачный лес один чернеет, и ель сквозь иней зеленеет, "
+    "и речка подо льдом блестит. Вся комната янтарным блеском озарена. Весёлым треском "
+    "трещит затопленная печь. Приятно думать у лежанки. Но знаешь: не велеть ли в санки "
+    "кобылку бурую запречь? Скользя по утреннему снегу, друг милый, предадимся бегу "
+    "нетерпеливого коня и навестим поля пустые, леса, недавно столь густые, "
+    "и берег, милый для меня.";
+
+struct Pass {
+  double seconds = 0;
+  size_t words = 0;
+  size_t mismatches = 0;
+  size_t failures = 0;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <espeak-ng-data> [voice] [text file] [rounds]\n", argv[0]);
+    return 1;
+  }
+  const std::string data_dir = argv[1];
+  const std::string voice = argc > 2 ? argv[2] : "ru";
+  std::string text = kDefaultText;
+  if (argc > 3) {
+    std::ifstream in(argv[3], std::ios::binary);
+    if (!in) {
+      std::fprintf(stderr, "cannot read %s\n", argv[3]);
+      return 1;
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    text = ss.str();
+  }
+  const int rounds = argc > 4 ? std::atoi(argv[4]) : 5;
+
+  const sherpa_tts::BuiltinTokenTable* builtin = sherpa_tts::FindBuiltinTokenTable("ru");
+  if (!builtin) {
+    std::fprintf(stderr, "no builtin token table\n");
+    return 1;
+  }
+  const sherpa_tts::TokenTable token_table(*builtin);
+
+  std::vector<std::string_view> sentence_views;
+  sherpa_tts::SplitSentences(text, &sentence_views);
+  std::vector<std::vector<std::string>> sentences;
+  for (std::string_view s : sentence_views) {
+    std::vector<std::string_view> words;
+    sherpa_tts::SplitWords(s, &words);
+    std::vector<std::string> kept;
+    for (std::string_view w : words) {
+      if (!sherpa_tts::IsPunctuationSegment(w)) kept.emplace_back(w);
+    }
+    if (!kept.empty()) sentences.push_back(std::move(kept));
+  }
+
+  sherpa_tts::EspeakWordCache& cache = sherpa_tts::EspeakWordCache::Global();
+  std::vector<std::vector<int64_t>> expected(sentences.size());
+  auto run = [&](bool clear_each_call, int num_rounds, bool record) {
+    Pass pass;
+    const auto start = Clock::now();
+    for (int r = 0; r < num_rounds; ++r) {
+      for (size_t i = 0; i < sentences.size(); ++i) {
+        if (clear_each_call) cache.Clear();
+        sherpa_tts::EspeakResult result =
+            sherpa_tts::PhonemizeWordsWithEspeak(sentences[i], data_dir, voice, &token_table);
+        pass.words += sentences[i].size();
+        if (result.code != sherpa_tts::EspeakErrorCode::kOk) {
+          ++pass.failures;
+        } else if (record && r == 0) {
+          expected[i] = result.token_ids;
+        } else if (result.token_ids != expected[i]) {
+          ++pass.mismatches;
+        }
+      }
+    }
+    pass.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return pass;
+  };
+  auto report = [](const char* name, const Pass& pass, double base) {
+    const double rate = pass.words / pass.seconds;
+    std::printf("%-10s %8.0f words/s (x%.2f) failures=%zu mismatches=%zu\n", name, rate,
+                base > 0 ? rate / base : 1.0, pass.failures, pass.mismatches);
+    return rate;
+  };
+
+  // 预热：加载 espeak 与 voice
+  sherpa_tts::PhonemizeWordsWithEspeak({"мир"}, data_dir, voice, &token_table);
+
+  const Pass cold = run(true, rounds, true);
+  const double base = report("cold", cold, 0);
+
+  cache.Clear();
+  const sherpa_tts::EspeakWordCacheStats before = cache.Stats();
+  const Pass first = run(false, 1, false);
+  const sherpa_tts::EspeakWordCacheStats after_first = cache.Stats();
+  report("first", first, base);
+  const uint64_t first_hits = after_first.hits - before.hits;
+  const uint64_t first_lookups = first_hits + after_first.misses - before.misses;
+  std::printf("first pass hit ratio %.1f%% (%zu sentences, %zu words, %llu uncacheable)\n",
+              first_lookups ? 100.0 * first_hits / first_lookups : 0.0, sentences.size(),
+              first.words,
+              static_cast<unsigned long long>(after_first.uncacheable - before.uncacheable));
+
+  const Pass warm = run(false, rounds, false);
+  report("warm", warm, base);
+  const sherpa_tts::EspeakWordCacheStats stats = cache.Stats();
+  std::printf("cache entries=%zu bytes=%zu evictions=%llu\n", stats.entries, stats.bytes,
+              static_cast<unsigned long long>(stats.evictions));
+
+  std::string persist_dir;
+  if (argc > 5) {
+    persist_dir = argv[5];
+  } else {
+    char tmpl[] = "/tmp/espeak-word-cache-bench.XXXXXX";
+    if (!mkdtemp(tmpl)) {
+      std::fprintf(stderr, "cannot create temp dir\n");
+      return 1;
+    }
+    persist_dir = tmpl;
+  }
+  cache.Clear();
+  cache.SetPersistentDir(persist_dir);
+  const Pass fill = run(false, 1, false);
+  report("fill", fill, base);
+
+  cache.SetPersistentDir("");
+  cache.Clear();
+  const auto reopen_start = Clock::now();
+  cache.SetPersistentDir(persist_dir);
+  const sherpa_tts::EspeakWordCacheStats before_restart = cache.Stats();
+  const Pass restart = run(false, 1, false);
+  const sherpa_tts::EspeakWordCacheStats after_restart = cache.Stats();
+  report("restart", restart, base);
+  const uint64_t disk_hits = after_restart.persistent_hits - before_restart.persistent_hits;
+  const uint64_t restart_lookups = after_restart.hits - before_restart.hits +
+                                   after_restart.misses - before_restart.misses;
+  std::printf("restart: disk hits %.1f%% of lookups, %zu words on disk, first pass incl. open %.3f ms (%s)\n",
+              restart_lookups ? 100.0 * disk_hits / restart_lookups : 0.0,
+              after_restart.persistent_entries,
+              std::chrono::duration<double, std::milli>(Clock::now() - reopen_start).count(),
+              persist_dir.c_str());
+  cache.SetPersistentDir("");
+
+  const bool ok = cold.failures + first.failures + warm.failures + fill.failures +
+                          restart.failures == 0 &&
+                  first.mismatches + warm.mismatches + fill.mismatches + restart.mismatches == 0;
+  return ok ? 0 : 1;
+}
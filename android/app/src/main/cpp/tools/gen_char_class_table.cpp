@@ -0,0 +1,78 @@
+/**
+ * gen-char-class-table：由 espeak-ng 自带的 ucd-tools 分类数据生成 text_segment 用的码点分类表。
+ * - ASCII 与 C locale 的 isspace / ispunct 保持一致；
+ * - 其余码点：Zs/Zl/Zp 为空白，P* 为标点，另加旧标点表中的 ´ (U+00B4)、～ (U+FF5E)。
+ * 输出为两级表（按 256 码点分块去重，每码点 2 bit），覆盖 U+0000..U+2FFFF。
+ *
+ * 用法：gen-char-class-table > ../text_segment_table.inc
+ */
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "ucd/ucd.h"
+
+namespace {
+
+constexpr uint32_t kLimit = 0x30000;
+constexpr int kOther = 0;
+constexpr int kSpace = 1;
+constexpr int kPunct = 2;
+
+int Classify(uint32_t cp) {
+  if (cp < 0x80) {
+    if (std::isspace(static_cast<int>(cp))) return kSpace;
+    if (std::ispunct(static_cast<int>(cp))) return kPunct;
+    return kOther;
+  }
+  if (cp == 0x00B4 || cp == 0xFF5E) return kPunct;
+  switch (ucd_lookup_category_group(cp)) {
+    case UCD_CATEGORY_GROUP_Z:
+      return kSpace;
+    case UCD_CATEGORY_GROUP_P:
+      return kPunct;
+    default:
+      return kOther;
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::map<std::vector<uint8_t>, int> block_ids;
+  std::vector<std::vector<uint8_t>> blocks;
+  std::vector<int> stage1;
+  for (uint32_t base = 0; base < kLimit; base += 256) {
+    std::vector<uint8_t> packed(64, 0);
+    for (uint32_t i = 0; i < 256; ++i) {
+      packed[i / 4] |= static_cast<uint8_t>(Classify(base + i) << ((i % 4) * 2));
+    }
+    auto it = block_ids.find(packed);
+    if (it == block_ids.end()) {
+      it = block_ids.emplace(packed, static_cast<int>(blocks.size())).first;
+      blocks.push_back(packed);
+    }
+    stage1.push_back(it->second);
+  }
+
+  std::printf("// 由 tools/gen_char_class_table.cpp 从 ucd-tools 分类数据生成，请勿手改。\n");
+  std::printf("// 两级表：kCharClassStage1[cp >> 8] 为块号，块内每码点 2 bit（CharClass）。\n\n");
+  std::printf("constexpr uint32_t kCharClassLimit = 0x%X;\n\n", kLimit);
+  std::printf("constexpr uint8_t kCharClassStage1[%zu] = {", stage1.size());
+  for (size_t i = 0; i < stage1.size(); ++i) {
+    std::printf("%s%d,", i % 24 == 0 ? "\n    " : " ", stage1[i]);
+  }
+  std::printf("\n};\n\n");
+  std::printf("constexpr uint8_t kCharClassStage2[%zu][64] = {\n", blocks.size());
+  for (const auto& b : blocks) {
+    std::printf("    {");
+    for (size_t i = 0; i < b.size(); ++i) {
+      std::printf("%s0x%02X,", i % 12 == 0 ? "\n        " : " ", b[i]);
+    }
+    std::printf("\n    },\n");
+  }
+  std::printf("};\n");
+  return 0;
+}
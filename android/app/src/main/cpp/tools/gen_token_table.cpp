@@ -0,0 +1,115 @@
+/**
+ * gen-token-table：把随应用发布的 tokens.txt 生成为内置 token 表（constexpr），
+ * 运行时不再解析文件，查询也不分配内存（见 token_table.h 的 BuiltinTokenTable）。
+ * - 单码点符号：按码点下标的数组（长度 = 最大码点 + 1），与文件加载时的布局相同；
+ * - 多码点符号：按字节序排序的数组，二分查找；
+ * - 指纹与运行时加载同一文件得到的相同，可与之共用词典。
+ *
+ * 用法：gen-token-table <tokens.txt> <name> > ../token_table_<name>.inc
+ * 然后在 builtin_token_tables.cpp 中登记 kBuiltinTokens<Name>。
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "text_segment.h"
+#include "token_table.h"
+
+namespace {
+
+// 字符串字面量：可打印 ASCII 原样输出，其余字节用三位八进制转义（不会吞掉后续字符）
+std::string CppLiteral(const std::string& s) {
+  std::string out = "\"";
+  for (unsigned char c : s) {
+    if (c >= 0x20 && c < 0x7F && c != '"' && c != '\\' && c != '?') {
+      out.push_back(static_cast<char>(c));
+    } else {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\%03o", c);
+      out += buf;
+    }
+  }
+  out += "\"";
+  return out;
+}
+
+bool IsSingleCodepoint(const std::string& s, char32_t* cp) {
+  const size_t n = sherpa_tts::DecodeUtf8(s, 0, cp);
+  return n != 0 && n == s.size() && !(n == 1 && *cp == 0xFFFD);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <tokens.txt> <name>\n", argv[0]);
+    return 1;
+  }
+  const std::string name = argv[2];
+  for (char c : name) {
+    if (!std::islower(static_cast<unsigned char>(c)) &&
+        !std::isdigit(static_cast<unsigned char>(c))) {
+      std::fprintf(stderr, "name must be [a-z0-9]+: %s\n", name.c_str());
+      return 1;
+    }
+  }
+  sherpa_tts::TokenTable table;
+  if (!table.LoadFromFile(argv[1])) {
+    std::fprintf(stderr, "failed to load tokens: %s\n", argv[1]);
+    return 1;
+  }
+  if (table.HasIdLists()) {
+    std::fprintf(stderr, "built-in tables do not support symbols with multiple ids\n");
+    return 1;
+  }
+  std::string suffix = name;
+  suffix[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(suffix[0])));
+
+  // 与 TokenTable::LoadFromFile 的拆分一致：数组中的由 TryGetId(char32_t) 直接命中，其余为多码点
+  std::vector<int32_t> dense;
+  std::vector<std::pair<std::string, int64_t>> multi;
+  for (const auto& e : table.Entries()) {
+    char32_t cp = 0;
+    if (IsSingleCodepoint(e.first, &cp) && cp <= 0xFFFF && e.second <= INT32_MAX) {
+      if (cp >= dense.size()) dense.resize(cp + 1, -1);
+      dense[cp] = static_cast<int32_t>(e.second);
+    } else {
+      multi.push_back(e);
+    }
+  }
+  std::sort(multi.begin(), multi.end());
+
+  std::string source = argv[1];
+  source = source.substr(source.find_last_of("/\\") + 1);
+  std::printf("// 由 tools/gen_token_table.cpp 从 %s 生成，请勿手改。\n",
+              source.c_str());
+  std::printf("// %zu 个符号：%zu 个单码点（数组长度 %zu），%zu 个多码点。\n\n",
+              table.Size(), table.Size() - multi.size(), dense.size(),
+              multi.size());
+  std::printf("constexpr int32_t kTokenDense%s[%zu] = {", suffix.c_str(),
+              dense.size());
+  for (size_t i = 0; i < dense.size(); ++i) {
+    std::printf("%s%d,", i % 16 == 0 ? "\n    " : " ", dense[i]);
+  }
+  std::printf("\n};\n\n");
+  if (!multi.empty()) {
+    std::printf("constexpr BuiltinToken kTokenMulti%s[%zu] = {\n", suffix.c_str(),
+                multi.size());
+    for (const auto& m : multi) {
+      std::printf("    {%s, %lld},\n", CppLiteral(m.first).c_str(),
+                  static_cast<long long>(m.second));
+    }
+    std::printf("};\n\n");
+  }
+  std::printf("constexpr BuiltinTokenTable kBuiltinTokens%s = {\n", suffix.c_str());
+  std::printf("    \"%s\", kTokenDense%s, %zu, %s%s, %zu, %zu, 0x%016llXull,\n};\n",
+              name.c_str(), suffix.c_str(), dense.size(),
+              multi.empty() ? "nullptr" : "kTokenMulti",
+              multi.empty() ? "" : suffix.c_str(), multi.size(), table.Size(),
+              static_cast<unsigned long long>(table.Fingerprint()));
+  return 0;
+}
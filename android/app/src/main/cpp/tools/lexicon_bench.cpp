@@ -0,0 +1,152 @@
+/**
+ * lexicon-bench：对比词典查询吞吐。
+ * - unordered_map：旧实现（unordered_map<string, vector<string>> + Contains/GetPhonemes 拷贝
+ *   + TokenTable::SymbolsToIds）；
+ * - trie lookup：Lexicon::Lookup（前缀树精确查找，返回 id 片段）；
+ * - trie longest-match：Lexicon::PrefixMatches 在连续文本上逐词做最长匹配。
+ *
+ * 用法：lexicon-bench <tokens.txt> [lexicon.txt]
+ * 未给出词典时生成 500k 条随机俄语词条（音素取自 tokens.txt）。
+ */
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lexicon.h"
+#include "token_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Seconds(Clock::duration d) {
+  return std::chrono::duration<double>(d).count();
+}
+
+std::vector<std::string> ReadTokenSymbols(const std::string& path) {
+  std::vector<std::string> symbols;
+  std::ifstream is(path);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream iss(line);
+    std::string sym;
+    std::string id;
+    if (iss >> sym >> id) symbols.push_back(sym);
+  }
+  return symbols;
+}
+
+std::string GenerateLexicon(const std::vector<std::string>& symbols,
+                            size_t num_entries) {
+  static const char* kLetters[] = {"а", "б", "в", "г", "д", "е", "ж", "з",
+                                   "и", "к", "л", "м", "н", "о", "п", "р",
+                                   "с", "т", "у", "ф", "х", "ш", "ы", "я"};
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> letter(0, std::size(kLetters) - 1);
+  std::uniform_int_distribution<size_t> sym(0, symbols.size() - 1);
+  std::uniform_int_distribution<int> len(3, 10);
+  auto path = std::filesystem::temp_directory_path() / "lexicon-bench.txt";
+  std::ofstream os(path);
+  for (size_t i = 0; i < num_entries; ++i) {
+    int n = len(rng);
+    for (int k = 0; k < n; ++k) os << kLetters[letter(rng)];
+    os << i;
+    for (int k = 0; k < n; ++k) os << ' ' << symbols[sym(rng)];
+    os << '\n';
+  }
+  return path.string();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <tokens.txt> [lexicon.txt]\n", argv[0]);
+    return 1;
+  }
+  sherpa_tts::TokenTable tokens;
+  if (!tokens.LoadFromFile(argv[1])) {
+    std::fprintf(stderr, "failed to load tokens: %s\n", argv[1]);
+    return 1;
+  }
+  std::string lexicon_path =
+      argc > 2 ? argv[2] : GenerateLexicon(ReadTokenSymbols(argv[1]), 500000);
+
+  // 旧实现的数据结构
+  std::unordered_map<std::string, std::vector<std::string>> map;
+  std::vector<std::string> keys;
+  {
+    std::ifstream is(lexicon_path);
+    std::string line;
+    while (std::getline(is, line)) {
+      std::istringstream iss(line);
+      std::vector<std::string> parts;
+      std::string part;
+      while (iss >> part) parts.push_back(part);
+      if (parts.size() < 2) continue;
+      keys.push_back(parts[0]);
+      map[parts[0]].assign(parts.begin() + 1, parts.end());
+    }
+  }
+  sherpa_tts::Lexicon lexicon;
+  auto t0 = Clock::now();
+  lexicon.LoadFromFile(lexicon_path, &tokens);
+  std::printf("entries=%zu load_s=%.3f\n", lexicon.Size(),
+              Seconds(Clock::now() - t0));
+
+  // 查询集：一半命中、一半未命中
+  std::mt19937 rng(7);
+  std::vector<std::string> queries;
+  const size_t kQueries = 1000000;
+  queries.reserve(kQueries);
+  for (size_t i = 0; i < kQueries; ++i) {
+    const std::string& k = keys[rng() % keys.size()];
+    queries.push_back(i % 2 == 0 ? k : k + "x");
+  }
+  std::string stream;
+  for (const auto& q : queries) {
+    stream += q;
+    stream += ' ';
+  }
+
+  size_t sink = 0;
+  t0 = Clock::now();
+  for (const auto& q : queries) {
+    if (map.count(q) != 0) {
+      std::vector<std::string> phonemes = map.find(q)->second;
+      sink += tokens.SymbolsToIds(phonemes, false).size();
+    }
+  }
+  double map_s = Seconds(Clock::now() - t0);
+
+  t0 = Clock::now();
+  for (const auto& q : queries) {
+    sherpa_tts::TokenIdSpan ids;
+    if (lexicon.Lookup(q, &ids)) sink += ids.size;
+  }
+  double trie_s = Seconds(Clock::now() - t0);
+
+  t0 = Clock::now();
+  std::string_view text(stream);
+  sherpa_tts::LexiconMatch matches[8];
+  for (size_t pos = 0; pos < text.size();) {
+    size_t n = lexicon.PrefixMatches(text.substr(pos), matches, 8);
+    if (n > 0) sink += lexicon.EntryIds(matches[n - 1].entry).size;
+    size_t space = text.find(' ', pos);
+    pos = space == std::string_view::npos ? text.size() : space + 1;
+  }
+  double stream_s = Seconds(Clock::now() - t0);
+
+  auto rate = [](double s) { return kQueries / s / 1e6; };
+  std::printf("unordered_map      %.2f Mlookup/s\n", rate(map_s));
+  std::printf("trie lookup        %.2f Mlookup/s\n", rate(trie_s));
+  std::printf("trie longest-match %.2f Mword/s\n", rate(stream_s));
+  std::printf("(checksum %zu)\n", sink);
+  return 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * lexicon-compile：将文本词典（每行 "词 音素1 音素2 ..."）编译为二进制词典。
+ * 生成的文件可直接作为 lexiconPath 传给引擎，由 Lexicon 以 mmap 方式加载。
+ *
+ * 用法：lexicon-compile <input lexicon.txt> <output lexicon.bin>
+ */
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "lexicon.h"
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <input lexicon.txt> <output lexicon.bin>\n",
+                 argv[0]);
+    return 1;
+  }
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+
+  auto t0 = std::chrono::steady_clock::now();
+  sherpa_tts::Lexicon lexicon;
+  if (!lexicon.LoadFromFile(input)) {
+    std::fprintf(stderr, "failed to load lexicon: %s\n", input.c_str());
+    return 1;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  if (!lexicon.SaveBinary(output)) {
+    std::fprintf(stderr, "failed to write binary lexicon: %s\n",
+                 output.c_str());
+    return 1;
+  }
+
+  // 回读校验：确认输出可被 mmap 加载且词条数一致
+  sherpa_tts::Lexicon check;
+  auto t2 = std::chrono::steady_clock::now();
+  if (!check.LoadFromFile(output) || !check.IsMapped() ||
+      check.Size() != lexicon.Size()) {
+    std::fprintf(stderr, "verification failed: %s\n", output.c_str());
+    return 1;
+  }
+  auto t3 = std::chrono::steady_clock::now();
+
+  auto ms = [](auto d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+  };
+  const sherpa_tts::LexiconLoadStats& stats = lexicon.LoadStats();
+  std::printf("entries=%zu symbols=%zu parse_ms=%.2f (%zu lines, %d threads, "
+              "%.0f lines/s) mmap_load_ms=%.3f\n",
+              lexicon.Size(), lexicon.NumSymbols(), ms(t1 - t0), stats.num_lines,
+              stats.num_threads, stats.LinesPerSecond(), ms(t3 - t2));
+  return 0;
+}
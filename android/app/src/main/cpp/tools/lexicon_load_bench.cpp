@@ -0,0 +1,133 @@
+/**
+ * lexicon-load-bench：对比文本词典的加载吞吐（行/秒）。
+ * - getline：逐行 std::getline + ParseLexiconLine（istringstream 切分），再整体构建；
+ * - 1 thread / N threads：Lexicon::LoadFromFile 的分片解析，分别强制单线程与自动线程数。
+ * 三者加载结果须一致（词条数及抽样词条的音素），否则返回非 0。
+ *
+ * 用法：lexicon-load-bench <tokens.txt> [行数，默认 2000000] [并行线程数，默认自动]
+ * 生成的词典约 5% 的行与前文重复（音素不同），用于检验「同词以最后一行为准」。
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lexicon.h"
+#include "token_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Seconds(Clock::duration d) {
+  return std::chrono::duration<double>(d).count();
+}
+
+std::vector<std::string> ReadTokenSymbols(const std::string& path) {
+  std::vector<std::string> symbols;
+  std::ifstream is(path);
+  std::string line;
+  while (std::getline(is, line)) {
+    std::istringstream iss(line);
+    std::string sym;
+    std::string id;
+    if (iss >> sym >> id) symbols.push_back(sym);
+  }
+  return symbols;
+}
+
+std::string GenerateLexicon(const std::vector<std::string>& symbols,
+                            size_t num_lines, std::vector<std::string>* keys) {
+  static const char* kLetters[] = {"а", "б", "в", "г", "д", "е", "ж", "з",
+                                   "и", "к", "л", "м", "н", "о", "п", "р",
+                                   "с", "т", "у", "ф", "х", "ш", "ы", "я"};
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> letter(0, std::size(kLetters) - 1);
+  std::uniform_int_distribution<size_t> sym(0, symbols.size() - 1);
+  std::uniform_int_distribution<int> len(3, 10);
+  auto path = std::filesystem::temp_directory_path() / "lexicon-load-bench.txt";
+  std::ofstream os(path);
+  for (size_t i = 0; i < num_lines; ++i) {
+    std::string key;
+    if (i % 20 == 19) {
+      key = (*keys)[rng() % keys->size()];  // 重复词条，后写覆盖
+    } else {
+      for (int k = len(rng); k > 0; --k) key += kLetters[letter(rng)];
+      key += std::to_string(i);
+      keys->push_back(key);
+    }
+    os << key;
+    for (int k = len(rng); k > 0; --k) os << ' ' << symbols[sym(rng)];
+    os << '\n';
+  }
+  return path.string();
+}
+
+bool LoadByGetline(const std::string& path, const sherpa_tts::TokenTable* tokens,
+                   sherpa_tts::Lexicon* lexicon) {
+  std::ifstream is(path);
+  if (!is) return false;
+  std::vector<sherpa_tts::LexiconEntry> entries;
+  std::string line;
+  sherpa_tts::LexiconEntry entry;
+  while (std::getline(is, line)) {
+    if (sherpa_tts::ParseLexiconLine(line, &entry)) entries.push_back(entry);
+  }
+  return lexicon->LoadFromEntries(entries, tokens);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <tokens.txt> [num_lines] [num_threads]\n",
+                 argv[0]);
+    return 1;
+  }
+  sherpa_tts::TokenTable tokens;
+  if (!tokens.LoadFromFile(argv[1])) {
+    std::fprintf(stderr, "failed to load tokens: %s\n", argv[1]);
+    return 1;
+  }
+  const size_t num_lines = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+  std::vector<std::string> keys;
+  const std::string path =
+      GenerateLexicon(ReadTokenSymbols(argv[1]), num_lines, &keys);
+
+  sherpa_tts::Lexicon legacy;
+  auto t0 = Clock::now();
+  LoadByGetline(path, &tokens, &legacy);
+  const double legacy_s = Seconds(Clock::now() - t0);
+  std::printf("%-10s %8.3f s  %6.2f Mline/s\n", "getline", legacy_s,
+              num_lines / legacy_s / 1e6);
+
+  sherpa_tts::Lexicon serial;
+  sherpa_tts::Lexicon parallel;
+  sherpa_tts::LexiconLoadOptions one_thread;
+  one_thread.num_threads = 1;
+  sherpa_tts::LexiconLoadOptions many_threads;
+  many_threads.num_threads = argc > 3 ? std::atoi(argv[3]) : 0;
+  serial.LoadFromFile(path, &tokens, one_thread);
+  parallel.LoadFromFile(path, &tokens, many_threads);
+  for (const auto* lex : {&serial, &parallel}) {
+    const auto& st = lex->LoadStats();
+    std::printf("%2d thread%s %8.3f s  %6.2f Mline/s\n", st.num_threads,
+                st.num_threads > 1 ? "s" : " ", st.seconds,
+                st.LinesPerSecond() / 1e6);
+  }
+
+  bool ok = legacy.Size() == serial.Size() && legacy.Size() == parallel.Size();
+  for (size_t i = 0; ok && i < keys.size(); i += 97) {
+    auto expected = legacy.GetPhonemes(keys[i]);
+    ok = !expected.empty() && serial.GetPhonemes(keys[i]) == expected &&
+         parallel.GetPhonemes(keys[i]) == expected;
+  }
+  std::printf("entries=%zu %s\n", parallel.Size(), ok ? "match" : "MISMATCH");
+  std::filesystem::remove(path);
+  return ok ? 0 : 1;
+}
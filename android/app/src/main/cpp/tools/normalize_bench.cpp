@@ -0,0 +1,183 @@
+/**
+ * normalize-bench：文本规范化对词典覆盖率的影响与规范化吞吐。
+ * 对输入的每一行分别统计规范化前后的词典命中词数 / 未命中词数，以及整行全部命中
+ * （kLexiconFirst / kHybrid 下无需 espeak）的行数；-v 时打印规范化后的文本与未命中的词。
+ *
+ * --check 时不需要词典，只跑内置的规范化用例（输入 -> 期望输出），有不一致时返回 1。
+ *
+ * 用法：normalize-bench <tokens.txt> <lexicon> <text.txt> [voice=ru] [-v]
+ *       normalize-bench --check
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "lexicon.h"
+#include "text_normalize.h"
+#include "text_segment.h"
+#include "token_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Coverage {
+  size_t hit_words = 0;
+  size_t miss_words = 0;
+  size_t full_lines = 0;
+};
+
+// 统计一行的命中情况；标点片段不计
+void Measure(const std::string& line, const sherpa_tts::Lexicon* lexicon,
+             bool verbose, Coverage* coverage) {
+  std::vector<sherpa_tts::LexiconSegment> segments;
+  sherpa_tts::SegmentWithLexicon(line, &lexicon, 1, &segments);
+  size_t misses = 0;
+  for (const sherpa_tts::LexiconSegment& seg : segments) {
+    if (seg.hit) {
+      ++coverage->hit_words;
+    } else if (!sherpa_tts::IsPunctuationSegment(seg.text)) {
+      ++misses;
+      if (verbose) {
+        std::printf("  miss: %.*s\n", static_cast<int>(seg.text.size()),
+                    seg.text.data());
+      }
+    }
+  }
+  coverage->miss_words += misses;
+  if (misses == 0) ++coverage->full_lines;
+}
+
+struct Case {
+  const char* voice;
+  const char* input;
+  const char* expected;
+};
+
+// 数字只在整词匹配某条规则时展开，否则整词原样保留
+const Case kCases[] = {
+    {"ru", "В 2026 году 5 км.", "В две тысячи двадцать шестом году пять километров."},
+    {"ru", "в 10:30, т.е. утром", "в десять часов тридцать минут, то есть утром"},
+    {"ru", "С 1990 по 2000 гг.",
+     "С тысяча девятьсот девяностого по двухтысячный годы."},
+    {"ru", "в 1990–2000 гг. и 1990-х",
+     "в тысяча девятьсот девяностом-двухтысячном годах и тысяча девятьсот девяностых"},
+    {"ru", "1990 – 2000 годы", "тысяча девятьсот девяностый-двухтысячный годы"},
+    {"ru", "+7 (999) 123-45-67",
+     "плюс семь девятьсот девяносто девять сто двадцать три сорок пять шестьдесят семь"},
+    {"ru", "8 (800) 555-35-35",
+     "восемь восемьсот пятьсот пятьдесят пять тридцать пять тридцать пять"},
+    {"ru", "5-7 лет, 1–2 кг", "пять-семь лет, один-два килограмма"},
+    {"ru", "v1.2.3 и 192.168.0.1", "v1.2.3 и 192.168.0.1"},
+    {"ru", "10:30pm", "10:30pm"},
+    {"ru", "Рост 5'11\".", "Рост 5'11\"."},
+    {"ru", "5-ти 5-й", "5-ти пятый"},
+    {"ru", "в 1990-е годы, 5-е место", "в тысяча девятьсот девяностые годы, пятое место"},
+    {"en", "10:30pm", "ten thirty pee em"},
+    {"en", "at 7 a.m. Then 12:05 AM", "at seven ay em. Then twelve oh five ay em"},
+    {"en", "He is 5'11\" tall", "He is 5'11\" tall"},
+    {"en", "v1.2.3", "v1.2.3"},
+    {"en", "+1 (555) 123-4567", "plus one five five five one two three four five six seven"},
+    {"en", "pages 5-7, 1990-2000", "pages five to seven, nineteen ninety to two thousand"},
+};
+
+int RunChecks() {
+  size_t failures = 0;
+  std::string out;
+  for (const Case& c : kCases) {
+    sherpa_tts::NormalizeText(c.input, sherpa_tts::NormalizeLanguageFromVoice(c.voice),
+                              &out);
+    if (out == c.expected) continue;
+    ++failures;
+    std::printf("FAIL [%s] %s\n  got:      %s\n  expected: %s\n", c.voice, c.input,
+                out.c_str(), c.expected);
+  }
+  std::printf("cases=%zu failures=%zu\n", sizeof(kCases) / sizeof(kCases[0]), failures);
+  return failures == 0 ? 0 : 1;
+}
+
+void Print(const char* name, const Coverage& c, size_t num_lines) {
+  const size_t words = c.hit_words + c.miss_words;
+  std::printf("%-10s hit_words=%zu miss_words=%zu word_hit=%.1f%% full_lines=%zu/%zu\n",
+              name, c.hit_words, c.miss_words,
+              words > 0 ? 100.0 * c.hit_words / words : 0.0, c.full_lines,
+              num_lines);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc == 2 && std::strcmp(argv[1], "--check") == 0) return RunChecks();
+  if (argc < 4) {
+    std::fprintf(stderr,
+                 "usage: %s <tokens.txt> <lexicon> <text.txt> [voice=ru] [-v]\n"
+                 "       %s --check\n",
+                 argv[0], argv[0]);
+    return 1;
+  }
+  const std::string voice = argc > 4 && std::strcmp(argv[4], "-v") != 0 ? argv[4] : "ru";
+  const bool verbose = std::strcmp(argv[argc - 1], "-v") == 0;
+
+  sherpa_tts::TokenTable tokens;
+  if (!tokens.LoadFromFile(argv[1])) {
+    std::fprintf(stderr, "failed to load tokens: %s\n", argv[1]);
+    return 1;
+  }
+  sherpa_tts::Lexicon lexicon;
+  if (!lexicon.LoadFromFile(argv[2], &tokens)) {
+    std::fprintf(stderr, "failed to load lexicon: %s\n", argv[2]);
+    return 1;
+  }
+  std::ifstream is(argv[3]);
+  if (!is) {
+    std::fprintf(stderr, "failed to open text: %s\n", argv[3]);
+    return 1;
+  }
+  std::vector<std::string> lines;
+  size_t bytes = 0;
+  for (std::string line; std::getline(is, line);) {
+    if (line.empty()) continue;
+    bytes += line.size();
+    lines.push_back(std::move(line));
+  }
+
+  const sherpa_tts::NormalizeLanguage language =
+      sherpa_tts::NormalizeLanguageFromVoice(voice);
+  std::printf("voice=%s rules=%s lines=%zu bytes=%zu\n", voice.c_str(),
+              sherpa_tts::NormalizeLanguageToString(language), lines.size(),
+              bytes);
+
+  Coverage before;
+  Coverage after;
+  size_t rewrites = 0;
+  std::string normalized;
+  for (const std::string& line : lines) {
+    Measure(line, &lexicon, false, &before);
+    rewrites += sherpa_tts::NormalizeText(line, language, &normalized);
+    if (verbose) std::printf("%s\n", normalized.c_str());
+    Measure(normalized, &lexicon, verbose, &after);
+  }
+  Print("raw", before, lines.size());
+  Print("normalized", after, lines.size());
+
+  // 吞吐：整份文本重复规范化，至少跑 0.5 秒
+  size_t iterations = 0;
+  size_t sink = 0;
+  const Clock::time_point start = Clock::now();
+  double seconds = 0;
+  do {
+    for (const std::string& line : lines) {
+      sherpa_tts::NormalizeText(line, language, &normalized);
+      sink += normalized.size();
+    }
+    ++iterations;
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (seconds < 0.5);
+  std::printf("rewrites=%zu normalize=%.1f MB/s (%.2f us/line, sink=%zu)\n",
+              rewrites, bytes * iterations / seconds / 1e6,
+              seconds * 1e6 / (iterations * lines.size()), sink);
+  return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * pipeline-bench：对比逐句合成的串行执行与三段流水线的端到端耗时。
+ * - 前端：真实的切词 + 词典查询（词典由段落中的词生成），另加固定耗时模拟 espeak；
+ * - 推理：按 token 数休眠模拟 VITS（ONNX Runtime 在其他核上运行，不占用本线程 CPU），
+ *   并生成相应长度的音频；
+ * - 写出：WaveStreamWriter 写入临时 WAV。
+ *
+ * 用法：pipeline-bench [句数，默认 8] [前端毫秒/句，默认 15] [推理微秒/token，默认 400]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lexicon.h"
+#include "synthesis_pipeline.h"
+#include "text_segment.h"
+#include "token_table.h"
+#include "wave_writer.h"
+
+namespace {
+
+constexpr int32_t kSampleRate = 22050;
+constexpr int32_t kSamplesPerToken = 256;
+
+const char* kSentences[] = {
+    "Привет, мир!",
+    "Съешь же ещё этих мягких французских булок, да выпей чаю.",
+    "Сегодня хорошая погода, и мы идём гулять в парк.",
+    "В лесу родилась ёлочка, в лесу она росла.",
+    "Зимой и летом стройная, зелёная была.",
+    "Мороз и солнце; день чудесный!",
+    "Ещё ты дремлешь, друг прелестный?",
+    "Пора, красавица, проснись.",
+};
+
+int Run(const std::vector<std::string>& sentences, bool pipelined,
+        int frontend_ms, int vits_us_per_token, const sherpa_tts::Lexicon& lexicon,
+        const sherpa_tts::TokenTable& tokens, sherpa_tts::PipelineStats* stats) {
+  auto path = std::filesystem::temp_directory_path() / "pipeline-bench.wav";
+  sherpa_tts::WaveStreamWriter wav;
+  if (!wav.Open(path.string(), kSampleRate)) return 1;
+
+  auto frontend = [&](const std::string& s, std::vector<int64_t>* ids) {
+    *ids = sherpa_tts::TextToTokenIds(s, &lexicon, &tokens);
+    std::this_thread::sleep_for(std::chrono::milliseconds(frontend_ms));
+    return ids->empty() ? 1 : 0;
+  };
+  auto inference = [&](const std::vector<int64_t>& ids, std::vector<float>* out) {
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(vits_us_per_token * ids.size()));
+    out->resize(ids.size() * kSamplesPerToken);
+    for (size_t i = 0; i < out->size(); ++i) {
+      (*out)[i] = 0.3f * std::sin(static_cast<float>(i) * 0.05f);
+    }
+    return 0;
+  };
+  auto writer = [&](size_t, const std::vector<float>& samples) {
+    return wav.Append(samples.data(), static_cast<int32_t>(samples.size())) ? 0 : 1;
+  };
+
+  sherpa_tts::PipelineOptions options;
+  options.pipelined = pipelined;
+  int code = sherpa_tts::RunSentencePipeline(sentences, options, frontend,
+                                             inference, writer, stats);
+  if (!wav.Close()) code = code ? code : 1;
+  std::filesystem::remove(path);
+  return code;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t num_sentences = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+  const int frontend_ms = argc > 2 ? std::atoi(argv[2]) : 15;
+  const int vits_us_per_token = argc > 3 ? std::atoi(argv[3]) : 400;
+
+  // 每个字母一个 token；词典把段落中的每个词映射到其字母序列
+  auto tokens_path = std::filesystem::temp_directory_path() / "pipeline-bench-tokens.txt";
+  std::vector<std::string> sentences;
+  std::vector<sherpa_tts::LexiconEntry> entries;
+  std::vector<std::string> symbols;
+  for (size_t i = 0; i < num_sentences; ++i) {
+    sentences.push_back(kSentences[i % std::size(kSentences)]);
+    std::vector<std::string_view> words;
+    sherpa_tts::SplitWords(sentences.back(), &words);
+    for (std::string_view w : words) {
+      if (sherpa_tts::IsPunctuationSegment(w)) continue;
+      sherpa_tts::LexiconEntry e;
+      e.word = std::string(w);
+      for (size_t k = 0; k < w.size();) {
+        char32_t cp;
+        size_t n = sherpa_tts::DecodeUtf8(w, k, &cp);
+        e.phonemes.emplace_back(w.substr(k, n));
+        symbols.push_back(e.phonemes.back());
+        k += n;
+      }
+      entries.push_back(std::move(e));
+    }
+  }
+  {
+    FILE* f = std::fopen(tokens_path.string().c_str(), "w");
+    if (!f) return 1;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+      std::fprintf(f, "%s %zu\n", symbols[i].c_str(), i);
+    }
+    std::fclose(f);
+  }
+  sherpa_tts::TokenTable tokens;
+  tokens.LoadFromFile(tokens_path.string());
+  std::filesystem::remove(tokens_path);
+  sherpa_tts::Lexicon lexicon;
+  lexicon.LoadFromEntries(entries, &tokens);
+
+  sherpa_tts::PipelineStats serial;
+  sherpa_tts::PipelineStats pipelined;
+  if (Run(sentences, false, frontend_ms, vits_us_per_token, lexicon, tokens, &serial) != 0 ||
+      Run(sentences, true, frontend_ms, vits_us_per_token, lexicon, tokens, &pipelined) != 0) {
+    std::fprintf(stderr, "pipeline failed\n");
+    return 1;
+  }
+  for (const auto* st : {&serial, &pipelined}) {
+    std::printf("%-9s total %7.1f ms  first audio %6.1f ms  (frontend %6.1f  vits %6.1f  write %5.1f ms)\n",
+                st == &serial ? "serial" : "pipelined", st->total_seconds * 1e3,
+                st->first_audio_seconds * 1e3, st->frontend_seconds * 1e3,
+                st->inference_seconds * 1e3, st->writer_seconds * 1e3);
+  }
+  std::printf("sentences=%zu speedup=%.2fx\n", num_sentences,
+              serial.total_seconds / pipelined.total_seconds);
+  return 0;
+}
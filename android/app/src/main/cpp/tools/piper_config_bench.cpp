@@ -0,0 +1,128 @@
+/**
+ * piper-config-bench：Piper model.onnx.json 的加载耗时，对比同样内容的 tokens.txt。
+ * 不给文件时生成一份典型配置（约 150 个音素，非 ASCII 键按 Python json.dump 默认写成 \uXXXX）
+ * 及内容相同的 tokens.txt，并校验从两种格式得到的 TokenTable 指纹一致。
+ *
+ * 用法：piper-config-bench [model.onnx.json]
+ */
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "piper_config.h"
+#include "token_table.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 生成配置：ASCII 标点与字母、IPA 扩展区（U+0250..U+02AF）、修饰符与组合符号
+std::string MakeConfig(std::string* tokens_txt) {
+  std::vector<char32_t> symbols = {U'_', U'^', U'$', U' ', U'!', U'\'', U'(', U')',
+                                   U',', U'-', U'.', U':', U';', U'?'};
+  for (char32_t c = U'a'; c <= U'z'; ++c) symbols.push_back(c);
+  for (char32_t c = 0x250; c <= 0x2AF; ++c) symbols.push_back(c);
+  for (char32_t c : {0x2B0, 0x2B2, 0x2B7, 0x2BC, 0x2C8, 0x2CC, 0x2D0, 0x2D1,
+                     0x303, 0x329, 0x32A, 0x361, 0x3B2, 0x3B8, 0x2191, 0x2193}) {
+    symbols.push_back(c);
+  }
+  std::ostringstream json;
+  json << "{\n  \"audio\": {\"sample_rate\": 22050, \"quality\": \"medium\"},\n"
+       << "  \"espeak\": {\"voice\": \"ru\"},\n"
+       << "  \"inference\": {\"noise_scale\": 0.667, \"length_scale\": 1.1, \"noise_w\": 0.8},\n"
+       << "  \"phoneme_type\": \"espeak\",\n  \"phoneme_map\": {},\n"
+       << "  \"phoneme_id_map\": {\n";
+  for (size_t i = 0; i < symbols.size(); ++i) {
+    const char32_t c = symbols[i];
+    char key[16];
+    if (c == U'"' || c == U'\\') {
+      std::snprintf(key, sizeof(key), "\\%c", static_cast<char>(c));
+    } else if (c < 0x80) {
+      std::snprintf(key, sizeof(key), "%c", static_cast<char>(c));
+    } else {
+      std::snprintf(key, sizeof(key), "\\u%04x", static_cast<unsigned>(c));
+    }
+    json << "    \"" << key << "\": [\n      " << i << "\n    ]"
+         << (i + 1 < symbols.size() ? ",\n" : "\n");
+    // tokens.txt 中同一符号：直接写 UTF-8
+    std::string utf8;
+    if (c < 0x80) {
+      utf8.push_back(static_cast<char>(c));
+    } else if (c < 0x800) {
+      utf8.push_back(static_cast<char>(0xC0 | (c >> 6)));
+      utf8.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else {
+      utf8.push_back(static_cast<char>(0xE0 | (c >> 12)));
+      utf8.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      utf8.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+    *tokens_txt += c == U' ' ? std::to_string(i) : utf8 + " " + std::to_string(i);
+    *tokens_txt += "\n";
+  }
+  json << "  },\n  \"num_symbols\": 256,\n  \"num_speakers\": 1,\n"
+       << "  \"speaker_id_map\": {},\n  \"piper_version\": \"1.0.0\",\n"
+       << "  \"language\": {\"code\": \"ru_RU\", \"family\": \"ru\"},\n"
+       << "  \"dataset\": \"synthetic\"\n}\n";
+  return json.str();
+}
+
+template <typename Fn>
+double MeasureMicros(Fn&& fn) {
+  size_t iterations = 0;
+  const Clock::time_point start = Clock::now();
+  double seconds = 0;
+  do {
+    fn();
+    ++iterations;
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (seconds < 0.3);
+  return seconds * 1e6 / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto dir = std::filesystem::temp_directory_path();
+  std::string json_path;
+  std::string tokens_path;
+  if (argc > 1) {
+    json_path = argv[1];
+  } else {
+    std::string tokens_txt;
+    const std::string json = MakeConfig(&tokens_txt);
+    json_path = (dir / "piper-config-bench.onnx.json").string();
+    tokens_path = (dir / "piper-config-bench-tokens.txt").string();
+    std::ofstream(json_path) << json;
+    std::ofstream(tokens_path) << tokens_txt;
+  }
+
+  sherpa_tts::PiperVoiceConfig config;
+  sherpa_tts::TokenTable table;
+  if (!sherpa_tts::LoadPiperVoiceConfig(json_path, &config, &table)) {
+    std::fprintf(stderr, "failed to parse: %s\n", json_path.c_str());
+    return 1;
+  }
+  std::printf("phonemes=%zu tokens=%zu max_id=%lld sample_rate=%d scales=%.3f/%.3f/%.3f voice=%s type=%s\n",
+              config.num_phonemes, table.Size(),
+              static_cast<long long>(table.MaxId()), config.sample_rate,
+              config.noise_scale, config.length_scale, config.noise_w,
+              config.espeak_voice.c_str(), config.phoneme_type.c_str());
+
+  const double json_us = MeasureMicros([&] {
+    sherpa_tts::LoadPiperVoiceConfig(json_path, &config, &table);
+  });
+  std::printf("onnx.json load: %.1f us\n", json_us);
+
+  if (!tokens_path.empty()) {
+    sherpa_tts::TokenTable from_txt;
+    const double txt_us = MeasureMicros([&] { from_txt.LoadFromFile(tokens_path); });
+    std::printf("tokens.txt load: %.1f us (fingerprint %s)\n", txt_us,
+                from_txt.Fingerprint() == table.Fingerprint() ? "match" : "MISMATCH");
+    if (from_txt.Fingerprint() != table.Fingerprint()) return 1;
+  }
+  return 0;
+}
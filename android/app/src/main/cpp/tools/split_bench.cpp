@@ -0,0 +1,132 @@
+/**
+ * split-bench：对比切词吞吐（字符/秒）。
+ * - legacy：旧实现（逐字符 substr、逐字符拼接、ispunct + unordered_set<string> 查非 ASCII 标点）；
+ * - table：text_segment 的 SplitWords（单次 UTF-8 解码 + 码点分类表，返回 string_view）。
+ *
+ * 用法：split-bench [重复次数]
+ */
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "text_segment.h"
+
+namespace {
+
+namespace legacy {
+
+size_t Utf8CharLen(const std::string& s, size_t pos) {
+  if (pos >= s.size()) return 0;
+  unsigned char c = static_cast<unsigned char>(s[pos]);
+  if (c < 0x80) return 1;
+  if (c < 0xc2) return 1;
+  if (c < 0xe0) return (pos + 2 <= s.size()) ? 2 : 1;
+  if (c < 0xf0) return (pos + 3 <= s.size()) ? 3 : 1;
+  if (c < 0xf8) return (pos + 4 <= s.size()) ? 4 : 1;
+  return 1;
+}
+
+bool IsUnicodePunct(const std::string& ch) {
+  static const std::unordered_set<std::string> kPunct = {
+      "，", "。", "！", "？", "；", "：", "、", "…", "—", "–",
+      "（", "）", "《", "》", "【", "】", "「", "」", "『", "』",
+      "\xEF\xBC\x8C", "\xEF\xBC\x8E", "\xEF\xBC\x81", "\xEF\xBC\x9F",
+      "\xEF\xBC\x9B", "\xEF\xBC\x9A", "\xEF\xBC\x88", "\xEF\xBC\x89",
+      "\xEF\xBD\x9E", "\xC2\xAB", "\xC2\xBB", "\xE2\x80\xB9", "\xE2\x80\xBA",
+      "\xE2\x80\x9A", "\xE2\x80\x9E", "\xE2\x80\x9C", "\xE2\x80\x9D",
+      "\xE2\x80\x98", "\xE2\x80\x99", "\xC2\xB4", "\xE2\x80\x90",
+      "\xE2\x80\x91", "\xC2\xA1", "\xC2\xBF", "\xC2\xB7", "\xE2\x80\x93",
+      "\xE2\x80\x94", "\xE2\x80\xA6",
+  };
+  return kPunct.count(ch) != 0;
+}
+
+std::vector<std::string> SplitWords(const std::string& text) {
+  std::vector<std::string> words;
+  std::string cur;
+  for (size_t i = 0; i < text.size();) {
+    size_t clen = Utf8CharLen(text, i);
+    if (clen == 0) break;
+    std::string ch = text.substr(i, clen);
+    if (clen == 1) {
+      unsigned char c = static_cast<unsigned char>(text[i]);
+      if (std::isspace(c)) {
+        if (!cur.empty()) {
+          words.push_back(std::move(cur));
+          cur.clear();
+        }
+      } else if (std::ispunct(c)) {
+        if (!cur.empty()) {
+          words.push_back(std::move(cur));
+          cur.clear();
+        }
+        words.push_back(std::move(ch));
+      } else {
+        cur += ch;
+      }
+    } else {
+      if (IsUnicodePunct(ch)) {
+        if (!cur.empty()) {
+          words.push_back(std::move(cur));
+          cur.clear();
+        }
+        words.push_back(std::move(ch));
+      } else {
+        cur += ch;
+      }
+    }
+    i += clen;
+  }
+  if (!cur.empty()) words.push_back(std::move(cur));
+  return words;
+}
+
+}  // namespace legacy
+
+size_t CountChars(const std::string& s) {
+  size_t n = 0;
+  for (unsigned char c : s) n += (c & 0xC0) != 0x80;
+  return n;
+}
+
+void Run(const char* name, const std::string& unit, int repeat) {
+  std::string text;
+  for (int i = 0; i < 200; ++i) text += unit;
+  const double chars = static_cast<double>(CountChars(text)) * repeat;
+
+  size_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; ++r) sink += legacy::SplitWords(text).size();
+  auto t1 = std::chrono::steady_clock::now();
+  std::vector<std::string_view> words;
+  for (int r = 0; r < repeat; ++r) {
+    sherpa_tts::SplitWords(text, &words);
+    sink += words.size();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  auto rate = [chars](auto d) {
+    return chars / std::chrono::duration<double>(d).count() / 1e6;
+  };
+  std::printf("%-9s legacy %7.1f Mchar/s   table %7.1f Mchar/s   (%zu)\n", name,
+              rate(t1 - t0), rate(t2 - t1), sink);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int repeat = argc > 1 ? std::atoi(argv[1]) : 2000;
+  Run("cyrillic",
+      "Привет, мир! Съешь же ещё этих мягких французских булок, да выпей чаю. ",
+      repeat);
+  Run("cjk", "你好，世界！今天天气很好，我们一起去公园散步吧。「测试」文本。",
+      repeat);
+  Run("latin", "Hello, world! The quick brown fox jumps over the lazy dog. ",
+      repeat);
+  return 0;
+}
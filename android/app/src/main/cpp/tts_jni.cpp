@@ -3,18 +3,31 @@
  * 若未链接 ONNX Runtime（未定义 SHERPA_TTS_USE_ONNXRUNTIME），则为占位实现。
  */
 #include <jni.h>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <android/log.h>
 #define LOG_TAG "SherpaTts"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
 
 #if defined(SHERPA_TTS_USE_ONNXRUNTIME)
+#include "espeak_phonemize.h"
+#include "espeak_word_cache.h"
+#include "frontend_cache.h"
 #include "frontend_router.h"
+#include "g2p_engine.h"
 #include "lexicon.h"
+#include "lexicon_store.h"
+#include "piper_config.h"
+#include "synthesis_pipeline.h"
+#include "text_normalize.h"
+#include "text_segment.h"
 #include "token_table.h"
 #include "vits_engine.h"
 #include "wave_writer.h"
@@ -36,6 +49,23 @@ constexpr jint kErrInvalidHandle = -100;
 constexpr jint kErrInvalidInput = -101;
 constexpr jint kErrVitsRunEmpty = -102;
 constexpr jint kErrWriteWave = -103;
+constexpr jint kErrLexiconLoad = -104;
+
+// 逐句合成时句间插入的静音
+constexpr float kSentenceSilenceSeconds = 0.2f;
+
+void LogLexiconLoaded(const char* where, const sherpa_tts::Lexicon& lexicon) {
+  const sherpa_tts::LexiconLoadStats& stats = lexicon.LoadStats();
+  LOGI("%s: lexicon entries=%zu mapped=%d lines=%zu threads=%d %.1f ms (%.0f lines/s)",
+       where, lexicon.Size(), lexicon.IsMapped() ? 1 : 0, stats.num_lines,
+       stats.num_threads, stats.seconds * 1000.0, stats.LinesPerSecond());
+  if (lexicon.NumEntriesWithUnknown() > 0) {
+    const auto& unknown = lexicon.UnknownSymbols();
+    LOGW("%s: lexicon 中 %zu 个词条含 tokens 未收录的音素，已跳过；未知符号 %zu 个，首个=%s",
+         where, lexicon.NumEntriesWithUnknown(), unknown.size(),
+         unknown.empty() ? "" : unknown.front().c_str());
+  }
+}
 #endif
 
 }  // namespace
@@ -43,13 +73,51 @@ constexpr jint kErrWriteWave = -103;
 #if defined(SHERPA_TTS_USE_ONNXRUNTIME)
 struct TtsHandle {
   sherpa_tts::TokenTable token_table;
-  sherpa_tts::Lexicon lexicon;
+  // 可在 nativeGenerate 运行期间热替换；每次生成取一次快照
+  sherpa_tts::LexiconStore lexicon{&token_table};
+  // 文本 -> token id 的结果缓存；词典重载 / 增量修改时清空
+  sherpa_tts::FrontendCache frontend_cache;
   std::unique_ptr<sherpa_tts::VitsEngine> vits;
+  // 词典未命中词的 G2P 模型（kNeuralG2p 使用，未配置或加载失败时为空）
+  std::unique_ptr<sherpa_tts::G2pEngine> g2p;
+  // Piper "text" 音色：文本逐码点映射为 id（TextCodepointsToTokenIds），不走词典与 espeak
+  bool text_phonemes = false;
   int32_t speaker_id = 0;
   std::string data_dir;
   std::string voice = "ru";
+  // 由 voice 决定的数字 / 缩写展开规则（kEspeakOnly 时不做，交给 espeak 自己处理）
+  sherpa_tts::NormalizeLanguage normalize_language =
+      sherpa_tts::NormalizeLanguage::kRussian;
   sherpa_tts::FrontendMode frontend_mode = sherpa_tts::FrontendMode::kAuto;
 };
+
+namespace {
+
+// 直接输入（token id / 音素串）的合成：不切句、不走前端缓存，一次推理写出整段 WAV。
+// 返回采样率，失败返回与 nativeGenerate 相同的错误码。
+jint SynthesizeTokenIds(TtsHandle* h, const std::vector<int64_t>& ids,
+                        float speed, const std::string& out_path,
+                        const char* where) {
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<float> samples = h->vits->Run(ids, h->speaker_id, speed);
+  if (samples.empty()) {
+    LOGW("%s: VITS Run 返回空", where);
+    return kErrVitsRunEmpty;
+  }
+  const int32_t sample_rate = h->vits->SampleRate();
+  if (!sherpa_tts::WriteWave(out_path, sample_rate, samples)) {
+    LOGW("%s: WriteWave 失败 path=%s", where, out_path.c_str());
+    return kErrWriteWave;
+  }
+  LOGI("%s: tokens=%zu samples=%zu total=%.1f ms", where, ids.size(),
+       samples.size(),
+       std::chrono::duration<double, std::milli>(
+           std::chrono::steady_clock::now() - start)
+           .count());
+  return static_cast<jint>(sample_rate);
+}
+
+}  // namespace
 #endif
 
 extern "C" {
@@ -57,19 +125,25 @@ extern "C" {
 JNIEXPORT jlong JNICALL
 Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeCreate(
     JNIEnv* env, jobject /* thiz */, jstring modelPath, jstring tokensPath,
-    jstring dataDir, jstring lexiconPath, jint frontendMode, jstring voice,
-    jint speakerId, jfloat speed, jint numThreads, jboolean debug) {
+    jstring dataDir, jstring lexiconPath, jstring userLexiconPath,
+    jstring g2pModelPath, jint frontendMode, jstring voice,
+    jint speakerId, jfloat speed, jint numThreads, jint espeakWorkers,
+    jstring espeakCacheDir, jboolean debug) {
 #if !defined(SHERPA_TTS_USE_ONNXRUNTIME)
   (void)env;
   (void)modelPath;
   (void)tokensPath;
   (void)dataDir;
   (void)lexiconPath;
+  (void)userLexiconPath;
+  (void)g2pModelPath;
   (void)frontendMode;
   (void)voice;
   (void)speakerId;
   (void)speed;
   (void)numThreads;
+  (void)espeakWorkers;
+  (void)espeakCacheDir;
   (void)debug;
   LOGW("nativeCreate: 当前为占位构建，未链接 ONNX Runtime。请设置 ONNXRUNTIME_ROOT 并重新编译以启用 TTS。");
   return 0;
@@ -81,6 +155,8 @@ Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeCreate(
   std::string tokens = JstringToStd(env, tokensPath);
   std::string data_dir = JstringToStd(env, dataDir);
   std::string lexicon = JstringToStd(env, lexiconPath);
+  std::string user_lexicon = JstringToStd(env, userLexiconPath);
+  std::string g2p_model = JstringToStd(env, g2pModelPath);
   std::string voice_str = JstringToStd(env, voice);
 
   if (model.empty() || tokens.empty()) {
@@ -91,32 +167,124 @@ Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeCreate(
   auto h = std::make_unique<TtsHandle>();
   h->data_dir = data_dir;
   h->voice = voice_str.empty() ? "ru" : voice_str;
+  h->normalize_language = sherpa_tts::NormalizeLanguageFromVoice(h->voice);
   if (frontendMode < static_cast<jint>(sherpa_tts::FrontendMode::kAuto) ||
-      frontendMode > static_cast<jint>(sherpa_tts::FrontendMode::kEspeakOnly)) {
+      frontendMode > static_cast<jint>(sherpa_tts::FrontendMode::kNeuralG2p)) {
     LOGW("nativeCreate: frontendMode 非法=%d，回退为 auto", frontendMode);
     h->frontend_mode = sherpa_tts::FrontendMode::kAuto;
   } else {
     h->frontend_mode = static_cast<sherpa_tts::FrontendMode>(frontendMode);
   }
-  if (!h->token_table.LoadFromFile(tokens)) {
+  sherpa_tts::VitsConfig vits_config;
+  vits_config.model_path = model;
+  vits_config.num_threads = numThreads > 0 ? numThreads : 1;
+
+  // "builtin:<name>" 使用编译进库的 tokens 表（见 builtin_token_tables.cpp），不读文件；
+  // "*.json" 为 Piper 的 model.onnx.json，同时给出推理参数与 espeak voice
+  constexpr std::string_view kBuiltinPrefix = "builtin:";
+  if (sherpa_tts::IsPiperVoiceConfigPath(tokens)) {
+    sherpa_tts::PiperVoiceConfig piper;
+    const auto start = std::chrono::steady_clock::now();
+    if (!sherpa_tts::LoadPiperVoiceConfig(tokens, &piper, &h->token_table)) {
+      LOGW("nativeCreate: 解析 Piper 配置失败 path=%s", tokens.c_str());
+      return 0;
+    }
+    LOGI("nativeCreate: Piper 配置 phonemes=%zu sample_rate=%d scales=%.3f/%.3f/%.3f voice=%s phoneme_type=%s speakers=%d %.3f ms",
+         piper.num_phonemes, piper.sample_rate, piper.noise_scale,
+         piper.length_scale, piper.noise_w, piper.espeak_voice.c_str(),
+         piper.phoneme_type.c_str(), piper.num_speakers,
+         std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count());
+    vits_config.noise_scale = piper.noise_scale;
+    vits_config.length_scale = piper.length_scale;
+    vits_config.noise_scale_w = piper.noise_w;
+    vits_config.sample_rate = piper.sample_rate;
+    vits_config.piper_inputs = true;
+    vits_config.num_speakers = piper.num_speakers;
+    if (piper.phoneme_type == "text") {
+      h->text_phonemes = true;
+    } else if (piper.phoneme_type != "espeak") {
+      LOGW("nativeCreate: 不支持的 Piper phoneme_type=%s path=%s",
+           piper.phoneme_type.c_str(), tokens.c_str());
+      return 0;
+    }
+    // 音色自带的 espeak voice 优先于调用方传入的 voice
+    if (!piper.espeak_voice.empty() && piper.espeak_voice != h->voice) {
+      LOGI("nativeCreate: voice %s -> %s（来自 Piper 配置）", h->voice.c_str(),
+           piper.espeak_voice.c_str());
+      h->voice = piper.espeak_voice;
+      h->normalize_language = sherpa_tts::NormalizeLanguageFromVoice(h->voice);
+    }
+  } else if (std::string_view(tokens).substr(0, kBuiltinPrefix.size()) == kBuiltinPrefix) {
+    const sherpa_tts::BuiltinTokenTable* builtin = sherpa_tts::FindBuiltinTokenTable(
+        std::string_view(tokens).substr(kBuiltinPrefix.size()));
+    if (!builtin) {
+      LOGW("nativeCreate: 没有内置 tokens 表 %s", tokens.c_str());
+      return 0;
+    }
+    h->token_table.UseBuiltin(*builtin);
+  } else if (!h->token_table.LoadFromFile(tokens)) {
     LOGW("nativeCreate: 加载 tokens 失败 path=%s", tokens.c_str());
     return 0;
   }
 
-  if (!lexicon.empty()) {
-    h->lexicon.LoadFromFile(lexicon);
+  // 基础词典在进程内共享（多个句柄只加载 / 映射一次），用户词典叠加其上
+  const std::pair<sherpa_tts::LexiconLayer, const std::string*> layers[] = {
+      {sherpa_tts::LexiconLayer::kBase, &lexicon},
+      {sherpa_tts::LexiconLayer::kUser, &user_lexicon},
+  };
+  for (const auto& layer : layers) {
+    if (layer.second->empty()) continue;
+    std::shared_ptr<const sherpa_tts::Lexicon> loaded;
+    if (!h->lexicon.Reload(layer.first, *layer.second, &loaded)) {
+      LOGW("nativeCreate: 加载 lexicon 失败 path=%s", layer.second->c_str());
+    } else {
+      LogLexiconLoaded("nativeCreate", *loaded);
+    }
   }
 
-  sherpa_tts::VitsConfig vits_config;
-  vits_config.model_path = model;
-  vits_config.num_threads = numThreads > 0 ? numThreads : 1;
   h->vits = std::make_unique<sherpa_tts::VitsEngine>(vits_config);
   if (h->vits->SampleRate() <= 0) {
     LOGW("nativeCreate: VITS 模型加载失败或 sample_rate=0 path=%s", model.c_str());
     return 0;
   }
 
-  h->speaker_id = speakerId;
+  if (!g2p_model.empty()) {
+    sherpa_tts::G2pConfig g2p_config;
+    g2p_config.model_path = g2p_model;
+    g2p_config.num_threads = 1;  // 每次只有少量未命中词，单线程即可，避免与 VITS 抢核
+    h->g2p = std::make_unique<sherpa_tts::G2pEngine>(g2p_config, &h->token_table);
+    if (!h->g2p->IsLoaded()) {
+      LOGW("nativeCreate: G2P 模型加载失败或缺少元数据 path=%s，未命中词改由 espeak 处理",
+           g2p_model.c_str());
+      h->g2p.reset();
+    }
+  } else if (h->frontend_mode == sherpa_tts::FrontendMode::kNeuralG2p) {
+    LOGW("nativeCreate: neural_g2p 模式未配置 G2P 模型，未命中词改由 espeak 处理");
+  }
+
+  // espeak 实例在进程内共享：提前加载，首个请求不必付加载库的开销
+  if (!h->data_dir.empty() && !h->text_phonemes &&
+      h->frontend_mode != sherpa_tts::FrontendMode::kLexiconFirst) {
+    const int32_t workers =
+        sherpa_tts::ReserveEspeakWorkers(espeakWorkers > 0 ? espeakWorkers : 1);
+    if (workers < espeakWorkers) {
+      LOGW("nativeCreate: espeak 实例 %d 个（请求 %d 个）", workers, espeakWorkers);
+    }
+    // 词级缓存的持久化目录（进程内共享，以最后创建的引擎为准；空串关闭）
+    sherpa_tts::EspeakWordCache::Global().SetPersistentDir(
+        JstringToStd(env, espeakCacheDir));
+  }
+
+  // 说话人数已知（模型元数据或 Piper 配置）时校验 sid；单说话人模型的 sid 输入只能为 0
+  const int32_t num_speakers = h->vits->NumSpeakers();
+  if (num_speakers > 0 && (speakerId < 0 || speakerId >= num_speakers)) {
+    LOGW("nativeCreate: speakerId=%d 超出说话人数 %d，改用 0", speakerId, num_speakers);
+    h->speaker_id = 0;
+  } else {
+    h->speaker_id = speakerId;
+  }
   return reinterpret_cast<jlong>(h.release());
 #endif
 }
@@ -144,34 +312,359 @@ Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeGenerate(
     return kErrInvalidInput;
   }
 
-  sherpa_tts::FrontendResult front = sherpa_tts::RouteTextToTokenIds(
-      text_str, h->data_dir, h->voice, h->frontend_mode, &h->lexicon,
-      &h->token_table);
-  if (front.code != sherpa_tts::FrontendErrorCode::kOk) {
-    LOGW("nativeGenerate: FrontendFail code=%s mode=%s text_len=%zu token_table=%zu lexicon=%zu data_dir_empty=%d voice=%s lexicon_tokens=%d espeak_phonemes=%d espeak_matched=%d",
-         sherpa_tts::FrontendErrorCodeToString(front.code),
-         sherpa_tts::FrontendModeToString(h->frontend_mode), text_str.size(),
-         h->token_table.Size(), h->lexicon.Size(), h->data_dir.empty() ? 1 : 0,
-         h->voice.c_str(), front.lexicon_token_count, front.espeak_phoneme_count,
-         front.espeak_matched_count);
-    return -static_cast<jint>(front.code);
+  // 持有快照直到本次生成结束；期间的重载 / 增量修改只影响之后的请求
+  std::shared_ptr<const sherpa_tts::LexiconSnapshot> lexicon =
+      h->lexicon.Current();
+
+  // 先展开数字与缩写再切句（"т.е." 等缩写点不会被当作句末）
+  std::string normalized;
+  size_t num_normalized = 0;
+  std::string_view input = text_str;
+  if (h->frontend_mode != sherpa_tts::FrontendMode::kEspeakOnly &&
+      h->normalize_language != sherpa_tts::NormalizeLanguage::kNone) {
+    num_normalized = sherpa_tts::NormalizeText(text_str, h->normalize_language,
+                                               &normalized);
+    input = normalized;
   }
 
-  std::vector<float> samples = h->vits->Run(front.token_ids, h->speaker_id, speed);
-  if (samples.empty()) {
-    LOGW("nativeGenerate: VITS Run 返回空");
-    return kErrVitsRunEmpty;
+  // 按句流水线：前端、推理、写出三段重叠执行，音频逐句追加到同一个 WAV
+  std::vector<std::string_view> parts;
+  sherpa_tts::SplitSentences(input, &parts);
+  std::vector<std::string> sentences(parts.begin(), parts.end());
+  if (sentences.empty()) {
+    LOGW("nativeGenerate: text 只含空白");
+    return kErrInvalidInput;
   }
+  const int32_t sample_rate = h->vits->SampleRate();
+  sherpa_tts::WaveStreamWriter wav;
+  if (!wav.Open(out_path, sample_rate)) {
+    LOGW("nativeGenerate: 打开输出文件失败 path=%s", out_path.c_str());
+    return kErrWriteWave;
+  }
+  const int32_t silence =
+      static_cast<int32_t>(sample_rate * kSentenceSilenceSeconds);
 
-  int32_t sample_rate = h->vits->SampleRate();
-  if (!sherpa_tts::WriteWave(out_path, sample_rate, samples)) {
+  // 先按整段文本（切句前）查前端缓存，命中时各句直接交出缓存的分段；
+  // 未命中时逐句查缓存或计算，并记下各句的分段，全部成功后整段写入缓存
+  const bool use_cache = !h->text_phonemes;
+  sherpa_tts::SentenceChunks cached_chunks;
+  const bool text_hit =
+      use_cache && h->frontend_cache.GetText(std::string(input), h->voice, h->frontend_mode,
+                                             lexicon.get(), &h->token_table,
+                                             &cached_chunks) &&
+      cached_chunks.size() == sentences.size();
+  sherpa_tts::SentenceChunks emitted_chunks(use_cache && !text_hit ? sentences.size() : 0);
+
+  // espeak 整句路径逐子句分段：首个子句音素化完即开始推理，其余子句同时在前端线程上音素化
+  //（各段独立带 "^" / "$"）。emit 不阻塞，不会在等待推理时占住 espeak 实例。
+  // 只含标点的句子（如单独的 "..."）读不出音，跳过；其余句子前端失败即整体失败，不静默丢句
+  auto frontend = [&](size_t index, const std::string& sentence,
+                      const sherpa_tts::PipelineEmitFn& emit) {
+    if (sherpa_tts::IsPunctuationOnly(sentence)) return 0;
+    if (text_hit) {
+      for (std::vector<int64_t>& ids : cached_chunks[index]) {
+        if (!emit(std::move(ids))) break;
+      }
+      return 0;
+    }
+    sherpa_tts::FrontendResult front;
+    if (h->text_phonemes) {
+      front = sherpa_tts::TextCodepointsToTokenIds(sentence, &h->token_table);
+      if (front.code == sherpa_tts::FrontendErrorCode::kOk) emit(std::move(front.token_ids));
+    } else {
+      front = h->frontend_cache.RouteChunks(
+          sentence, h->data_dir, h->voice, h->frontend_mode, lexicon.get(),
+          &h->token_table, h->g2p.get(), [&](std::vector<int64_t>&& ids) {
+            emitted_chunks[index].push_back(ids);
+            return emit(std::move(ids));
+          });
+    }
+    if (front.code != sherpa_tts::FrontendErrorCode::kOk) {
+      LOGW("nativeGenerate: FrontendFail code=%s mode=%s text_len=%zu token_table=%zu lexicon=%zu data_dir_empty=%d voice=%s lexicon_tokens=%d espeak_phonemes=%d espeak_matched=%d lexicon_words=%d espeak_words=%d g2p_words=%d g2p_phonemes=%d",
+           sherpa_tts::FrontendErrorCodeToString(front.code),
+           sherpa_tts::FrontendModeToString(h->frontend_mode), sentence.size(),
+           h->token_table.Size(), lexicon->NumEntries(), h->data_dir.empty() ? 1 : 0,
+           h->voice.c_str(), front.lexicon_token_count, front.espeak_phoneme_count,
+           front.espeak_matched_count, front.lexicon_word_count,
+           front.espeak_word_count, front.g2p_word_count,
+           front.g2p_phoneme_count);
+      return -static_cast<int>(front.code);
+    }
+    return 0;
+  };
+  auto inference = [&](const std::vector<int64_t>& ids,
+                       std::vector<float>* samples) {
+    *samples = h->vits->Run(ids, h->speaker_id, speed);
+    if (samples->empty()) {
+      LOGW("nativeGenerate: VITS Run 返回空");
+      return static_cast<int>(kErrVitsRunEmpty);
+    }
+    return 0;
+  };
+  size_t last_index = sentences.size();
+  auto writer = [&](size_t index, const std::vector<float>& samples) {
+    // 句间补一段静音（整段推理时由模型在句末标点处自行停顿）；同一句的各段之间不补，
+    // 子句末的 "," 等标点已让模型生成停顿
+    const bool new_sentence = index != last_index;
+    last_index = index;
+    bool ok = (!new_sentence || wav.NumSamples() == 0 || wav.AppendSilence(silence)) &&
+              wav.Append(samples.data(), static_cast<int32_t>(samples.size()));
+    if (!ok) {
+      LOGW("nativeGenerate: WriteWave 失败 path=%s", out_path.c_str());
+      return static_cast<int>(kErrWriteWave);
+    }
+    return 0;
+  };
+
+  sherpa_tts::PipelineStats stats;
+  int code = sherpa_tts::RunChunkedSentencePipeline(sentences, {}, frontend, inference,
+                                                    writer, &stats);
+  // 失败时 wav 析构删除已写出的部分文件
+  if (code != 0) return static_cast<jint>(code);
+  if (stats.num_written == 0) {
+    LOGW("nativeGenerate: text 只含标点");
+    return kErrInvalidInput;
+  }
+  if (!wav.Close()) {
     LOGW("nativeGenerate: WriteWave 失败 path=%s", out_path.c_str());
     return kErrWriteWave;
   }
+  if (use_cache && !text_hit) {
+    h->frontend_cache.PutText(std::string(input), h->voice, h->frontend_mode, lexicon.get(),
+                              &h->token_table, emitted_chunks);
+  }
+  LOGI("nativeGenerate: sentences=%zu written=%zu chunks=%zu normalized=%zu(%s) total=%.1f ms first_audio=%.1f ms frontend=%.1f ms vits=%.1f ms write=%.1f ms overlap_saved=%.1f ms",
+       stats.num_sentences, stats.num_written, stats.num_chunks, num_normalized,
+       sherpa_tts::NormalizeLanguageToString(h->normalize_language),
+       stats.total_seconds * 1000.0,
+       stats.first_audio_seconds * 1000.0, stats.frontend_seconds * 1000.0,
+       stats.inference_seconds * 1000.0, stats.writer_seconds * 1000.0,
+       stats.OverlapSeconds() * 1000.0);
   return static_cast<jint>(sample_rate);
 #endif
 }
 
+JNIEXPORT jint JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeGenerateFromTokenIds(
+    JNIEnv* env, jobject /* thiz */, jlong handle, jlongArray tokenIds,
+    jfloat speed, jstring outputWavPath) {
+#if !defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  (void)env;
+  (void)handle;
+  (void)tokenIds;
+  (void)speed;
+  (void)outputWavPath;
+  return 0;
+#else
+  if (handle == 0) return kErrInvalidHandle;
+  TtsHandle* h = reinterpret_cast<TtsHandle*>(handle);
+  if (!h->vits) return kErrInvalidHandle;
+
+  const jsize n = tokenIds ? env->GetArrayLength(tokenIds) : 0;
+  std::string out_path = JstringToStd(env, outputWavPath);
+  if (n <= 0 || out_path.empty()) {
+    LOGW("nativeGenerateFromTokenIds: tokenIds 或 outputWavPath 为空");
+    return kErrInvalidInput;
+  }
+  // jlong 即 int64_t：整块拷入，不逐个转换
+  std::vector<int64_t> ids(static_cast<size_t>(n));
+  env->GetLongArrayRegion(tokenIds, 0, n, reinterpret_cast<jlong*>(ids.data()));
+  const sherpa_tts::FrontendErrorCode code =
+      sherpa_tts::ValidateTokenIds(ids.data(), ids.size(), &h->token_table);
+  if (code != sherpa_tts::FrontendErrorCode::kOk) {
+    LOGW("nativeGenerateFromTokenIds: code=%s tokens=%zu max_id=%lld",
+         sherpa_tts::FrontendErrorCodeToString(code), ids.size(),
+         static_cast<long long>(h->token_table.MaxId()));
+    return -static_cast<jint>(code);
+  }
+  return SynthesizeTokenIds(h, ids, speed, out_path, "nativeGenerateFromTokenIds");
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeGenerateFromPhonemes(
+    JNIEnv* env, jobject /* thiz */, jlong handle, jstring phonemes,
+    jfloat speed, jstring outputWavPath) {
+#if !defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  (void)env;
+  (void)handle;
+  (void)phonemes;
+  (void)speed;
+  (void)outputWavPath;
+  return 0;
+#else
+  if (handle == 0) return kErrInvalidHandle;
+  TtsHandle* h = reinterpret_cast<TtsHandle*>(handle);
+  if (!h->vits) return kErrInvalidHandle;
+
+  std::string phoneme_str = JstringToStd(env, phonemes);
+  std::string out_path = JstringToStd(env, outputWavPath);
+  if (phoneme_str.empty() || out_path.empty()) {
+    LOGW("nativeGenerateFromPhonemes: phonemes 或 outputWavPath 为空");
+    return kErrInvalidInput;
+  }
+  sherpa_tts::FrontendResult front =
+      sherpa_tts::PhonemesToTokenIds(phoneme_str, &h->token_table);
+  if (front.code != sherpa_tts::FrontendErrorCode::kOk) {
+    LOGW("nativeGenerateFromPhonemes: code=%s phonemes_len=%zu token_table=%zu",
+         sherpa_tts::FrontendErrorCodeToString(front.code), phoneme_str.size(),
+         h->token_table.Size());
+    return -static_cast<jint>(front.code);
+  }
+  return SynthesizeTokenIds(h, front.token_ids, speed, out_path,
+                            "nativeGenerateFromPhonemes");
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeReloadLexicon(
+    JNIEnv* env, jobject /* thiz */, jlong handle, jstring lexiconPath,
+    jboolean userLayer) {
+#if !defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  (void)env;
+  (void)handle;
+  (void)lexiconPath;
+  (void)userLayer;
+  return 0;
+#else
+  if (handle == 0) return kErrInvalidHandle;
+  TtsHandle* h = reinterpret_cast<TtsHandle*>(handle);
+  std::string path = JstringToStd(env, lexiconPath);
+  const sherpa_tts::LexiconLayer layer = userLayer
+                                             ? sherpa_tts::LexiconLayer::kUser
+                                             : sherpa_tts::LexiconLayer::kBase;
+  // 在调用线程上构建新词典，完成后原子替换；进行中的 nativeGenerate 继续使用旧快照。
+  // path 为空时卸载该层。
+  std::shared_ptr<const sherpa_tts::Lexicon> loaded;
+  if (!h->lexicon.Reload(layer, path, &loaded)) {
+    LOGW("nativeReloadLexicon: 加载 lexicon 失败 path=%s，保留原词典", path.c_str());
+    return kErrLexiconLoad;
+  }
+  h->frontend_cache.Clear();
+  if (loaded) LogLexiconLoaded("nativeReloadLexicon", *loaded);
+  return 0;
+#endif
+}
+
+JNIEXPORT jint JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeApplyLexiconDelta(
+    JNIEnv* env, jobject /* thiz */, jlong handle, jstring delta) {
+#if !defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  (void)env;
+  (void)handle;
+  (void)delta;
+  return 0;
+#else
+  if (handle == 0) return kErrInvalidHandle;
+  TtsHandle* h = reinterpret_cast<TtsHandle*>(handle);
+  std::string delta_str = JstringToStd(env, delta);
+  if (delta_str.empty()) return kErrInvalidInput;
+  size_t applied = h->lexicon.ApplyDelta(delta_str);
+  if (applied > 0) h->frontend_cache.Clear();
+  return static_cast<jint>(applied);
+#endif
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeGetFrontendCacheStats(
+    JNIEnv* env, jobject /* thiz */, jlong handle) {
+  // 顺序与 TTSEngine.frontendCacheStats 一致；7 起为进程内共享的 espeak 词级缓存，
+  // 13、14 为其中的持久化文件
+  jlong values[15] = {};
+#if defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  if (handle != 0) {
+    const sherpa_tts::FrontendCacheStats stats =
+        reinterpret_cast<TtsHandle*>(handle)->frontend_cache.Stats();
+    values[0] = static_cast<jlong>(stats.text_hits);
+    values[1] = static_cast<jlong>(stats.text_misses);
+    values[2] = static_cast<jlong>(stats.sentence_hits);
+    values[3] = static_cast<jlong>(stats.sentence_misses);
+    values[4] = static_cast<jlong>(stats.evictions);
+    values[5] = static_cast<jlong>(stats.entries);
+    values[6] = static_cast<jlong>(stats.bytes);
+    const sherpa_tts::EspeakWordCacheStats words =
+        sherpa_tts::EspeakWordCache::Global().Stats();
+    values[7] = static_cast<jlong>(words.hits);
+    values[8] = static_cast<jlong>(words.misses);
+    values[9] = static_cast<jlong>(words.uncacheable);
+    values[10] = static_cast<jlong>(words.evictions);
+    values[11] = static_cast<jlong>(words.entries);
+    values[12] = static_cast<jlong>(words.bytes);
+    values[13] = static_cast<jlong>(words.persistent_hits);
+    values[14] = static_cast<jlong>(words.persistent_entries);
+  }
+#else
+  (void)handle;
+#endif
+  jlongArray out = env->NewLongArray(15);
+  if (out) env->SetLongArrayRegion(out, 0, 15, values);
+  return out;
+}
+
+JNIEXPORT jdoubleArray JNICALL
+Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeBenchmarkOovFrontends(
+    JNIEnv* env, jobject /* thiz */, jlong handle, jstring words, jint rounds) {
+  // 词/秒：G2P 整批一次推理、G2P 逐词推理、espeak 整批一次调用；不可用或失败为 -1。
+  // 顺序与 TTSEngine.benchmarkOovFrontends 一致
+  jdouble values[3] = {-1, -1, -1};
+#if defined(SHERPA_TTS_USE_ONNXRUNTIME)
+  std::vector<std::string> list;
+  if (handle != 0) {
+    const std::string joined = JstringToStd(env, words);
+    for (size_t pos = 0; pos < joined.size();) {
+      size_t e = joined.find('\n', pos);
+      if (e == std::string::npos) e = joined.size();
+      if (e > pos) list.emplace_back(joined, pos, e - pos);
+      pos = e + 1;
+    }
+  }
+  if (!list.empty()) {
+    TtsHandle* h = reinterpret_cast<TtsHandle*>(handle);
+    const int n = rounds > 0 ? rounds : 1;
+    // fn 返回 false 表示该前端不可用，结果记为 -1
+    auto measure = [&](auto fn) -> jdouble {
+      const auto start = std::chrono::steady_clock::now();
+      for (int r = 0; r < n; ++r) {
+        if (!fn()) return -1;
+      }
+      const double seconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+      return seconds > 0 ? list.size() * n / seconds : -1;
+    };
+    if (h->g2p) {
+      values[0] = measure([&] {
+        return h->g2p->PhonemizeWords(list).code == sherpa_tts::G2pErrorCode::kOk;
+      });
+      values[1] = measure([&] {
+        for (const std::string& w : list) {
+          if (h->g2p->PhonemizeWords({w}).code == sherpa_tts::G2pErrorCode::kRunFailed) {
+            return false;
+          }
+        }
+        return true;
+      });
+    }
+    if (!h->data_dir.empty()) {
+      values[2] = measure([&] {
+        return sherpa_tts::PhonemizeWordsWithEspeak(list, h->data_dir, h->voice,
+                                                    &h->token_table)
+                   .code == sherpa_tts::EspeakErrorCode::kOk;
+      });
+    }
+    LOGI("nativeBenchmarkOovFrontends: words=%zu rounds=%d g2p_batch=%.0f g2p_single=%.0f espeak=%.0f words/s",
+         list.size(), n, values[0], values[1], values[2]);
+  }
+#else
+  (void)handle;
+  (void)words;
+  (void)rounds;
+#endif
+  jdoubleArray out = env->NewDoubleArray(3);
+  if (out) env->SetDoubleArrayRegion(out, 0, 3, values);
+  return out;
+}
+
 JNIEXPORT void JNICALL
 Java_com_k2fsa_sherpa_tts_engine_TTSEngine_nativeRelease(JNIEnv* env,
                                                          jobject /* thiz */,
@@ -1,103 +1,14 @@
 #include "vits_engine.h"
 
-#include <fstream>
-#include <sstream>
+#include <array>
 #include <vector>
 
-#include <onnxruntime_cxx_api.h>
+#include "onnx_util.h"
 
 namespace sherpa_tts {
 
-namespace {
-
-static std::vector<char> ReadFile(const std::string& path) {
-  std::ifstream is(path, std::ios::binary | std::ios::ate);
-  if (!is) return {};
-  size_t size = is.tellg();
-  is.seekg(0);
-  std::vector<char> buf(size);
-  if (!is.read(buf.data(), size)) return {};
-  return buf;
-}
-
-static std::string GetInputName(Ort::Session* sess, size_t index,
-                               OrtAllocator* allocator) {
-#if ORT_API_VERSION >= 12
-  auto v = sess->GetInputNameAllocated(index, allocator);
-  return std::string(v.get());
-#else
-  auto* v = sess->GetInputName(index, allocator);
-  std::string ans = v ? v : "";
-  if (v && allocator) allocator->Free(allocator, v);
-  return ans;
-#endif
-}
-
-static std::string GetOutputName(Ort::Session* sess, size_t index,
-                                 OrtAllocator* allocator) {
-#if ORT_API_VERSION >= 12
-  auto v = sess->GetOutputNameAllocated(index, allocator);
-  return std::string(v.get());
-#else
-  auto* v = sess->GetOutputName(index, allocator);
-  std::string ans = v ? v : "";
-  if (v && allocator) allocator->Free(allocator, v);
-  return ans;
-#endif
-}
-
-static void GetInputNames(Ort::Session* sess, std::vector<std::string>* names,
-                          std::vector<const char*>* ptrs) {
-  Ort::AllocatorWithDefaultOptions allocator;
-  size_t n = sess->GetInputCount();
-  names->resize(n);
-  ptrs->resize(n);
-  for (size_t i = 0; i < n; ++i) {
-    (*names)[i] = GetInputName(sess, i, allocator);
-    (*ptrs)[i] = (*names)[i].c_str();
-  }
-}
-
-static void GetOutputNames(Ort::Session* sess, std::vector<std::string>* names,
-                           std::vector<const char*>* ptrs) {
-  Ort::AllocatorWithDefaultOptions allocator;
-  size_t n = sess->GetOutputCount();
-  names->resize(n);
-  ptrs->resize(n);
-  for (size_t i = 0; i < n; ++i) {
-    (*names)[i] = GetOutputName(sess, i, allocator);
-    (*ptrs)[i] = (*names)[i].c_str();
-  }
-}
-
-static std::string GetMetadataStr(Ort::Session* sess, const char* key) {
-  try {
-    Ort::ModelMetadata meta = sess->GetModelMetadata();
-    Ort::AllocatorWithDefaultOptions allocator;
-#if ORT_API_VERSION >= 12
-    auto v = meta.LookupCustomMetadataMapAllocated(key, allocator);
-    return v ? std::string(v.get()) : "";
-#else
-    const char* v = meta.LookupCustomMetadataMap(key, allocator);
-    return v ? std::string(v) : "";
-#endif
-  } catch (...) {
-    return "";
-  }
-}
-
-static int32_t GetMetadataInt(Ort::Session* sess, const char* key,
-                              int32_t default_val) {
-  std::string s = GetMetadataStr(sess, key);
-  if (s.empty()) return default_val;
-  return static_cast<int32_t>(std::atoi(s.c_str()));
-}
-
-}  // namespace
-
 class VitsEngine::Impl {
  public:
-  Ort::Env env_{ORT_LOGGING_LEVEL_WARNING};
   Ort::SessionOptions opts_;
   std::unique_ptr<Ort::Session> sess_;
   std::vector<std::string> input_names_;
@@ -118,19 +29,24 @@ class VitsEngine::Impl {
     opts_.SetIntraOpNumThreads(config.num_threads);
     opts_.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
-    std::vector<char> model_data = ReadFile(config.model_path);
+    std::vector<char> model_data = ReadFileBytes(config.model_path);
     if (model_data.empty()) return;
 
-    sess_ = std::make_unique<Ort::Session>(env_, model_data.data(),
+    sess_ = std::make_unique<Ort::Session>(SharedOrtEnv(), model_data.data(),
                                            model_data.size(), opts_);
     GetInputNames(sess_.get(), &input_names_, &input_names_ptr_);
     GetOutputNames(sess_.get(), &output_names_, &output_names_ptr_);
 
-    sample_rate_ = GetMetadataInt(sess_.get(), "sample_rate", 22050);
-    num_speakers_ = GetMetadataInt(sess_.get(), "n_speakers", 0);
+    sample_rate_ = config.sample_rate > 0
+                       ? config.sample_rate
+                       : GetMetadataInt(sess_.get(), "sample_rate", 22050);
+    num_speakers_ = config.num_speakers > 0
+                        ? config.num_speakers
+                        : GetMetadataInt(sess_.get(), "n_speakers", 0);
     std::string comment = GetMetadataStr(sess_.get(), "comment");
-    is_piper_or_coqui_ = (comment.find("piper") != std::string::npos ||
-                          comment.find("coqui") != std::string::npos);
+    is_piper_or_coqui_ = config.piper_inputs ||
+                         comment.find("piper") != std::string::npos ||
+                         comment.find("coqui") != std::string::npos;
   }
 
   std::vector<float> Run(const std::vector<int64_t>& token_ids, int64_t sid,
@@ -151,7 +67,8 @@ class VitsEngine::Impl {
         memory_info, &length_val, 1, &len_shape, 1);
 
     float length_scale = length_scale_;
-    if (speed > 0 && speed != 1.f) length_scale = 1.f / speed;
+    // 语速作用在音色自带的 length_scale 上（Piper 配置可能不是 1）
+    if (speed > 0 && speed != 1.f) length_scale = length_scale_ / speed;
 
     std::vector<Ort::Value> inputs;
     inputs.reserve(6);
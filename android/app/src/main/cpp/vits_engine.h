@@ -14,6 +14,12 @@ struct VitsConfig {
   float noise_scale = 0.667f;
   float noise_scale_w = 0.8f;
   float length_scale = 1.0f;
+  // > 0 时覆盖模型元数据中的 sample_rate（Piper 原版导出的模型没有元数据，由 .onnx.json 给出）
+  int32_t sample_rate = 0;
+  // true 时按 Piper 的输入布局（scales 合为一个张量）运行，不依赖元数据中的 comment
+  bool piper_inputs = false;
+  // > 0 时覆盖模型元数据中的 n_speakers（Piper 由 .onnx.json 的 num_speakers 给出）
+  int32_t num_speakers = 0;
 };
 
 // VITS ONNX 推理：输入 token id 序列，输出 float 音频与采样率。
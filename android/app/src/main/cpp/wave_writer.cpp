@@ -1,6 +1,7 @@
 #include "wave_writer.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
 
 namespace sherpa_tts {
@@ -25,6 +26,24 @@ struct WavHeader {
 };
 #pragma pack(pop)
 
+WavHeader MakeHeader(int32_t sample_rate, uint32_t data_bytes) {
+  WavHeader h;
+  h.file_size = 36 + data_bytes;
+  h.sample_rate = static_cast<uint32_t>(sample_rate);
+  h.byte_rate = h.sample_rate * 2u;
+  h.data_size = data_bytes;
+  return h;
+}
+
+void ToPcm16(const float* samples, int32_t n, std::vector<int16_t>* pcm) {
+  pcm->resize(static_cast<size_t>(n));
+  for (int32_t i = 0; i < n; ++i) {
+    float f = samples[i];
+    f = std::max(-1.f, std::min(1.f, f));
+    (*pcm)[i] = static_cast<int16_t>(f * 32767.f);
+  }
+}
+
 }  // namespace
 
 bool WriteWave(const std::string& filename, int32_t sample_rate,
@@ -34,20 +53,11 @@ bool WriteWave(const std::string& filename, int32_t sample_rate,
   if (!out) return false;
 
   const uint32_t data_bytes = static_cast<uint32_t>(n) * 2u;
-  WavHeader h;
-  h.file_size = 36 + data_bytes;
-  h.sample_rate = static_cast<uint32_t>(sample_rate);
-  h.byte_rate = h.sample_rate * 2u;
-  h.data_size = data_bytes;
-
+  WavHeader h = MakeHeader(sample_rate, data_bytes);
   out.write(reinterpret_cast<const char*>(&h), sizeof(h));
 
-  std::vector<int16_t> pcm(static_cast<size_t>(n));
-  for (int32_t i = 0; i < n; ++i) {
-    float f = samples[i];
-    f = std::max(-1.f, std::min(1.f, f));
-    pcm[i] = static_cast<int16_t>(f * 32767.f);
-  }
+  std::vector<int16_t> pcm;
+  ToPcm16(samples, n, &pcm);
   out.write(reinterpret_cast<const char*>(pcm.data()), data_bytes);
   return out.good();
 }
@@ -58,4 +68,50 @@ bool WriteWave(const std::string& filename, int32_t sample_rate,
                    static_cast<int32_t>(samples.size()));
 }
 
+bool WaveStreamWriter::Open(const std::string& filename, int32_t sample_rate) {
+  out_.open(filename, std::ios::binary | std::ios::trunc);
+  if (!out_) return false;
+  filename_ = filename;
+  sample_rate_ = sample_rate;
+  num_samples_ = 0;
+  WavHeader h = MakeHeader(sample_rate, 0);
+  out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  return out_.good();
+}
+
+bool WaveStreamWriter::Append(const float* samples, int32_t n) {
+  if (!out_.is_open() || !samples || n <= 0) return false;
+  ToPcm16(samples, n, &pcm_);
+  out_.write(reinterpret_cast<const char*>(pcm_.data()),
+             static_cast<std::streamsize>(n) * 2);
+  num_samples_ += n;
+  return out_.good();
+}
+
+bool WaveStreamWriter::AppendSilence(int32_t n) {
+  if (!out_.is_open() || n <= 0) return false;
+  pcm_.assign(static_cast<size_t>(n), 0);
+  out_.write(reinterpret_cast<const char*>(pcm_.data()),
+             static_cast<std::streamsize>(n) * 2);
+  num_samples_ += n;
+  return out_.good();
+}
+
+bool WaveStreamWriter::Close() {
+  if (!out_.is_open()) return false;
+  WavHeader h = MakeHeader(sample_rate_, static_cast<uint32_t>(num_samples_ * 2));
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  const bool ok = out_.good() && num_samples_ > 0;
+  out_.close();
+  if (!ok) std::remove(filename_.c_str());
+  return ok;
+}
+
+void WaveStreamWriter::Discard() {
+  if (!out_.is_open()) return;
+  out_.close();
+  std::remove(filename_.c_str());
+}
+
 }  // namespace sherpa_tts
@@ -15,6 +15,36 @@ bool WriteWave(const std::string& filename, int32_t sample_rate,
 bool WriteWave(const std::string& filename, int32_t sample_rate,
                const std::vector<float>& samples);
 
+// 分段写入的 WAV：先写占位文件头，逐段追加采样，Close 时回填长度。
+// 用于逐句合成时边推理边落盘，不必先拼出整段音频。
+// 未成功 Close 的文件会被删除（合成中途失败时不留下截断或空的 WAV）。
+class WaveStreamWriter {
+ public:
+  WaveStreamWriter() = default;
+  ~WaveStreamWriter() { Discard(); }
+
+  WaveStreamWriter(const WaveStreamWriter&) = delete;
+  WaveStreamWriter& operator=(const WaveStreamWriter&) = delete;
+
+  bool Open(const std::string& filename, int32_t sample_rate);
+  bool Append(const float* samples, int32_t n);
+  // 追加 n 个采样的静音
+  bool AppendSilence(int32_t n);
+  // 回填文件头并关闭；未写入任何采样或写入失败时删除文件并返回 false
+  bool Close();
+  // 关闭并删除尚未 Close 的文件
+  void Discard();
+
+  int64_t NumSamples() const { return num_samples_; }
+
+ private:
+  std::ofstream out_;
+  std::string filename_;
+  int32_t sample_rate_ = 0;
+  int64_t num_samples_ = 0;
+  std::vector<int16_t> pcm_;
+};
+
 }  // namespace sherpa_tts
 
 #endif  // SHERPA_TTS_WAVE_WRITER_H_
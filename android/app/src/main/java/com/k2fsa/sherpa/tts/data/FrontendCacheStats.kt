@@ -0,0 +1,39 @@
+package com.k2fsa.sherpa.tts.data
+
+/**
+ * native 前端缓存（文本 -> token id）的累计计数。
+ * text* 为整段文本（规范化后、切句前）的查询；整段未命中时再逐句查询，计入 sentence*。
+ * word* 为 espeak 词级缓存（词 -> 音素，Hybrid / NeuralG2p 模式下词典未命中、送 espeak 的词），
+ * 进程内所有引擎共享；wordUncacheable 为含数字、标点等、须连同上下文音素化而不缓存的词。
+ * wordDisk* 为词级缓存的持久化文件（[TTSConfig.espeakCacheDir]）：wordDiskHits 计入 wordHits，
+ * 多为重启后首次遇到的常用词。
+ */
+data class FrontendCacheStats(
+    val textHits: Long,
+    val textMisses: Long,
+    val sentenceHits: Long,
+    val sentenceMisses: Long,
+    val evictions: Long,
+    val entries: Long,
+    val bytes: Long,
+    val wordHits: Long = 0,
+    val wordMisses: Long = 0,
+    val wordUncacheable: Long = 0,
+    val wordEvictions: Long = 0,
+    val wordEntries: Long = 0,
+    val wordBytes: Long = 0,
+    val wordDiskHits: Long = 0,
+    val wordDiskEntries: Long = 0
+) {
+    val textHitRatio: Double
+        get() = ratio(textHits, textMisses)
+
+    val sentenceHitRatio: Double
+        get() = ratio(sentenceHits, sentenceMisses)
+
+    val wordHitRatio: Double
+        get() = ratio(wordHits, wordMisses)
+
+    private fun ratio(hits: Long, misses: Long): Double =
+        if (hits + misses > 0) hits.toDouble() / (hits + misses) else 0.0
+}
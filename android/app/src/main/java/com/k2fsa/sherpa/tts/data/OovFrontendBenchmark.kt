@@ -0,0 +1,15 @@
+package com.k2fsa.sherpa.tts.data
+
+/**
+ * 词典未命中词的回退前端吞吐（词/秒），见 TTSEngine.benchmarkOovFrontends。
+ * 前端不可用（未加载 G2P 模型、没有 dataDir）或运行失败时为 -1。
+ * - g2pBatch: 全部词合并为一次 G2P 推理；
+ * - g2pSingle: 每个词单独推理一次（批处理的对照）；
+ * - espeak: 全部词合并为一次 espeak 调用（与 Hybrid 模式相同）。
+ */
+data class OovFrontendBenchmark(
+    val wordCount: Int,
+    val g2pBatchWordsPerSec: Double,
+    val g2pSingleWordsPerSec: Double,
+    val espeakWordsPerSec: Double
+)
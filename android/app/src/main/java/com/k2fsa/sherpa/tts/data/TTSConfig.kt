@@ -5,11 +5,18 @@ package com.k2fsa.sherpa.tts.data
  * - Auto: 先走 lexicon，失败后回退到 espeak。
  * - LexiconFirst: 强制仅走 lexicon（无命中即失败）。
  * - EspeakOnly: 强制仅走 espeak（要求 dataDir 可用）。
+ * - Hybrid: 逐词混合，词典命中的词直接用词典，其余词合并为一次 espeak 调用（无 dataDir 时按字符回退）。
+ * - NeuralG2p: 同 Hybrid，但未命中的词先合并为一次 G2P 模型推理（[TTSConfig.g2pModelPath]），
+ *   模型不可用或推理失败时再走 espeak。
+ *
+ * 顺序与 native FrontendMode 一致（按 ordinal 传入），只能在末尾追加。
  */
 enum class FrontendMode {
     Auto,
     LexiconFirst,
-    EspeakOnly
+    EspeakOnly,
+    Hybrid,
+    NeuralG2p
 }
 
 /**
@@ -17,13 +24,31 @@ enum class FrontendMode {
  */
 data class TTSConfig(
     val modelPath: String,
+    /**
+     * tokens 文件路径；`builtin:ru` 等表示使用编译进 native 库的内置表，不读文件；
+     * 以 `.json` 结尾时按 Piper 的 model.onnx.json 加载，其中的推理参数与 espeak voice 优先于本配置。
+     */
     val tokensPath: String,
     val dataDir: String = "",
     val lexiconPath: String = "",
+    /** 用户自定义词典，叠加在 [lexiconPath] 之上（同名词条优先，`!词` 可屏蔽基础词典）。 */
+    val userLexiconPath: String = "",
+    /** 字素到音素的 ONNX 模型，供 [FrontendMode.NeuralG2p] 处理词典未命中的词；为空则不加载。 */
+    val g2pModelPath: String = "",
     val frontendMode: FrontendMode = FrontendMode.Auto,
     val voice: String = "ru",
     val speakerId: Int = 0,
     val speed: Float = 1.0f,
     val numThreads: Int = 1,
+    /**
+     * 进程内 espeak 实例数（1..8）：每个实例是单独加载的一份 espeak 库，最多这么多个请求可同时音素化。
+     * 进程内共享、只增不减，多个引擎取其中的最大值。
+     */
+    val espeakWorkers: Int = 1,
+    /**
+     * espeak 词级缓存（词 -> 音素）的持久化目录，每个 voice 一个文件，重启后常用词无需再经 espeak。
+     * espeak-ng-data 或 espeak 库更新后文件自动失效重建。为空则只缓存在内存中。
+     */
+    val espeakCacheDir: String = "",
     val debug: Boolean = false
 )
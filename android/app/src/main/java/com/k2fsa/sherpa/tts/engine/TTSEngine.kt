@@ -1,6 +1,8 @@
 package com.k2fsa.sherpa.tts.engine
 
+import com.k2fsa.sherpa.tts.data.FrontendCacheStats
 import com.k2fsa.sherpa.tts.data.GeneratedAudio
+import com.k2fsa.sherpa.tts.data.OovFrontendBenchmark
 import com.k2fsa.sherpa.tts.data.TTSConfig
 
 /**
@@ -17,11 +19,15 @@ class TTSEngine(config: TTSConfig) {
             config.tokensPath,
             config.dataDir,
             config.lexiconPath,
+            config.userLexiconPath,
+            config.g2pModelPath,
             config.frontendMode.ordinal,
             config.voice,
             config.speakerId,
             config.speed,
             config.numThreads,
+            config.espeakWorkers,
+            config.espeakCacheDir,
             config.debug
         )
         if (nativeHandle == 0L) {
@@ -38,11 +44,97 @@ class TTSEngine(config: TTSConfig) {
     fun generate(text: String, speed: Float, outputWavPath: String): GeneratedAudio {
         val sampleRate = nativeGenerate(nativeHandle, text, speed, outputWavPath)
         if (sampleRate <= 0) {
-            throw IllegalStateException(explainGenerateError(sampleRate))
+            throw IllegalStateException(explainError("generate", sampleRate))
         }
         return GeneratedAudio(sampleRate = sampleRate, wavFilePath = outputWavPath)
     }
 
+    /**
+     * 直接由模型 token id 生成语音，跳过文本规范化、切句与词典 / espeak 前端（一次推理）。
+     * id 须在 tokens 表范围内，越界时抛出 FRONTEND_TOKEN_MISS。
+     */
+    fun generateFromTokenIds(tokenIds: LongArray, speed: Float, outputWavPath: String): GeneratedAudio {
+        val sampleRate = nativeGenerateFromTokenIds(nativeHandle, tokenIds, speed, outputWavPath)
+        if (sampleRate <= 0) {
+            throw IllegalStateException(explainError("generateFromTokenIds", sampleRate))
+        }
+        return GeneratedAudio(sampleRate = sampleRate, wavFilePath = outputWavPath)
+    }
+
+    /**
+     * 直接由音素串（如 Piper / espeak 输出的 IPA，空格即词间停顿）生成语音：只经 tokens 表逐字符映射，
+     * 自动加首尾标记与填充符。含 tokens 未收录的音素时抛出 FRONTEND_TOKEN_MISS。
+     */
+    fun generateFromPhonemes(phonemes: String, speed: Float, outputWavPath: String): GeneratedAudio {
+        val sampleRate = nativeGenerateFromPhonemes(nativeHandle, phonemes, speed, outputWavPath)
+        if (sampleRate <= 0) {
+            throw IllegalStateException(explainError("generateFromPhonemes", sampleRate))
+        }
+        return GeneratedAudio(sampleRate = sampleRate, wavFilePath = outputWavPath)
+    }
+
+    /**
+     * 重新加载词典：native 在调用线程上构建新词典后原子替换，进行中的 [generate] 仍使用旧词典。
+     * 应在后台线程调用。失败时保留原词典并抛出异常。
+     * @param lexiconPath 为空时卸载该层
+     * @param userLayer true 为用户词典层（会清空已下发的增量），false 为基础词典（进程内共享）
+     */
+    fun reloadLexicon(lexiconPath: String, userLayer: Boolean = false) {
+        val code = nativeReloadLexicon(nativeHandle, lexiconPath, userLayer)
+        if (code != 0) {
+            throw IllegalStateException(explainError("reloadLexicon", code))
+        }
+    }
+
+    /**
+     * 增量修改用户词典：[deltaLines] 为词典行（与 lexicon.txt 同格式），`!词` 表示删除。
+     * 只重建增量部分，不重新解析各词典文件。返回生效的行数。
+     */
+    fun applyLexiconDelta(deltaLines: List<String>): Int {
+        if (deltaLines.isEmpty()) return 0
+        val applied = nativeApplyLexiconDelta(nativeHandle, deltaLines.joinToString("\n"))
+        if (applied < 0) {
+            throw IllegalStateException(explainError("applyLexiconDelta", applied))
+        }
+        return applied
+    }
+
+    /** 前端结果缓存的命中计数（词典重载时缓存会清空，计数保留）。 */
+    fun frontendCacheStats(): FrontendCacheStats {
+        val v = nativeGetFrontendCacheStats(nativeHandle)
+        return FrontendCacheStats(
+            textHits = v[0],
+            textMisses = v[1],
+            sentenceHits = v[2],
+            sentenceMisses = v[3],
+            evictions = v[4],
+            entries = v[5],
+            bytes = v[6],
+            wordHits = v[7],
+            wordMisses = v[8],
+            wordUncacheable = v[9],
+            wordEvictions = v[10],
+            wordEntries = v[11],
+            wordBytes = v[12],
+            wordDiskHits = v[13],
+            wordDiskEntries = v[14]
+        )
+    }
+
+    /**
+     * 对比未命中词的两种回退前端的吞吐（词/秒），供在设备上评估 G2P 模型。
+     * 每个前端把 [words] 整体跑 [rounds] 轮；较慢，应在后台线程调用。
+     */
+    fun benchmarkOovFrontends(words: List<String>, rounds: Int = 5): OovFrontendBenchmark {
+        val v = nativeBenchmarkOovFrontends(nativeHandle, words.joinToString("\n"), rounds)
+        return OovFrontendBenchmark(
+            wordCount = words.size,
+            g2pBatchWordsPerSec = v[0],
+            g2pSingleWordsPerSec = v[1],
+            espeakWordsPerSec = v[2]
+        )
+    }
+
     fun release() {
         if (nativeHandle != 0L) {
             nativeRelease(nativeHandle)
@@ -55,11 +147,15 @@ class TTSEngine(config: TTSConfig) {
         tokensPath: String,
         dataDir: String,
         lexiconPath: String,
+        userLexiconPath: String,
+        g2pModelPath: String,
         frontendMode: Int,
         voice: String,
         speakerId: Int,
         speed: Float,
         numThreads: Int,
+        espeakWorkers: Int,
+        espeakCacheDir: String,
         debug: Boolean
     ): Long
 
@@ -70,6 +166,28 @@ class TTSEngine(config: TTSConfig) {
         outputWavPath: String
     ): Int
 
+    private external fun nativeGenerateFromTokenIds(
+        handle: Long,
+        tokenIds: LongArray,
+        speed: Float,
+        outputWavPath: String
+    ): Int
+
+    private external fun nativeGenerateFromPhonemes(
+        handle: Long,
+        phonemes: String,
+        speed: Float,
+        outputWavPath: String
+    ): Int
+
+    private external fun nativeReloadLexicon(handle: Long, lexiconPath: String, userLayer: Boolean): Int
+
+    private external fun nativeApplyLexiconDelta(handle: Long, delta: String): Int
+
+    private external fun nativeGetFrontendCacheStats(handle: Long): LongArray
+
+    private external fun nativeBenchmarkOovFrontends(handle: Long, words: String, rounds: Int): DoubleArray
+
     private external fun nativeRelease(handle: Long)
 
     companion object {
@@ -84,8 +202,9 @@ class TTSEngine(config: TTSConfig) {
         private const val ERR_INVALID_INPUT = -101
         private const val ERR_VITS_RUN_EMPTY = -102
         private const val ERR_WRITE_WAVE = -103
+        private const val ERR_LEXICON_LOAD = -104
 
-        private fun explainGenerateError(code: Int): String {
+        private fun explainError(action: String, code: Int): String {
             val reason = when (code) {
                 FRONTEND_INVALID_ARGS -> "FRONTEND_INVALID_ARGS"
                 FRONTEND_LEXICON_MISS -> "FRONTEND_LEXICON_MISS"
@@ -98,9 +217,10 @@ class TTSEngine(config: TTSConfig) {
                 ERR_INVALID_INPUT -> "ERR_INVALID_INPUT"
                 ERR_VITS_RUN_EMPTY -> "ERR_VITS_RUN_EMPTY"
                 ERR_WRITE_WAVE -> "ERR_WRITE_WAVE"
+                ERR_LEXICON_LOAD -> "ERR_LEXICON_LOAD"
                 else -> "UNKNOWN_ERROR"
             }
-            return "TTSEngine generate failed: $reason (code=$code)"
+            return "TTSEngine $action failed: $reason (code=$code)"
         }
 
         init {
@@ -10,6 +10,8 @@ import com.k2fsa.sherpa.tts.util.EspeakDataHelper
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.withContext
 import java.io.File
+import java.text.Normalizer
+import java.util.Locale
 
 /**
  * 本项目 TTS 仓库：使用本项目的 TTSEngine（JNI）生成语音。
@@ -21,10 +23,29 @@ class TTSRepository(
 ) {
     companion object {
         private const val TAG = "SherpaTtsRepo"
+
+        /** 超过该大小的词典不在内存中保留逐行内容，变化时整体重载而非计算增量。 */
+        private const val MAX_DELTA_TRACKED_BYTES = 1L shl 20
+
+        /** 增量行数超过该值时整体重载更划算。 */
+        private const val MAX_DELTA_LINES = 512
+
+        private val WHITESPACE = Regex("\\s+")
     }
 
+    /** 已加载到引擎中的词典文件状态，用于判断文件是否变化及计算增量。 */
+    private data class LexiconFileState(
+        val path: String,
+        val lastModified: Long,
+        val length: Long,
+        /** 词条键 -> 原始行；文件过大时为 null */
+        val lines: Map<String, String>?
+    )
+
     private var engine: TTSEngine? = null
     private var currentConfig: TTSConfig? = null
+    private var baseLexiconState: LexiconFileState? = null
+    private var userLexiconState: LexiconFileState? = null
 
     /** 应用内固定的 espeak-ng-data 路径（与 sherpa-onnx --vits-data-dir 对应）。 */
     private val espeakDataDir: String
@@ -37,7 +58,10 @@ class TTSRepository(
     fun getOrCreateEngine(config: TTSConfig): Result<TTSEngine> {
         val fullConfig = config.copy(
             dataDir = if (config.dataDir.isBlank()) espeakDataDir else config.dataDir,
-            voice = if (config.voice.isBlank()) "ru" else config.voice
+            voice = if (config.voice.isBlank()) "ru" else config.voice,
+            espeakCacheDir = config.espeakCacheDir.ifBlank {
+                File(context.cacheDir, "espeak-words").absolutePath
+            }
         )
         if (fullConfig.frontendMode == FrontendMode.EspeakOnly && fullConfig.dataDir.isBlank()) {
             return Result.failure(
@@ -49,10 +73,19 @@ class TTSRepository(
             "createEngine: mode=${fullConfig.frontendMode} voice=${fullConfig.voice} dataDir=${fullConfig.dataDir}"
         )
         return try {
-            if (engine == null || currentConfig != fullConfig) {
+            val current = engine
+            val onlyLexiconsDiffer = current != null && currentConfig?.copy(
+                lexiconPath = fullConfig.lexiconPath,
+                userLexiconPath = fullConfig.userLexiconPath
+            ) == fullConfig
+            if (onlyLexiconsDiffer && refreshLexicons(current!!, fullConfig)) {
+                currentConfig = fullConfig
+            } else if (engine == null || currentConfig != fullConfig) {
                 engine?.release()
                 engine = TTSEngine(fullConfig)
                 currentConfig = fullConfig
+                baseLexiconState = readLexiconState(fullConfig.lexiconPath, trackLines = false)
+                userLexiconState = readLexiconState(fullConfig.userLexiconPath, trackLines = true)
             }
             Result.success(engine!!)
         } catch (e: UnsatisfiedLinkError) {
@@ -69,6 +102,17 @@ class TTSRepository(
                     try {
                         val wavFile = File(outputDir, "generated_${System.currentTimeMillis()}.wav")
                         val result = eng.generate(text, speed, wavFile.absolutePath)
+                        if (config.debug) {
+                            val stats = eng.frontendCacheStats()
+                            Log.d(
+                                TAG,
+                                "frontend cache: text hit=%.2f sentence hit=%.2f entries=%d espeak word hit=%.2f entries=%d disk hits=%d entries=%d".format(
+                                    stats.textHitRatio, stats.sentenceHitRatio, stats.entries,
+                                    stats.wordHitRatio, stats.wordEntries,
+                                    stats.wordDiskHits, stats.wordDiskEntries
+                                )
+                            )
+                        }
                         Result.success(result)
                     } catch (e: Throwable) {
                         Result.failure(e)
@@ -83,5 +127,117 @@ class TTSRepository(
         engine?.release()
         engine = null
         currentConfig = null
+        baseLexiconState = null
+        userLexiconState = null
+    }
+
+    /**
+     * 词典路径或文件内容变化时就地更新引擎中的词典，避免重建引擎（重新加载模型）。
+     * 返回 false 表示需要重建引擎。
+     */
+    private fun refreshLexicons(engine: TTSEngine, config: TTSConfig): Boolean =
+        try {
+            baseLexiconState = refreshLexicon(engine, baseLexiconState, config.lexiconPath, userLayer = false)
+            userLexiconState = refreshLexicon(engine, userLexiconState, config.userLexiconPath, userLayer = true)
+            true
+        } catch (e: IllegalStateException) {
+            Log.w(TAG, "refreshLexicons failed, rebuilding engine", e)
+            false
+        }
+
+    /**
+     * 更新一层词典并返回新的文件状态。用户词典的小改动以增量方式下发，其余情况整体重载该层；
+     * 基础词典在 native 侧按文件共享，不走增量。
+     */
+    private fun refreshLexicon(
+        engine: TTSEngine,
+        old: LexiconFileState?,
+        path: String,
+        userLayer: Boolean
+    ): LexiconFileState? {
+        if (path.isBlank()) {
+            if (old != null) engine.reloadLexicon("", userLayer)
+            return null
+        }
+        val file = File(path)
+        if (!file.isFile) throw IllegalStateException("lexicon not found: $path")
+        // 先比较修改时间与大小，未变化时不读文件
+        if (old != null && old.path == path && old.lastModified == file.lastModified() &&
+            old.length == file.length()
+        ) {
+            return old
+        }
+        val new = readLexiconState(path, trackLines = userLayer)
+            ?: throw IllegalStateException("lexicon not found: $path")
+        val delta = if (userLayer && old?.path == path) diffLexicon(old.lines, new.lines) else null
+        if (delta != null && delta.size <= MAX_DELTA_LINES) {
+            val applied = engine.applyLexiconDelta(delta)
+            Log.i(TAG, "refreshLexicon: user delta lines=${delta.size} applied=$applied")
+        } else {
+            engine.reloadLexicon(path, userLayer)
+            Log.i(TAG, "refreshLexicon: reloaded userLayer=$userLayer path=$path")
+        }
+        return new
+    }
+
+    /** trackLines 为 false 时只记录修改时间与大小（基础词典不走增量，无需逐行内容）。 */
+    private fun readLexiconState(path: String, trackLines: Boolean): LexiconFileState? {
+        if (path.isBlank()) return null
+        val file = File(path)
+        if (!file.isFile) return null
+        val lines = if (trackLines && file.length() <= MAX_DELTA_TRACKED_BYTES && !isBinaryLexicon(file)) {
+            val map = LinkedHashMap<String, String>()
+            file.forEachLine { raw ->
+                val line = raw.trim()
+                lexiconKey(line)?.let { map[it] = line }
+            }
+            map
+        } else {
+            null
+        }
+        return LexiconFileState(path, file.lastModified(), file.length(), lines)
+    }
+
+    /**
+     * 新旧内容的差异：新增 / 修改的行原样下发。
+     * 增量层位于用户层与基础词典之上，`!词` 会连同基础词典一起屏蔽，无法表达「只删用户词条」，
+     * 因此有词条被删除时返回 null，由调用方整体重载用户层（用户词典通常很小）。
+     */
+    private fun diffLexicon(old: Map<String, String>?, new: Map<String, String>?): List<String>? {
+        if (old == null || new == null) return null
+        if (old.keys.any { it !in new }) return null
+        val delta = ArrayList<String>()
+        for ((key, line) in new) {
+            if (old[key] != line) delta.add(line)
+        }
+        return delta
+    }
+
+    /**
+     * 与 native ParseLexiconLine 一致：`!` 开头为删除，含 Tab 时 Tab 前整段为词条，否则首个词为词条。
+     * native 会忽略的无效行返回 null（按未出现处理，旧词条随之删除）。
+     * 词条按 native 的规范形式（NFC + 大小写折叠）比较，"Привет" 与 "привет" 视为同一词条。
+     */
+    private fun lexiconKey(line: String): String? =
+        rawLexiconKey(line)?.let { Normalizer.normalize(it.lowercase(Locale.ROOT), Normalizer.Form.NFC) }
+
+    private fun rawLexiconKey(line: String): String? {
+        if (line.isEmpty()) return null
+        if (line.startsWith("!")) {
+            return line.substring(1).trim().split(WHITESPACE).joinToString(" ").ifEmpty { null }
+        }
+        val tab = line.indexOf('\t')
+        if (tab >= 0) {
+            if (line.substring(tab + 1).isBlank()) return null
+            return line.substring(0, tab).trim().split(WHITESPACE).joinToString(" ").ifEmpty { null }
+        }
+        val parts = line.split(WHITESPACE)
+        return if (parts.size >= 2) parts[0] else null
+    }
+
+    private fun isBinaryLexicon(file: File): Boolean {
+        val magic = ByteArray(4)
+        val n = file.inputStream().use { it.read(magic) }
+        return n == 4 && String(magic, Charsets.US_ASCII) == "SLEX"
     }
 }
@@ -49,6 +49,10 @@ class CustomLexiconActivity : AppCompatActivity() {
         for (raw in lines) {
             val line = raw.trim()
             if (line.isEmpty()) continue
+            if (line.startsWith("!")) {
+                if (line.length == 1) return raw
+                continue
+            }
             val parts = line.split(Regex("\\s+"))
             if (parts.size < 2) return raw
         }
@@ -67,6 +67,7 @@ class MainActivity : AppCompatActivity() {
         ttsPrefs.modelPath.takeIf { it.isNotBlank() }?.let { viewModel.setModelPath(it) }
         ttsPrefs.tokensPath.takeIf { it.isNotBlank() }?.let { viewModel.setTokensPath(it) }
         ttsPrefs.lexiconPath.takeIf { it.isNotBlank() }?.let { viewModel.setLexiconPath(it) }
+        viewModel.setUserLexiconPath(ttsPrefs.userLexiconPath)
         autoPlayEnabled = ttsPrefs.autoPlay
         playbackSpeed = ttsPrefs.playbackSpeed
         viewModel.setSpeed(ttsPrefs.ttsSpeed)
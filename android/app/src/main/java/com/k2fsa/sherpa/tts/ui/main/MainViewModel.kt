@@ -53,6 +53,8 @@ class MainViewModel(
     private val _lexiconPath = MutableStateFlow("")
     val lexiconPath: StateFlow<String> = _lexiconPath.asStateFlow()
 
+    private var userLexiconPath: String = ""
+
     /** 生成成功后下发 WAV 路径，由 Activity 播放。 */
     private val _generatedWavPath = MutableSharedFlow<String>()
     val generatedWavPath: SharedFlow<String> = _generatedWavPath
@@ -92,6 +94,10 @@ class MainViewModel(
         _lexiconPath.value = path
     }
 
+    fun setUserLexiconPath(path: String) {
+        userLexiconPath = path
+    }
+
     fun isModelReady(): Boolean = _modelPath.value.isNotBlank() && _tokensPath.value.isNotBlank()
 
     fun initializeTTS() {
@@ -116,6 +122,7 @@ class MainViewModel(
                 modelPath = _modelPath.value,
                 tokensPath = _tokensPath.value,
                 lexiconPath = _lexiconPath.value,
+                userLexiconPath = userLexiconPath,
                 frontendMode = frontendMode,
                 voice = voice,
                 speed = speed
@@ -68,7 +68,7 @@ class SettingsActivity : AppCompatActivity() {
     ) { result ->
         val data = result.data ?: return@registerForActivityResult
         val path = data.getStringExtra(CustomLexiconActivity.EXTRA_LEXICON_PATH) ?: return@registerForActivityResult
-        ttsPrefs.lexiconPath = path
+        ttsPrefs.userLexiconPath = path
         refreshPathViews()
         Toast.makeText(this, getString(R.string.toast_lexicon_updated), Toast.LENGTH_SHORT).show()
     }
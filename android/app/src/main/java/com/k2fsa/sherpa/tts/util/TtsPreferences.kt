@@ -6,7 +6,7 @@ import android.content.SharedPreferences
 /**
  * 统一管理主界面会持久化的轻量设置。
  *
- * 当前仅保存模型路径、词典路径，以及最近播放相关开关；
+ * 当前仅保存模型路径、词典路径（基础词典与自定义词典），以及最近播放相关开关；
  * 不承担运行时状态缓存和复杂配置迁移。
  */
 class TtsPreferences(context: Context) {
@@ -25,6 +25,11 @@ class TtsPreferences(context: Context) {
         get() = prefs.getString(KEY_LEXICON_PATH, null).orEmpty()
         set(value) = prefs.edit().putString(KEY_LEXICON_PATH, value).apply()
 
+    /** 自定义发音词典（由 CustomLexiconActivity 编辑），叠加在 [lexiconPath] 之上。 */
+    var userLexiconPath: String
+        get() = prefs.getString(KEY_USER_LEXICON_PATH, null).orEmpty()
+        set(value) = prefs.edit().putString(KEY_USER_LEXICON_PATH, value).apply()
+
     var autoPlay: Boolean
         get() = prefs.getBoolean(KEY_AUTO_PLAY, true)
         set(value) = prefs.edit().putBoolean(KEY_AUTO_PLAY, value).apply()
@@ -48,6 +53,7 @@ class TtsPreferences(context: Context) {
         private const val KEY_MODEL_PATH = "model_path"
         private const val KEY_TOKENS_PATH = "tokens_path"
         private const val KEY_LEXICON_PATH = "lexicon_path"
+        private const val KEY_USER_LEXICON_PATH = "user_lexicon_path"
         private const val KEY_AUTO_PLAY = "auto_play"
         private const val KEY_PLAYBACK_SPEED = "playback_speed"
         private const val KEY_TTS_SPEED = "tts_speed"
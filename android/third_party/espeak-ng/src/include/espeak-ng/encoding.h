@@ -84,6 +84,17 @@ text_decoder_decode_string_multibyte(espeak_ng_TEXT_DECODER *decoder,
                                      espeak_ng_ENCODING encoding,
                                      int flags);
 
+/* Same as text_decoder_decode_string_multibyte, but the input is length
+ * characters long (wchar_t for espeakCHARS_WCHAR, bytes otherwise) instead
+ * of running up to and including its terminating NUL. A negative length
+ * behaves like text_decoder_decode_string_multibyte. */
+ESPEAK_NG_API espeak_ng_STATUS
+text_decoder_decode_string_multibyte_length(espeak_ng_TEXT_DECODER *decoder,
+                                            const void *input,
+                                            int length,
+                                            espeak_ng_ENCODING encoding,
+                                            int flags);
+
 ESPEAK_NG_API int
 text_decoder_eof(espeak_ng_TEXT_DECODER *decoder);
 
@@ -215,6 +215,71 @@ espeak_ng_SetConstF0(int f0);
 ESPEAK_NG_API espeak_ng_STATUS
 espeak_ng_SetRandSeed(long seed);
 
+/* Re-entrant text to phoneme translation.
+ *
+ * A phonemizer holds its own voice, translators and clause buffers, so that
+ * phonemizers can translate text on different threads at the same time. The
+ * phoneme data and the dictionaries are shared read-only between them.
+ * Call after espeak_ng_Initialize; destroy every phonemizer before
+ * espeak_ng_Terminate or re-initializing with another data path.
+ *
+ * A phonemizer must not be used by two threads at once. */
+
+#define ESPEAK_NG_HAVE_PHONEMIZER 1
+
+typedef struct espeak_ng_PHONEMIZER_ espeak_ng_PHONEMIZER;
+
+ESPEAK_NG_API espeak_ng_STATUS
+espeak_ng_CreatePhonemizer(const char *voice_name,
+                           espeak_ng_PHONEMIZER **phonemizer);
+
+/* Selects another voice for the phonemizer. The voices that a phonemizer
+ * has used recently stay loaded, so that switching back to one of them does
+ * not read the voice file and dictionary again. */
+ESPEAK_NG_API espeak_ng_STATUS
+espeak_ng_SetPhonemizerVoice(espeak_ng_PHONEMIZER *phonemizer,
+                             const char *voice_name);
+
+/* Same as espeak_TextToPhonemesWithTerminator, translating with the
+ * phonemizer. The result is valid until the next call with the phonemizer. */
+ESPEAK_NG_API const char *
+espeak_ng_PhonemizeClause(espeak_ng_PHONEMIZER *phonemizer,
+                          const void **textptr,
+                          int textmode,
+                          int phonememode,
+                          int *terminator);
+
+ESPEAK_NG_API void
+espeak_ng_DestroyPhonemizer(espeak_ng_PHONEMIZER *phonemizer);
+
+/* Clause by clause translation of a whole document.
+ *
+ * espeak_TextToPhonemes finds the end of the remaining text with strlen on
+ * every call, so translating a long document clause by clause is quadratic
+ * in its length. These take the end of the text instead: textend points one
+ * past its last character, which for NUL-terminated text is one past the NUL
+ * (the NUL is then read as espeak_TextToPhonemes reads it). Compute it once
+ * per document and pass it with every clause. */
+
+#define ESPEAK_NG_HAVE_TEXT_RANGE 1
+
+/* Same as espeak_TextToPhonemesWithTerminator, for text ending at textend. */
+ESPEAK_NG_API const char *
+espeak_ng_TextToPhonemesInRange(const void **textptr,
+                                const void *textend,
+                                int textmode,
+                                int phonememode,
+                                int *terminator);
+
+/* Same as espeak_ng_PhonemizeClause, for text ending at textend. */
+ESPEAK_NG_API const char *
+espeak_ng_PhonemizeClauseInRange(espeak_ng_PHONEMIZER *phonemizer,
+                                 const void **textptr,
+                                 const void *textend,
+                                 int textmode,
+                                 int phonememode,
+                                 int *terminator);
+
 
 #ifdef __cplusplus
 }
@@ -46,6 +46,7 @@
 #include "translate.h"                // for utf8_out, utf8_in
 #include "voice.h"                    // for LoadVoice, voice
 #include "wavegen.h"                  // for WavegenInit, WavegenSetVoice
+#include "phonemizer.h"               // for voice
 
 static int CalculateSample(unsigned char c3, int c1);
 
@@ -41,6 +41,9 @@
 #include "phoneme.h"              // for PHONEME_TAB_LIST, phonSWITCH, phone...
 #include "speech.h"		// for path_home
 #include "synthesize.h"           // for Write4Bytes
+#include "phonemizer.h"           // for CurrentPhonemizer, translator, word...
+
+#undef word_phonemes // a CompileContext field here
 
 static const MNEM_TAB mnem_rules[] = {
 	{ "unpr",     DOLLAR_UNPR },
@@ -1523,7 +1526,7 @@ static espeak_ng_STATUS compile_dictrules(CompileContext *ctx, FILE *f_in, FILE
 ESPEAK_NG_API espeak_ng_STATUS espeak_ng_CompileDictionary(const char *dsource, const char *dict_name, FILE *log, int flags, espeak_ng_ERROR_CONTEXT *context)
 {
 	if (!log) log = stderr;
-	if (!dict_name) dict_name = dictionary_name;
+	if (!dict_name) dict_name = CurrentPhonemizer()->dictionary_name;
 
 	// fname:  space to write the filename in case of error
 	// flags: bit 0:  include source line number information, for debug purposes.
@@ -27,6 +27,7 @@
 #include <wctype.h>
 #include <wchar.h>
 #include <assert.h>
+#include <sys/stat.h>
 
 #include <espeak-ng/espeak_ng.h>
 #include <espeak-ng/speak_lib.h>
@@ -42,6 +43,7 @@
 #include "synthdata.h"                     // for PhonemeCode, InterpretPhoneme
 #include "synthesize.h"                    // for STRESS_IS_PRIMARY, phoneme...
 #include "translate.h"                     // for Translator, utf8_in, LANGU...
+#include "phonemizer.h"                    // for CurrentPhonemizer, translator, opti...
 
 static int LookupFlags(Translator *tr, const char *word, unsigned int flags_out[2]);
 static void DollarRule(char *word[], char *word_start, int consumed, int group_length, char *word_buf, Translator *tr, int command, int *failed, int *add_points);
@@ -54,8 +56,8 @@ typedef struct {
 } MatchRecord;
 
 
-int dictionary_skipwords;
-char dictionary_name[40];
+// dictionary_skipwords and the name of the currently loaded dictionary are held
+// by the current phonemizer, see phonemizer.h
 
 // accented characters which indicate (in some languages) the start of a separate syllable
 static const unsigned short diereses_list[7] = { 0xe4, 0xeb, 0xef, 0xf6, 0xfc, 0xff, 0 };
@@ -137,7 +139,7 @@ static void InitGroups(Translator *tr)
 	// a RULE_GROUP_END.
 	if (*p != RULE_GROUP_END) while (*p != 0) {
 		if (*p != RULE_GROUP_START) {
-			fprintf(stderr, "Bad rules data in '%s_dict' at 0x%x (%c)\n", dictionary_name, (unsigned int)(p - tr->data_dictrules), *p);
+			fprintf(stderr, "Bad rules data in '%s_dict' at 0x%x (%c)\n", CurrentPhonemizer()->dictionary_name, (unsigned int)(p - tr->data_dictrules), *p);
 			break;
 		}
 		p++;
@@ -193,18 +195,124 @@ static void InitGroups(Translator *tr)
 	}
 }
 
+// Dictionary data is not modified once loaded, so the translators of all
+// phonemizers that use a dictionary share one copy of it. Dictionaries that
+// are no longer referenced stay cached until their slot is needed, so that
+// switching back to a voice does not read the file again.
+#define N_DICTIONARY_CACHE  16
+
+typedef struct {
+	char fname[sizeof(path_home)+20];
+	off_t size;
+	time_t mtime;
+	char *data;       // NULL if the slot is free
+	int data_size;
+	int refs;
+	unsigned int last_used;
+} DICTIONARY_CACHE;
+
+static DICTIONARY_CACHE dictionary_cache[N_DICTIONARY_CACHE];
+static unsigned int dictionary_cache_clock = 0;
+
+static int AcquireDictionary(const char *fname, int no_error, char **data, int *size)
+{
+	// Returns 0 and a reference to the dictionary data, or 1 if the file
+	// can't be read, 3 if out of memory.
+	struct stat statbuf;
+	DICTIONARY_CACHE *entry = NULL;
+	FILE *f = NULL;
+	int ix;
+	int result = 0;
+
+	if ((stat(fname, &statbuf) != 0) || (statbuf.st_size <= 0)) {
+		if (no_error == 0)
+			fprintf(stderr, "Can't read dictionary file: '%s'\n", fname);
+		return 1;
+	}
+
+	LockDictionaries();
+
+	dictionary_cache_clock++;
+	for (ix = 0; ix < N_DICTIONARY_CACHE; ix++) {
+		DICTIONARY_CACHE *e = &dictionary_cache[ix];
+		if ((e->data != NULL) && (e->size == statbuf.st_size) && (e->mtime == statbuf.st_mtime) && (strcmp(e->fname, fname) == 0)) {
+			e->refs++;
+			e->last_used = dictionary_cache_clock;
+			*data = e->data;
+			*size = e->data_size;
+			UnlockDictionaries();
+			return 0;
+		}
+		// prefer a free slot, else the least recently used unreferenced one
+		if (e->refs == 0) {
+			if ((entry == NULL) || ((entry->data != NULL) && ((e->data == NULL) || (e->last_used < entry->last_used))))
+				entry = e;
+		}
+	}
+
+	if (entry != NULL && entry->data != NULL) {
+		free(entry->data);
+		entry->data = NULL;
+	}
+
+	if ((f = fopen(fname, "rb")) == NULL) {
+		if (no_error == 0)
+			fprintf(stderr, "Can't read dictionary file: '%s'\n", fname);
+		result = 1;
+	} else if ((*data = malloc(statbuf.st_size)) == NULL)
+		result = 3;
+	else {
+		*size = fread(*data, 1, statbuf.st_size, f);
+		if (entry != NULL) {
+			// when the cache is full the data is owned by the translator alone
+			strncpy0(entry->fname, fname, sizeof(entry->fname));
+			entry->size = statbuf.st_size;
+			entry->mtime = statbuf.st_mtime;
+			entry->data = *data;
+			entry->data_size = *size;
+			entry->refs = 1;
+			entry->last_used = dictionary_cache_clock;
+		}
+	}
+	if (f != NULL)
+		fclose(f);
+
+	UnlockDictionaries();
+	return result;
+}
+
+void ReleaseDictionary(char *data)
+{
+	int ix;
+
+	if (data == NULL)
+		return;
+
+	LockDictionaries();
+	for (ix = 0; ix < N_DICTIONARY_CACHE; ix++) {
+		DICTIONARY_CACHE *e = &dictionary_cache[ix];
+		if (e->data == data) {
+			e->refs--; // kept until the slot is reused
+			UnlockDictionaries();
+			return;
+		}
+	}
+	UnlockDictionaries();
+	free(data);
+}
+
 int LoadDictionary(Translator *tr, const char *name, int no_error)
 {
 	int hash;
 	char *p;
 	int *pw;
 	int length;
-	FILE *f;
-	int size;
+	int size = 0;
+	int result;
 	char fname[sizeof(path_home)+20];
 
-	if (dictionary_name != name)
-		strncpy(dictionary_name, name, 40); // currently loaded dictionary name
+	if (CurrentPhonemizer()->dictionary_name != name)
+		strncpy(CurrentPhonemizer()->dictionary_name, name, 40); // currently loaded dictionary name
 	if (tr->dictionary_name != name)
 		strncpy(tr->dictionary_name, name, 40);
 
@@ -212,28 +320,14 @@ int LoadDictionary(Translator *tr, const char *name, int no_error)
 	// bytes 0-3:  offset to rules data
 	// bytes 4-7:  number of hash table entries
 	sprintf(fname, "%s%c%s_dict", path_home, PATHSEP, name);
-	size = GetFileLength(fname);
 
 	if (tr->data_dictlist != NULL) {
-		free(tr->data_dictlist);
+		ReleaseDictionary(tr->data_dictlist);
 		tr->data_dictlist = NULL;
 	}
 
-	f = fopen(fname, "rb");
-	if ((f == NULL) || (size <= 0)) {
-		if (no_error == 0)
-			fprintf(stderr, "Can't read dictionary file: '%s'\n", fname);
-		if (f != NULL)
-			fclose(f);
-		return 1;
-	}
-
-	if ((tr->data_dictlist = malloc(size)) == NULL) {
-		fclose(f);
-		return 3;
-	}
-	size = fread(tr->data_dictlist, 1, size, f);
-	fclose(f);
+	if ((result = AcquireDictionary(fname, no_error, &tr->data_dictlist, &size)) != 0)
+		return result;
 
 	pw = (int *)(tr->data_dictlist);
 	length = Reverse4Bytes(pw[1]);
@@ -435,8 +529,8 @@ static const unsigned short ipa1[96] = {
 };
 
 #define N_PHON_OUT  500  // realloc increment
-static char *phon_out_buf = NULL;   // passes the result of GetTranslatedPhonemeString()
-static unsigned int phon_out_size = 0;
+#define phon_out_buf            (CurrentPhonemizer()->phon_out_buf) // passes the result of GetTranslatedPhonemeString()
+#define phon_out_size           (CurrentPhonemizer()->phon_out_size)
 
 char *WritePhMnemonic(char *phon_out, PHONEME_TAB *ph, PHONEME_LIST *plist, int use_ipa, int *flags)
 {
@@ -2180,12 +2274,12 @@ int TranslateRules(Translator *tr, char *p_start, char *phonemes, int ph_size, c
 
 						// is it a bracket ?
 						if (letter == 0xe000+'(') {
-							if (pre_pause < tr->langopts.param[LOPT_BRACKET_PAUSE_ANNOUNCED])
-								pre_pause = tr->langopts.param[LOPT_BRACKET_PAUSE_ANNOUNCED]; // a bracket, already spoken by AnnouncePunctuation()
+							if (CurrentPhonemizer()->pre_pause < tr->langopts.param[LOPT_BRACKET_PAUSE_ANNOUNCED])
+								CurrentPhonemizer()->pre_pause = tr->langopts.param[LOPT_BRACKET_PAUSE_ANNOUNCED]; // a bracket, already spoken by AnnouncePunctuation()
 						}
 						if (IsBracket(letter)) {
-							if (pre_pause < tr->langopts.param[LOPT_BRACKET_PAUSE])
-								pre_pause = tr->langopts.param[LOPT_BRACKET_PAUSE];
+							if (CurrentPhonemizer()->pre_pause < tr->langopts.param[LOPT_BRACKET_PAUSE])
+								CurrentPhonemizer()->pre_pause = tr->langopts.param[LOPT_BRACKET_PAUSE];
 						}
 
 						// no match, try removing the accent and re-translating the word
@@ -2690,9 +2784,9 @@ int LookupDictList(Translator *tr, char **wordptr, char *ph_out, unsigned int *f
 	int nbytes;
 	int len;
 	char word[N_WORD_BYTES];
-	static char word_replacement[N_WORD_BYTES];
+	char *word_replacement = CurrentPhonemizer()->word_replacement;
 
-	MAKE_MEM_UNDEFINED(&word_replacement, sizeof(word_replacement));
+	MAKE_MEM_UNDEFINED(word_replacement, sizeof(CurrentPhonemizer()->word_replacement));
 
 	length = 0;
 	word2 = word1 = *wordptr;
@@ -2807,7 +2901,6 @@ int LookupDictList(Translator *tr, char **wordptr, char *ph_out, unsigned int *f
 	return 0;
 }
 
-extern char word_phonemes[N_WORD_PHONEMES]; // a word translated into phoneme codes
 
 int Lookup(Translator *tr, const char *word, char *ph_out)
 {
@@ -2844,7 +2937,7 @@ int Lookup(Translator *tr, const char *word, char *ph_out)
 static int LookupFlags(Translator *tr, const char *word, unsigned int flags_out[2])
 {
 	char buf[100];
-	static unsigned int flags[2];
+	unsigned int flags[2];
 	char *word1 = (char *)word;
 
 	flags[0] = flags[1] = 0;
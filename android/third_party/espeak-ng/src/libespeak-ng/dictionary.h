@@ -34,6 +34,7 @@ extern "C"
 extern const char stress_phonemes[];
 
 int LoadDictionary(Translator *tr, const char *name, int no_error);
+void ReleaseDictionary(char *data);
 int HashDictionary(const char *string);
 const char *EncodePhonemes(const char *p, char *outptr, int *bad_phoneme);
 void DecodePhonemes(const char *inptr, char *outptr);
@@ -30,7 +30,8 @@
 #include "compiledict.h"
 
 #include "synthesize.h"           // for espeakINITIALIZE_PHONEME_IPA
-#include "translate.h"            // for dictionary_name, option_phoneme_events
+#include "translate.h"            // for option_phoneme_events
+#include "phonemizer.h"           // for CurrentPhonemizer
 
 static espeak_ERROR status_to_espeak_error(espeak_ng_STATUS status)
 {
@@ -153,7 +154,7 @@ ESPEAK_API espeak_ERROR espeak_Terminate(void)
 ESPEAK_API void espeak_CompileDictionary(const char *path, FILE *log, int flags)
 {
 	espeak_ng_ERROR_CONTEXT context = NULL;
-	espeak_ng_STATUS result = espeak_ng_CompileDictionary(path, dictionary_name, log, flags, &context);
+	espeak_ng_STATUS result = espeak_ng_CompileDictionary(path, CurrentPhonemizer()->dictionary_name, log, flags, &context);
 	if (result != ENS_OK) {
 		espeak_ng_PrintStatusCodeMessage(result, stderr, context);
 		espeak_ng_ClearErrorContext(&context);
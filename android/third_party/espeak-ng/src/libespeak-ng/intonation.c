@@ -33,6 +33,7 @@
 #include "synthdata.h"   // for PhonemeCode
 #include "synthesize.h"  // for PHONEME_LIST, TUNE, phoneme_list, phoneme_tab
 #include "translate.h"   // for Translator, LANGUAGE_OPTIONS, L, OPTION_EMPH...
+#include "phonemizer.h"  // for phoneme_tab, n_phoneme_list, phonem...
 
 /* Note this module is mostly old code that needs to be rewritten to
    provide a more flexible intonation system.
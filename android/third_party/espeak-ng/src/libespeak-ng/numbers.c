@@ -42,6 +42,7 @@
 #include "synthesize.h"  // for phoneme_tab
 #include "translate.h"   // for Translator, LANGUAGE_OPTIONS, WOR...
 #include "voice.h"       // for voice, voice_t
+#include "phonemizer.h"  // for CurrentPhonemizer, voice, translato...
 
 #define M_LIGATURE  0x8000
 #define M_NAME      0
@@ -72,10 +73,11 @@
 #define M_MIDDLE_DOT  M_DOT_ABOVE // duplicate of M_DOT_ABOVE
 #define M_IMPLOSIVE   M_HOOK
 
-static int n_digit_lookup;
-static char *digit_lookup;
-static int speak_missing_thousands;
-static int number_control;
+// the number translation state is held by the current phonemizer, see phonemizer.h
+#define n_digit_lookup          (CurrentPhonemizer()->n_digit_lookup)
+#define digit_lookup            (CurrentPhonemizer()->digit_lookup)
+#define speak_missing_thousands (CurrentPhonemizer()->speak_missing_thousands)
+#define number_control          (CurrentPhonemizer()->number_control)
 
 typedef struct {
 	const char *name;
@@ -687,8 +689,8 @@ void SetSpellingStress(Translator *tr, char *phonemes, int control, int n_chars)
 
 // Numbers
 
-static char ph_ordinal2[12];
-static char ph_ordinal2x[12];
+#define ph_ordinal2             (CurrentPhonemizer()->ph_ordinal2)
+#define ph_ordinal2x            (CurrentPhonemizer()->ph_ordinal2x)
 
 static int CheckDotOrdinal(Translator *tr, char *word, char *word_end, WORD_TAB *wtab, int roman)
 {
@@ -248,8 +248,6 @@ phoneme_add_feature(PHONEME_TAB *phoneme,
 
 // Several phoneme tables may be loaded into memory. phoneme_tab points to
 // one for the current voice
-extern int n_phoneme_tab;
-extern PHONEME_TAB *phoneme_tab[N_PHONEME_TAB];
 
 typedef struct {
 	char name[N_PHONEME_TAB_NAME];
@@ -266,8 +264,6 @@ typedef struct {
 	char type;   // 0=always replace, 1=only at end of word
 } REPLACE_PHONEMES;
 
-extern int n_replace_phonemes;
-extern REPLACE_PHONEMES replace_phonemes[N_REPLACE_PHONEMES];
 
 // Table of phoneme programs and lengths.  Used by MakeVowelLists
 typedef struct {
@@ -278,7 +274,6 @@ typedef struct {
 #define PhonemeCode2(c1, c2) PhonemeCode((c2<<8)+c1)
 
 extern PHONEME_TAB_LIST phoneme_tab_list[N_PHONEME_TABS];
-extern int phoneme_tab_number;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 The sherpa-tts authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see: <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <espeak-ng/espeak_ng.h>
+#include <espeak-ng/speak_lib.h>
+#include <espeak-ng/encoding.h>
+
+#include "phonemizer.h"
+#include "translate.h"            // for DeleteTranslator
+#include "voice.h"                // for LoadVoiceByName
+
+#undef voice // the initializer below names the field
+
+// used by the classic API, and by any thread that has no phonemizer bound
+PHONEMIZER default_phonemizer = {
+	.voice = &default_phonemizer.voicedata,
+	.ungot_string_ix = -1,
+};
+
+ESPEAK_THREAD_LOCAL PHONEMIZER *bound_phonemizer = NULL;
+
+#if defined(_WIN32) || defined(_WIN64)
+static SRWLOCK voices_lock = SRWLOCK_INIT;
+static SRWLOCK dictionaries_lock = SRWLOCK_INIT;
+
+void LockVoices(void) { AcquireSRWLockExclusive(&voices_lock); }
+void UnlockVoices(void) { ReleaseSRWLockExclusive(&voices_lock); }
+void LockDictionaries(void) { AcquireSRWLockExclusive(&dictionaries_lock); }
+void UnlockDictionaries(void) { ReleaseSRWLockExclusive(&dictionaries_lock); }
+#else
+static pthread_mutex_t voices_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t dictionaries_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void LockVoices(void) { pthread_mutex_lock(&voices_lock); }
+void UnlockVoices(void) { pthread_mutex_unlock(&voices_lock); }
+void LockDictionaries(void) { pthread_mutex_lock(&dictionaries_lock); }
+void UnlockDictionaries(void) { pthread_mutex_unlock(&dictionaries_lock); }
+#endif
+
+ESPEAK_NG_API espeak_ng_STATUS
+espeak_ng_CreatePhonemizer(const char *voice_name, espeak_ng_PHONEMIZER **phonemizer)
+{
+	PHONEMIZER *ph;
+	PHONEMIZER *previous;
+	espeak_ng_STATUS status;
+
+	if (phonemizer == NULL)
+		return EINVAL;
+	*phonemizer = NULL;
+
+	if ((ph = (PHONEMIZER *)calloc(1, sizeof(PHONEMIZER))) == NULL)
+		return ENOMEM;
+	ph->voice = &ph->voicedata;
+	ph->ungot_string_ix = -1;
+	ph->current_phoneme_table = -1;
+
+	previous = bound_phonemizer;
+	bound_phonemizer = ph;
+	status = LoadVoiceByName(voice_name != NULL ? voice_name : ESPEAKNG_DEFAULT_VOICE, NULL);
+	bound_phonemizer = previous;
+
+	if (status != ENS_OK) {
+		espeak_ng_DestroyPhonemizer(ph);
+		return status;
+	}
+	*phonemizer = ph;
+	return ENS_OK;
+}
+
+ESPEAK_NG_API espeak_ng_STATUS
+espeak_ng_SetPhonemizerVoice(espeak_ng_PHONEMIZER *phonemizer, const char *voice_name)
+{
+	PHONEMIZER *previous;
+	espeak_ng_STATUS status;
+
+	if (phonemizer == NULL || voice_name == NULL)
+		return EINVAL;
+
+	previous = bound_phonemizer;
+	bound_phonemizer = phonemizer;
+	status = LoadVoiceByName(voice_name, NULL);
+	bound_phonemizer = previous;
+	return status;
+}
+
+ESPEAK_NG_API const char *
+espeak_ng_PhonemizeClause(espeak_ng_PHONEMIZER *phonemizer,
+                          const void **textptr,
+                          int textmode,
+                          int phonememode,
+                          int *terminator)
+{
+	PHONEMIZER *previous;
+	const char *phonemes;
+
+	if (phonemizer == NULL)
+		return NULL;
+
+	previous = bound_phonemizer;
+	bound_phonemizer = phonemizer;
+	phonemes = espeak_TextToPhonemesWithTerminator(textptr, textmode, phonememode, terminator);
+	bound_phonemizer = previous;
+	return phonemes;
+}
+
+ESPEAK_NG_API const char *
+espeak_ng_PhonemizeClauseInRange(espeak_ng_PHONEMIZER *phonemizer,
+                                 const void **textptr,
+                                 const void *textend,
+                                 int textmode,
+                                 int phonememode,
+                                 int *terminator)
+{
+	PHONEMIZER *previous;
+	const char *phonemes;
+
+	if (phonemizer == NULL)
+		return NULL;
+
+	previous = bound_phonemizer;
+	bound_phonemizer = phonemizer;
+	phonemes = espeak_ng_TextToPhonemesInRange(textptr, textend, textmode, phonememode, terminator);
+	bound_phonemizer = previous;
+	return phonemes;
+}
+
+ESPEAK_NG_API void
+espeak_ng_DestroyPhonemizer(espeak_ng_PHONEMIZER *phonemizer)
+{
+	PHONEMIZER *previous;
+
+	if (phonemizer == NULL || phonemizer == &default_phonemizer)
+		return;
+
+	previous = bound_phonemizer;
+	bound_phonemizer = phonemizer;
+	FreeVoiceCache();
+	DeleteTranslator(translator);
+	DeleteTranslator(translator2);
+	DeleteTranslator(translator3);
+	translator = translator2 = translator3 = NULL;
+	if (p_decoder != NULL)
+		destroy_text_decoder(p_decoder);
+	free(phonemizer->phon_out_buf);
+	bound_phonemizer = previous;
+
+	free(phonemizer);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 The sherpa-tts authors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see: <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESPEAK_NG_PHONEMIZER_H
+#define ESPEAK_NG_PHONEMIZER_H
+
+#include <stdbool.h>
+
+#include <espeak-ng/espeak_ng.h>
+#include <espeak-ng/encoding.h>
+
+#include "phoneme.h"
+#include "readclause.h"
+#include "synthesize.h"
+#include "translate.h"
+#include "voice.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if defined(_MSC_VER)
+#define ESPEAK_THREAD_LOCAL __declspec(thread)
+#else
+#define ESPEAK_THREAD_LOCAL __thread
+#endif
+
+// A voice loaded by LoadVoiceByName(), kept so that selecting it again only
+// switches to its voice data and translator.
+#define N_VOICE_CACHE  4
+
+typedef struct {
+	char name[60];           // lower case, including any variant
+	unsigned int last_used;  // 0 if the slot is free
+	voice_t voice_data;
+	Translator *tr;          // owned by the cache
+	int n_replace;
+	REPLACE_PHONEMES replace[N_REPLACE_PHONEMES];
+	espeak_VOICE voice_selected;
+	char voice_identifier[40];
+	char voice_name[40];
+	char voice_languages[100];
+	int fast_settings;
+} VOICE_CACHE;
+
+// The mutable state of the text -> phoneme translation path: the selected
+// voice, its translators and phoneme table, and the clause buffers.
+//
+// The classic API works on a single default phonemizer, as before. An
+// espeak_ng_PHONEMIZER created by espeak_ng_CreatePhonemizer() has its own
+// copy of this state and is bound to the calling thread for the duration of
+// espeak_ng_PhonemizeClause(), so that phonemizers on different threads do
+// not share anything writable. Phoneme data and dictionaries are loaded once
+// and shared read-only.
+struct espeak_ng_PHONEMIZER_ {
+	// voices.c
+	voice_t *voice;
+	voice_t voicedata;
+	VOICE_CACHE voice_cache[N_VOICE_CACHE];
+	unsigned int voice_cache_clock;
+
+	// translate.c
+	Translator *translator;
+	Translator *translator2;
+	char translator2_language[20];
+	Translator *translator3;
+	char translator3_language[20];
+	int option_sayas;
+	int option_sayas2;
+	int option_emphasis;
+	int count_sayas_digits;
+	bool skipping_text; // waiting until word count, sentence count, or named marker is reached
+	int count_sentences;
+	int count_words;
+	int clause_start_char;
+	int clause_start_word;
+	bool new_sentence;
+	int word_emphasis;
+	int embedded_flag;
+	int max_clause_pause;
+	bool any_stressed_words;
+	int pre_pause;
+	ALPHABET *current_alphabet;
+	char word_phonemes[N_WORD_PHONEMES]; // a word translated into phoneme codes
+	int n_ph_list2;
+	PHONEME_LIST2 ph_list2[N_PHONEME_LIST]; // first stage of text->phonemes
+	int embedded_ix;
+	int embedded_read;
+	unsigned int embedded_list[N_EMBEDDED_LIST];
+	char source[N_TR_SOURCE+40];
+	int n_replace_phonemes;
+	REPLACE_PHONEMES replace_phonemes[N_REPLACE_PHONEMES];
+	int ignore_next_n;
+	char voice_change_name[40];
+
+	// dictionary.c
+	int dictionary_skipwords;
+	char dictionary_name[40];
+	char *phon_out_buf;
+	unsigned int phon_out_size;
+	char word_replacement[N_WORD_BYTES]; // returned to the caller of LookupDictList()
+
+	// readclause.c
+	espeak_ng_TEXT_DECODER *p_decoder;
+	int ungot_char;
+	int ungot_char2;
+	char ungot_string[N_XML_BUF2+4];
+	int ungot_string_ix;
+	bool ignore_text;
+	bool audio_text;
+	bool clear_skipping_text;
+	int count_characters;
+	int sayas_mode;
+	int sayas_start;
+
+	// numbers.c
+	int n_digit_lookup;
+	char *digit_lookup;
+	int speak_missing_thousands;
+	int number_control;
+	char ph_ordinal2[12];
+	char ph_ordinal2x[12];
+
+	// synthdata.c
+	int n_phoneme_tab;
+	int current_phoneme_table;
+	PHONEME_TAB *phoneme_tab[N_PHONEME_TAB];
+	int phoneme_tab_number;
+
+	// synthesize.c
+	int n_phoneme_list;
+	PHONEME_LIST phoneme_list[N_PHONEME_LIST+1];
+};
+
+typedef struct espeak_ng_PHONEMIZER_ PHONEMIZER;
+
+extern PHONEMIZER default_phonemizer;
+extern ESPEAK_THREAD_LOCAL PHONEMIZER *bound_phonemizer;
+
+// The phonemizer that the calling thread is translating with.
+static inline PHONEMIZER *CurrentPhonemizer(void)
+{
+	PHONEMIZER *ph = bound_phonemizer;
+	return ph != NULL ? ph : &default_phonemizer;
+}
+
+// Voices are loaded one at a time (they fill in shared tables such as the
+// voices list); the dictionary cache has a lock of its own, as dictionaries
+// are also loaded while translating.
+void LockVoices(void);
+void UnlockVoices(void);
+void LockDictionaries(void);
+void UnlockDictionaries(void);
+
+// The globals of the translation path that other modules refer to. The
+// variables private to a module are mapped in that module, and names that
+// clash with struct fields (source, dictionary_name, pre_pause) are accessed
+// through CurrentPhonemizer() directly.
+#define voice                   (CurrentPhonemizer()->voice)
+#define translator              (CurrentPhonemizer()->translator)
+#define translator2             (CurrentPhonemizer()->translator2)
+#define translator3             (CurrentPhonemizer()->translator3)
+#define option_sayas            (CurrentPhonemizer()->option_sayas)
+#define skipping_text           (CurrentPhonemizer()->skipping_text)
+#define count_sentences         (CurrentPhonemizer()->count_sentences)
+#define count_characters        (CurrentPhonemizer()->count_characters)
+#define clause_start_char       (CurrentPhonemizer()->clause_start_char)
+#define clause_start_word       (CurrentPhonemizer()->clause_start_word)
+#define word_phonemes           (CurrentPhonemizer()->word_phonemes)
+#define n_ph_list2              (CurrentPhonemizer()->n_ph_list2)
+#define ph_list2                (CurrentPhonemizer()->ph_list2)
+#define embedded_list           (CurrentPhonemizer()->embedded_list)
+#define n_replace_phonemes      (CurrentPhonemizer()->n_replace_phonemes)
+#define replace_phonemes        (CurrentPhonemizer()->replace_phonemes)
+#define dictionary_skipwords    (CurrentPhonemizer()->dictionary_skipwords)
+#define p_decoder               (CurrentPhonemizer()->p_decoder)
+#define n_phoneme_tab           (CurrentPhonemizer()->n_phoneme_tab)
+#define phoneme_tab             (CurrentPhonemizer()->phoneme_tab)
+#define phoneme_tab_number      (CurrentPhonemizer()->phoneme_tab_number)
+#define n_phoneme_list          (CurrentPhonemizer()->n_phoneme_list)
+#define phoneme_list            (CurrentPhonemizer()->phoneme_list)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -47,6 +47,7 @@
 #include "synthdata.h"            // for SelectPhonemeTable
 #include "translate.h"            // for Translator, utf8_out, CLAUSE_OPTION...
 #include "voice.h"                // for voice, voice_t, espeak_GetCurrentVoice
+#include "phonemizer.h"           // for CurrentPhonemizer, voice, translato...
 
 #define N_XML_BUF   500
 
@@ -59,16 +60,14 @@ static int namedata_ix = 0;
 static int n_namedata = 0;
 char *namedata = NULL;
 
-static int ungot_char2 = 0;
-espeak_ng_TEXT_DECODER *p_decoder = NULL;
-static int ungot_char;
-
-static bool ignore_text = false; // set during <sub> ... </sub>  to ignore text which has been replaced by an alias
-static bool audio_text = false; // set during <audio> ... </audio>
-static bool clear_skipping_text = false; // next clause should clear the skipping_text flag
-int count_characters = 0;
-static int sayas_mode;
-static int sayas_start;
+// the clause reader state is held by the current phonemizer, see phonemizer.h
+#define ungot_char2             (CurrentPhonemizer()->ungot_char2)
+#define ungot_char              (CurrentPhonemizer()->ungot_char)
+#define ignore_text             (CurrentPhonemizer()->ignore_text) // set during <sub> ... </sub>  to ignore text which has been replaced by an alias
+#define audio_text              (CurrentPhonemizer()->audio_text) // set during <audio> ... </audio>
+#define clear_skipping_text     (CurrentPhonemizer()->clear_skipping_text) // next clause should clear the skipping_text flag
+#define sayas_mode              (CurrentPhonemizer()->sayas_mode)
+#define sayas_start             (CurrentPhonemizer()->sayas_start)
 
 #define N_SSML_STACK  20
 static int n_ssml_stack;
@@ -498,10 +497,8 @@ int ReadClause(Translator *tr, char *buf, short *charix, int *charix_top, int n_
 	int end_clause_index = 0;
 	wchar_t xml_buf[N_XML_BUF+1];
 
-	#define N_XML_BUF2 20
 	char xml_buf2[N_XML_BUF2+2]; // for &<name> and &<number> sequences
-	static char ungot_string[N_XML_BUF2+4];
-	static int ungot_string_ix = -1;
+	PHONEMIZER *ph = CurrentPhonemizer(); // holds ungot_string
 
 	if (clear_skipping_text) {
 		skipping_text = false;
@@ -522,7 +519,7 @@ int ReadClause(Translator *tr, char *buf, short *charix, int *charix_top, int n_
 		c2 = GetC();
 	}
 
-	while (!Eof() || (ungot_char != 0) || (ungot_char2 != 0) || (ungot_string_ix >= 0)) {
+	while (!Eof() || (ungot_char != 0) || (ungot_char2 != 0) || (ph->ungot_string_ix >= 0)) {
 		if (!iswalnum(c1)) {
 			if ((end_character_position > 0) && (count_characters > end_character_position)) {
 				return CLAUSE_EOF;
@@ -541,17 +538,17 @@ int ReadClause(Translator *tr, char *buf, short *charix, int *charix_top, int n_
 		cprev = c1;
 		c1 = c2;
 
-		if (ungot_string_ix >= 0) {
-			if (ungot_string[ungot_string_ix] == 0) {
-				MAKE_MEM_UNDEFINED(&ungot_string, sizeof(ungot_string));
-				ungot_string_ix = -1;
+		if (ph->ungot_string_ix >= 0) {
+			if (ph->ungot_string[ph->ungot_string_ix] == 0) {
+				MAKE_MEM_UNDEFINED(&ph->ungot_string, sizeof(ph->ungot_string));
+				ph->ungot_string_ix = -1;
 			}
 		}
 
-		if ((ungot_string_ix == 0) && (ungot_char2 == 0))
-			c1 = ungot_string[ungot_string_ix++];
-		if (ungot_string_ix >= 0) {
-			c2 = ungot_string[ungot_string_ix++];
+		if ((ph->ungot_string_ix == 0) && (ungot_char2 == 0))
+			c1 = ph->ungot_string[ph->ungot_string_ix++];
+		if (ph->ungot_string_ix >= 0) {
+			c2 = ph->ungot_string[ph->ungot_string_ix++];
 		} else if (Eof()) {
 			c2 = ' ';
 		} else {
@@ -574,7 +571,7 @@ int ReadClause(Translator *tr, char *buf, short *charix, int *charix_top, int n_
 				} else {
 					c2 = GetC();
 				}
-				sprintf(ungot_string, "%s%c%c", &xml_buf2[0], c1, c2);
+				sprintf(ph->ungot_string, "%s%c%c", &xml_buf2[0], c1, c2);
 
 				int found = -1;
 				if (c1 == ';') {
@@ -582,7 +579,7 @@ int ReadClause(Translator *tr, char *buf, short *charix, int *charix_top, int n_
 				}
 
 				if (found <= 0) {
-					ungot_string_ix = 0;
+					ph->ungot_string_ix = 0;
 					c1 = '&';
 					c2 = ' ';
 				}
@@ -27,6 +27,8 @@ extern "C"
 {
 #endif
 
+#define N_XML_BUF2 20 // for &<name> and &<number> sequences
+
 typedef struct {
 	int type;
 	int parameter[N_SPEECH_PARAM];
@@ -37,8 +37,9 @@
 #include "voice.h"
 #include "synthesize.h"
 #include "translate.h"
+#include "phonemizer.h"
 
-static void SetSpeedFactors(voice_t *voice, int x, int speeds[3]);
+static void SetSpeedFactors(voice_t *v, int x, int speeds[3]);
 static void SetSpeedMods(SPEED_FACTORS *speed, int voiceSpeedF1, int wpm, int x);
 static void SetSpeedMultiplier(int *x, int *wpm);
 
@@ -227,12 +228,12 @@ static void SetSpeedMultiplier(int *x, int *wpm) {
 		*x = 6;
 }
 
-static void SetSpeedFactors(voice_t *voice, int x, int speeds[3]) {
+static void SetSpeedFactors(voice_t *v, int x, int speeds[3]) {
 	// set speed factors for different syllable positions within a word
 	// these are used in CalcLengths()
-	speeds[0] = (x * voice->speedf1)/256;
-	speeds[1] = (x * voice->speedf2)/256;
-	speeds[2] = (x * voice->speedf3)/256;
+	speeds[0] = (x * v->speedf1)/256;
+	speeds[1] = (x * v->speedf2)/256;
+	speeds[2] = (x * v->speedf3)/256;
 
 	if (x <= 7) {
 		speeds[0] = x;
@@ -22,8 +22,10 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <locale.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -62,6 +64,7 @@
 #include "translate.h"            // for p_decoder, InitText, translator
 #include "voice.h"                // for FreeVoiceList, VoiceReset, current_...
 #include "wavegen.h"              // for WavegenFill, WavegenInit, WcmdqUsed
+#include "phonemizer.h"           // for translator, skipping_text, p_decode...
 
 static unsigned char *outbuf = NULL;
 static int outbuf_size = 0;
@@ -372,6 +375,8 @@ ESPEAK_NG_API espeak_ng_STATUS espeak_ng_Initialize(espeak_ng_ERROR_CONTEXT *con
 		}
 	}
 
+	FreeVoiceCache(); // the cached voices refer to the previous phoneme data
+
 	espeak_ng_STATUS result = LoadPhData(&srate, context);
 	if (result != ENS_OK)
 		return result;
@@ -850,6 +855,24 @@ ESPEAK_API void espeak_SetPhonemeTrace(int phonememode, FILE *stream)
 		f_trans = stderr;
 }
 
+// Translates the clause at *textptr, which is length characters long (or
+// NUL-terminated when length < 0), and advances *textptr past it.
+static const char *TextToPhonemesLength(const void **textptr, int length, int textmode, int phonememode, int *terminator)
+{
+	if (p_decoder == NULL)
+		p_decoder = create_text_decoder();
+
+	if (text_decoder_decode_string_multibyte_length(
+	        p_decoder, *textptr, length, translator->encoding, textmode)
+	    != ENS_OK)
+		return NULL;
+
+	TranslateClauseWithTerminator(translator, NULL, NULL, terminator);
+	*textptr = text_decoder_get_buffer(p_decoder);
+
+	return GetTranslatedPhonemeString(phonememode);
+}
+
 // Same as espeak_TextToPhonemes except we also get the clause terminator used (full stop, comma, etc.).
 // Depends on the added TranslateClauseWithTerminator in
 ESPEAK_API const char* espeak_TextToPhonemesWithTerminator(const void** textptr, int textmode, int phonememode, int* terminator)
@@ -861,18 +884,21 @@ ESPEAK_API const char* espeak_TextToPhonemesWithTerminator(const void** textptr,
      phoneme names
    */
 
-  if (p_decoder == NULL)
-    p_decoder = create_text_decoder();
-
-  if (text_decoder_decode_string_multibyte(
-          p_decoder, *textptr, translator->encoding, textmode)
-      != ENS_OK)
-    return NULL;
+  return TextToPhonemesLength(textptr, -1, textmode, phonememode, terminator);
+}
 
-  TranslateClauseWithTerminator(translator, NULL, NULL, terminator);
-  *textptr = text_decoder_get_buffer(p_decoder);
+ESPEAK_NG_API const char *
+espeak_ng_TextToPhonemesInRange(const void **textptr, const void *textend, int textmode, int phonememode, int *terminator)
+{
+	// the decoder is reset at every clause, as espeak_TextToPhonemes does, but
+	// its length comes from textend rather than from rescanning the rest of the text
+	ptrdiff_t length = (const char *)textend - (const char *)*textptr;
 
-  return GetTranslatedPhonemeString(phonememode);
+	if ((textmode & 7) == espeakCHARS_WCHAR)
+		length /= sizeof(wchar_t);
+	if (length < 0 || length > INT_MAX)
+		return NULL;
+	return TextToPhonemesLength(textptr, (int)length, textmode, phonememode, terminator);
 }
 
 ESPEAK_API const char *espeak_TextToPhonemes(const void **textptr, int textmode, int phonememode)
@@ -951,6 +977,7 @@ ESPEAK_NG_API espeak_ng_STATUS espeak_ng_Terminate(void)
 	FreePhData();
 	FreeVoiceList();
 
+	FreeVoiceCache();
 	DeleteTranslator(translator);
 	translator = NULL;
 
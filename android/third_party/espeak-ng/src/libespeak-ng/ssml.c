@@ -48,6 +48,7 @@
 #include "translate.h"            // for CTRL_EMBEDDED
 #include "voice.h"                // for SelectVoice, SelectVoiceByName
 #include "speech.h"               // for MAKE_MEM_UNDEFINED
+#include "phonemizer.h"           // for translator
 
 static const MNEM_TAB ssmltags[] = {
 	{ "speak",     SSML_SPEAK },
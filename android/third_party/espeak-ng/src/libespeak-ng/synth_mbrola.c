@@ -45,6 +45,7 @@
 #include "speech.h"
 #include "synthesize.h"
 #include "translate.h"
+#include "phonemizer.h"
 
 // included here so tests can find these even without OPT_MBROLA set
 int mbrola_delay;
@@ -531,7 +532,7 @@ int MbrolaTranslate(PHONEME_LIST *plist, int n_phonemes, bool resume, FILE *f_mb
 	return 0;
 }
 
-int MbrolaGenerate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
+int MbrolaGenerate(PHONEME_LIST *plist, int *n_ph, bool resume)
 {
 	FILE *f_mbrola = NULL;
 
@@ -543,7 +544,7 @@ int MbrolaGenerate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
 		f_mbrola = f_trans;
 	}
 
-	int  again = MbrolaTranslate(phoneme_list, *n_ph, resume, f_mbrola);
+	int  again = MbrolaTranslate(plist, *n_ph, resume, f_mbrola);
 	if (!again)
 		*n_ph = 0;
 	return again;
@@ -604,9 +605,9 @@ espeak_ng_STATUS LoadMbrolaTable(const char *mbrola_voice, const char *phtrans,
 	return ENS_NOT_SUPPORTED;
 }
 
-int MbrolaGenerate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
+int MbrolaGenerate(PHONEME_LIST *plist, int *n_ph, bool resume)
 {
-	(void)phoneme_list; // unused parameter
+	(void)plist; // unused parameter
 	(void)n_ph; // unused parameter
 	(void)resume; // unused parameter
 	return 0;
@@ -41,16 +41,16 @@
 #include "synthesize.h"               // for PHONEME_LIST, frameref_t, PHONE...
 #include "translate.h"                // for Translator, LANGUAGE_OPTIONS
 #include "voice.h"                    // for ReadTonePoints, tone_points, voice
+#include "phonemizer.h"               // for CurrentPhonemizer, voice, n_phoneme...
 
 int n_tunes = 0;
 TUNE *tunes = NULL;
 
 const int version_phdata  = 0x014801;
 
-// copy the current phoneme table into here
-int n_phoneme_tab;
-static int current_phoneme_table;
-PHONEME_TAB *phoneme_tab[N_PHONEME_TAB];
+// the current phoneme table (phoneme_tab, n_phoneme_tab) is copied into the
+// current phonemizer, see phonemizer.h
+#define current_phoneme_table   (CurrentPhonemizer()->current_phoneme_table)
 
 static unsigned short *phoneme_index = NULL;
 static char *phondata_ptr = NULL;
@@ -59,7 +59,6 @@ static unsigned char *phoneme_tab_data = NULL;
 
 static int n_phoneme_tables;
 PHONEME_TAB_LIST phoneme_tab_list[N_PHONEME_TABS];
-int phoneme_tab_number = 0;
 
 int seq_len_adjust;
 
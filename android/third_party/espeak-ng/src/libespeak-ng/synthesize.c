@@ -44,12 +44,12 @@
 #include "voice.h"                // for voice_t, voice, LoadVoiceVariant
 #include "wavegen.h"              // for WcmdqInc, WcmdqFree, WcmdqStop
 #include "speech.h"               // for MAKE_MEM_UNDEFINED
+#include "phonemizer.h"           // for voice, translator, skipping_text, c...
 
 static void SmoothSpect(void);
 
-// list of phonemes in a clause
-int n_phoneme_list = 0;
-PHONEME_LIST phoneme_list[N_PHONEME_LIST+1];
+// the list of phonemes in a clause (phoneme_list, n_phoneme_list) is held by
+// the current phonemizer, see phonemizer.h
 
 SPEED_FACTORS speed;
 
@@ -1118,7 +1118,7 @@ void DoEmbedded(int *embix, int sourceix)
 
 extern espeak_ng_OUTPUT_HOOKS* output_hooks;
 
-int Generate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
+int Generate(PHONEME_LIST *plist, int *n_ph, bool resume)
 {
 	static int ix;
 	static int embedded_ix;
@@ -1150,7 +1150,7 @@ int Generate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
 
 #if USE_MBROLA
 	if (mbrola_name[0] != 0)
-		return MbrolaGenerate(phoneme_list, n_ph, resume);
+		return MbrolaGenerate(plist, n_ph, resume);
 #endif
 
 	if (resume == false) {
@@ -1170,7 +1170,7 @@ int Generate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
 	}
 
 	while ((ix < (*n_ph)) && (ix < N_PHONEME_LIST-2)) {
-		p = &phoneme_list[ix];
+		p = &plist[ix];
 		
 		if(output_hooks && output_hooks->outputPhoSymbol)
 		{
@@ -1194,9 +1194,9 @@ int Generate(PHONEME_LIST *phoneme_list, int *n_ph, bool resume)
 		PHONEME_LIST *next;
 		PHONEME_LIST *next2;
 
-		prev = &phoneme_list[ix-1];
-		next = &phoneme_list[ix+1];
-		next2 = &phoneme_list[ix+2];
+		prev = &plist[ix-1];
+		next = &plist[ix+1];
+		next2 = &plist[ix+2];
 
 		if (p->synthflags & SFLAG_EMBEDDED)
 			DoEmbedded(&embedded_ix, p->sourceix);
@@ -34,6 +34,7 @@
 #include "common.h"
 #include "setlengths.h"          // for SetLengthMods
 #include "translate.h"           // for Translator, LANGUAGE_OPTIONS, L, NUM...
+#include "phonemizer.h"          // for CurrentPhonemizer
 
 // start of unicode pages for character sets
 #define OFFSET_GREEK    0x380
@@ -244,7 +245,7 @@ static Translator *NewTranslator(void)
 		return NULL;
 
 	tr->encoding = ESPEAKNG_ENCODING_ISO_8859_1;
-	dictionary_name[0] = 0;
+	CurrentPhonemizer()->dictionary_name[0] = 0;
 	tr->dictionary_name[0] = 0;
 	tr->phonemes_repeat[0] = 0;
 	tr->dict_condition = 0;
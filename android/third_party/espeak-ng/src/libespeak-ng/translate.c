@@ -44,16 +44,29 @@
 #include "voice.h"                // for voice, voice_t
 #include "speech.h"               // for MAKE_MEM_UNDEFINED
 #include "translateword.h"
+#include "phonemizer.h"
 
 static int CalcWordLength(int source_index, int charix_top, short int *charix, WORD_TAB *words, int word_count);
-static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags, unsigned char *p, char *word_phonemes);
-static void SwitchLanguage(char *word, char *word_phonemes);
-
-Translator *translator = NULL; // the main translator
-Translator *translator2 = NULL; // secondary translator for certain words
-static char translator2_language[20] = { 0 };
-Translator *translator3 = NULL; // tertiary translator for certain words
-static char translator3_language[20] = { 0 };
+static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags, unsigned char *p, char *phonemes);
+static void SwitchLanguage(char *word, char *phonemes);
+
+// translator (the main translator), translator2 and translator3 (secondary and
+// tertiary translators for certain words) and the other per-clause state are
+// held by the current phonemizer, see phonemizer.h
+#define translator2_language    (CurrentPhonemizer()->translator2_language)
+#define translator3_language    (CurrentPhonemizer()->translator3_language)
+#define option_sayas2           (CurrentPhonemizer()->option_sayas2) // used in translate_clause()
+#define option_emphasis         (CurrentPhonemizer()->option_emphasis) // 0=normal, 1=normal, 2=weak, 3=moderate, 4=strong
+#define count_sayas_digits      (CurrentPhonemizer()->count_sayas_digits)
+#define count_words             (CurrentPhonemizer()->count_words)
+#define new_sentence            (CurrentPhonemizer()->new_sentence)
+#define word_emphasis           (CurrentPhonemizer()->word_emphasis) // set if emphasis level 3 or 4
+#define embedded_flag           (CurrentPhonemizer()->embedded_flag) // there are embedded commands to be applied to the next phoneme, used in TranslateWord2()
+#define max_clause_pause        (CurrentPhonemizer()->max_clause_pause)
+#define any_stressed_words      (CurrentPhonemizer()->any_stressed_words)
+#define current_alphabet        (CurrentPhonemizer()->current_alphabet)
+#define embedded_ix             (CurrentPhonemizer()->embedded_ix)
+#define embedded_read           (CurrentPhonemizer()->embedded_read)
 
 FILE *f_trans = NULL; // phoneme output text
 int option_tone_flags = 0; // bit 8=emphasize allcaps, bit 9=emphasize penultimate stress
@@ -62,52 +75,23 @@ int option_phoneme_events = 0;
 int option_endpause = 0; // suppress pause after end of text
 int option_capitals = 0;
 int option_punctuation = 0;
-int option_sayas = 0;
-static int option_sayas2 = 0; // used in translate_clause()
-static int option_emphasis = 0; // 0=normal, 1=normal, 2=weak, 3=moderate, 4=strong
 int option_ssml = 0;
 int option_phoneme_input = 0; // allow [[phonemes]] in input
 int option_wordgap = 0;
 
-static int count_sayas_digits;
 int skip_sentences;
 int skip_words;
 int skip_characters;
 char skip_marker[N_MARKER_LENGTH];
-bool skipping_text; // waiting until word count, sentence count, or named marker is reached
 int end_character_position;
-int count_sentences;
-static int count_words;
-int clause_start_char;
-int clause_start_word;
-static bool new_sentence;
-static int word_emphasis = 0; // set if emphasis level 3 or 4
-static int embedded_flag = 0; // there are embedded commands to be applied to the next phoneme, used in TranslateWord2()
-
-static int max_clause_pause = 0;
-static bool any_stressed_words;
-int pre_pause;
-static ALPHABET *current_alphabet;
-
-char word_phonemes[N_WORD_PHONEMES]; // a word translated into phoneme codes
-int n_ph_list2;
-PHONEME_LIST2 ph_list2[N_PHONEME_LIST]; // first stage of text->phonemes
-
 wchar_t option_punctlist[N_PUNCTLIST] = { 0 };
 
 // these are overridden by defaults set in the "speak" file
 int option_linelength = 0;
 
-#define N_EMBEDDED_LIST  250
-static int embedded_ix;
-static int embedded_read;
-unsigned int embedded_list[N_EMBEDDED_LIST];
-
-// the source text of a single clause (UTF8 bytes)
-static char source[N_TR_SOURCE+40]; // extra space for embedded command & voice change info at end
-
-int n_replace_phonemes;
-REPLACE_PHONEMES replace_phonemes[N_REPLACE_PHONEMES];
+// the source text of a single clause (UTF8 bytes), with extra space for
+// embedded command & voice change info at end
+#define source (CurrentPhonemizer()->source)
 
 // other characters which break a word, but don't produce a pause
 static const unsigned short breaks[] = { '_', 0 };
@@ -116,8 +100,7 @@ void DeleteTranslator(Translator *tr)
 {
 	if (!tr) return;
 
-	if (tr->data_dictlist != NULL)
-		free(tr->data_dictlist);
+	ReleaseDictionary(tr->data_dictlist);
 	free(tr);
 }
 
@@ -252,40 +235,40 @@ static void Word_EmbeddedCmd(void)
 		case EMBED_B:
 			// break command
 			if (value == 0)
-				pre_pause = 0; // break=none
+				CurrentPhonemizer()->pre_pause = 0; // break=none
 			else
-				pre_pause += value;
+				CurrentPhonemizer()->pre_pause += value;
 			break;
 		}
 	} while (((embedded_cmd & 0x80) == 0) && (embedded_read < embedded_ix));
 }
 
-static int SetAlternateTranslator(const char *new_language, Translator **translator, char translator_language[20])
+static int SetAlternateTranslator(const char *new_language, Translator **tr, char translator_language[20])
 {
 	// Set alternate translator to a second language
 	int new_phoneme_tab;
 
 	if ((new_phoneme_tab = SelectPhonemeTableName(new_language)) >= 0) {
-		if ((*translator != NULL) && (strcmp(new_language, translator_language) != 0)) {
+		if ((*tr != NULL) && (strcmp(new_language, translator_language) != 0)) {
 			// we already have an alternative translator, but not for the required language, delete it
-			DeleteTranslator(*translator);
-			*translator = NULL;
+			DeleteTranslator(*tr);
+			*tr = NULL;
 		}
 
-		if (*translator == NULL) {
-			*translator = SelectTranslator(new_language);
+		if (*tr == NULL) {
+			*tr = SelectTranslator(new_language);
 			strcpy(translator_language, new_language);
 
-			if (LoadDictionary(*translator, (*translator)->dictionary_name, 0) != 0) {
+			if (LoadDictionary(*tr, (*tr)->dictionary_name, 0) != 0) {
 				SelectPhonemeTable(voice->phoneme_tab_ix); // revert to original phoneme table
 				new_phoneme_tab = -1;
 				translator_language[0] = 0;
 			}
-			(*translator)->phoneme_tab_ix = new_phoneme_tab;
+			(*tr)->phoneme_tab_ix = new_phoneme_tab;
 		}
 	}
-	if (*translator != NULL)
-		(*translator)->phonemes_repeat[0] = 0;
+	if (*tr != NULL)
+		(*tr)->phonemes_repeat[0] = 0;
 	return new_phoneme_tab;
 }
 
@@ -415,7 +398,7 @@ static int TranslateWord2(Translator *tr, char *word, WORD_TAB *wtab, int pre_pa
 
 		if (p[0] == phonSWITCH) {
 			int switch_attempt;
-			strcpy(old_dictionary_name, dictionary_name);
+			strcpy(old_dictionary_name, CurrentPhonemizer()->dictionary_name);
 			for (switch_attempt = 0; switch_attempt < 2; switch_attempt++) {
 				// this word uses a different language
 				memcpy(word, word_copy, word_copy_len);
@@ -453,7 +436,7 @@ static int TranslateWord2(Translator *tr, char *word, WORD_TAB *wtab, int pre_pa
 			}
 
 			if (switch_phonemes == -1) {
-				strcpy(dictionary_name, old_dictionary_name);
+				strcpy(CurrentPhonemizer()->dictionary_name, old_dictionary_name);
 				SelectPhonemeTable(voice->phoneme_tab_ix);
 
 				// leave switch_phonemes set, but use the original phoneme table number.
@@ -655,7 +638,7 @@ static int TranslateWord2(Translator *tr, char *word, WORD_TAB *wtab, int pre_pa
 	// This may require up to 1 phoneme
 	if (switch_phonemes >= 0) {
 		// this word uses a different phoneme table, now switch back
-		strcpy(dictionary_name, old_dictionary_name);
+		strcpy(CurrentPhonemizer()->dictionary_name, old_dictionary_name);
 		SelectPhonemeTable(voice->phoneme_tab_ix);
 		SetPlist2(&ph_list2[n_ph_list2], phonSWITCH);
 		ph_list2[n_ph_list2++].tone_ph = voice->phoneme_tab_ix; // original phoneme table number
@@ -786,9 +769,9 @@ static int SubstituteChar(Translator *tr, unsigned int c, unsigned int next_in,
 	unsigned int new_c, c2 = ' ', c_lower;
 	int upper_case = 0;
 
-	static int ignore_next_n = 0;
-	if (ignore_next_n > 0) {
-		ignore_next_n--;
+	int *ignore_next_n = &CurrentPhonemizer()->ignore_next_n;
+	if (*ignore_next_n > 0) {
+		(*ignore_next_n)--;
 		return 8;
 	}
 
@@ -805,7 +788,7 @@ static int SubstituteChar(Translator *tr, unsigned int c, unsigned int next_in,
 		upper_case = 1;
 	}
 
-	const char *to = FindReplacementChars(tr, &from, c_lower, next, &ignore_next_n);
+	const char *to = FindReplacementChars(tr, &from, c_lower, next, ignore_next_n);
 	if (to == NULL)
 		return c; // no substitution
 
@@ -958,7 +941,7 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 
 	short charix[N_TR_SOURCE+4];
 	WORD_TAB words[N_CLAUSE_WORDS];
-	static char voice_change_name[40];
+	char *voice_change_name = CurrentPhonemizer()->voice_change_name;
 	int word_count = 0; // index into words
 
 	char sbuf[N_TR_SOURCE];
@@ -969,11 +952,11 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 	if (tr == NULL)
 		return;
 
-	MAKE_MEM_UNDEFINED(&voice_change_name, sizeof(voice_change_name));
+	MAKE_MEM_UNDEFINED(voice_change_name, sizeof(CurrentPhonemizer()->voice_change_name));
 
 	embedded_ix = 0;
 	embedded_read = 0;
-	pre_pause = 0;
+	CurrentPhonemizer()->pre_pause = 0;
 	any_stressed_words = false;
 
 	if ((clause_start_char = count_characters) < 0)
@@ -1425,10 +1408,10 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 				if (alpha_count == 0) {
 					all_upper_case &= ~FLAG_ALL_UPPER;
 				}
-				words[word_count].pre_pause = pre_pause;
+				words[word_count].pre_pause = CurrentPhonemizer()->pre_pause;
 				words[word_count].flags |= (all_upper_case | word_flags | word_emphasis);
 
-				if (pre_pause > 0) {
+				if (CurrentPhonemizer()->pre_pause > 0) {
 					// insert an extra space before the word, to prevent influence from previous word across the pause
 					for (j = ix; j > words[word_count].start; j--)
 						sbuf[j] = sbuf[j-1];
@@ -1445,7 +1428,7 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 
 				word_flags = next_word_flags;
 				next_word_flags = 0;
-				pre_pause = 0;
+				CurrentPhonemizer()->pre_pause = 0;
 				all_upper_case = FLAG_ALL_UPPER;
 				alpha_count = 0;
 				syllable_marked = false;
@@ -1460,8 +1443,8 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 			if ((ix < (N_TR_SOURCE - 4)))
 				ix += utf8_out(c, &sbuf[ix]);
 		}
-		if (pre_pause_add > pre_pause)
-			pre_pause = pre_pause_add;
+		if (pre_pause_add > CurrentPhonemizer()->pre_pause)
+			CurrentPhonemizer()->pre_pause = pre_pause_add;
 		pre_pause_add = 0;
 	}
 
@@ -1595,13 +1578,13 @@ void TranslateClauseWithTerminator(Translator *tr, int *tone_out, char **voice_c
 				words[ix].pre_pause = 0;
 			}
 		} else {
-			pre_pause = 0;
+			CurrentPhonemizer()->pre_pause = 0;
 
 			dict_flags = TranslateWord2(tr, word, &words[ix], words[ix].pre_pause);
 
-			if (pre_pause > words[ix+1].pre_pause) {
-				words[ix+1].pre_pause = pre_pause;
-				pre_pause = 0;
+			if (CurrentPhonemizer()->pre_pause > words[ix+1].pre_pause) {
+				words[ix+1].pre_pause = CurrentPhonemizer()->pre_pause;
+				CurrentPhonemizer()->pre_pause = 0;
 			}
 
 			if (dict_flags & FLAG_SPELLWORD) {
@@ -1694,7 +1677,7 @@ static int CalcWordLength(int source_index, int charix_top, short int *charix, W
 	return k;
 	}
 
-static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags, unsigned char *p, char *word_phonemes) {
+static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags, unsigned char *p, char *phonemes) {
 	// combine a preposition with the following word
 
 
@@ -1720,10 +1703,10 @@ static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags,
 
 	if (ok) {
 		char ph_buf[N_WORD_PHONEMES];
-		strcpy(ph_buf, word_phonemes);
+		strcpy(ph_buf, phonemes);
 
 		flags2[0] = TranslateWord(tr, p2+1, wtab+1, NULL);
-		if ((flags2[0] & FLAG_WAS_UNPRONOUNCABLE) || (word_phonemes[0] == phonSWITCH))
+		if ((flags2[0] & FLAG_WAS_UNPRONOUNCABLE) || (phonemes[0] == phonSWITCH))
 			ok = false;
 
 		if ((sylimit & 0x100) && ((flags2[0] & FLAG_ALT_TRANS) == 0)) {
@@ -1737,7 +1720,7 @@ static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags,
 		}
 
 		if (ok == false)
-			strcpy(word_phonemes, ph_buf);
+			strcpy(phonemes, ph_buf);
 	}
 
 	if (ok) {
@@ -1757,7 +1740,7 @@ static void CombineFlag(Translator *tr, WORD_TAB *wtab, char *word, int *flags,
 	}
 }
 
-static void SwitchLanguage(char *word, char *word_phonemes) {
+static void SwitchLanguage(char *word, char *phonemes) {
 	char lang_name[12];
 	int ix;
 
@@ -1774,9 +1757,9 @@ static void SwitchLanguage(char *word, char *word_phonemes) {
 
 	if ((ix = LookupPhonemeTable(lang_name)) > 0) {
 		SelectPhonemeTable(ix);
-		word_phonemes[0] = phonSWITCH;
-		word_phonemes[1] = ix;
-		word_phonemes[2] = 0;
+		phonemes[0] = phonSWITCH;
+		phonemes[1] = ix;
+		phonemes[2] = 0;
 	}
 }
 
@@ -42,6 +42,7 @@ extern "C"
 #define N_PHONEME_BYTES  160 // max bytes for a phoneme
 #define N_CLAUSE_WORDS   300 // max words in a clause
 #define N_TR_SOURCE      800 // the source text of a single clause (UTF8 bytes)
+#define N_EMBEDDED_LIST  250
 
 #define N_RULE_GROUP2    120 // max num of two-letter rule chains
 #define N_HASH_DICT     1024
@@ -621,20 +622,13 @@ extern int option_punctuation;
 extern int option_endpause;
 extern int option_ssml;
 extern int option_phoneme_input;   // allow [[phonemes]] in input text
-extern int option_sayas;
 extern int option_wordgap;
 
-extern int count_characters;
-extern int count_sentences;
 extern int skip_characters;
 extern int skip_words;
 extern int skip_sentences;
-extern bool skipping_text;
 extern int end_character_position;
-extern int clause_start_char;
-extern int clause_start_word;
 extern char *namedata;
-extern int pre_pause;
 
 #define N_MARKER_LENGTH 50   // max.length of a mark name
 extern char skip_marker[N_MARKER_LENGTH];
@@ -642,12 +636,6 @@ extern char skip_marker[N_MARKER_LENGTH];
 #define N_PUNCTLIST  60
 extern wchar_t option_punctlist[N_PUNCTLIST];  // which punctuation characters to announce
 
-extern Translator *translator;
-extern Translator *translator2;
-extern Translator *translator3;
-extern char dictionary_name[40];
-extern espeak_ng_TEXT_DECODER *p_decoder;
-extern int dictionary_skipwords;
 
 #define LEADING_2_BITS 0xC0 // 0b11000000
 #define UTF8_TAIL_BITS 0x80 // 0b10000000
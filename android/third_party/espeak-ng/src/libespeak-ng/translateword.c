@@ -43,6 +43,9 @@
 #include "synthdata.h"            // for SelectPhonemeTable, LookupPhonemeTable
 #include "ucd/ucd.h"              // for ucd_toupper
 #include "voice.h"                // for voice, voice_t
+#include "phonemizer.h"           // for voice, translator, translator3, opt...
+
+#undef word_phonemes // passed in to TranslateWord3()
 
 
 static void addPluralSuffixes(int flags, Translator *tr, char last_char, char *word_phonemes);
@@ -79,7 +79,6 @@ typedef struct {
 
 } voice_t;
 
-extern voice_t *voice;
 extern int tone_points[12];
 
 typedef enum {
@@ -191,6 +190,7 @@ const char *SelectVoice(espeak_VOICE *voice_select, int *found);
 espeak_VOICE *SelectVoiceByName(espeak_VOICE **voices, const char *name);
 voice_t *LoadVoice(const char *voice_name, int control);
 voice_t *LoadVoiceVariant(const char *voice_name, int variant);
+espeak_ng_STATUS LoadVoiceByName(const char *name, char variant_name[40]);
 espeak_ng_STATUS DoVoiceChange(voice_t *v);
 void WavegenSetVoice(voice_t *v);
 void ReadNumbers(char *p, int *flags, int maxValue,  const MNEM_TAB *keyword_tab, int key);
@@ -198,6 +198,7 @@ int Read8Numbers(char *data_in, int data[8]);
 void ReadTonePoints(char *string, int *tone_pts);
 void VoiceReset(int control);
 void FreeVoiceList(void);
+void FreeVoiceCache(void);
 
 #ifdef __cplusplus
 }
@@ -51,6 +51,7 @@
 #include "synthesize.h"               // for SetSpeed, SPEED_FACTORS, speed
 #include "translate.h"                // for LANGUAGE_OPTIONS, DeleteTranslator
 #include "wavegen.h"                  // for InitBreath
+#include "phonemizer.h"               // for CurrentPhonemizer, voice, translato...
 
 static int AddToVoicesList(const char *fname, int len_path_voices, int is_language_file);
 
@@ -73,6 +74,9 @@ static int n_voices_list = 0;
 static espeak_VOICE *voices_list[N_VOICES_LIST];
 
 static espeak_VOICE current_voice_selected;
+static char voice_identifier[40]; // file name for  current_voice_selected
+static char voice_name[40];       // voice name for current_voice_selected
+static char voice_languages[100]; // list of languages and priorities for current_voice_selected
 
 #define N_VOICE_VARIANTS   12
 static const char variants_either[N_VOICE_VARIANTS] = { 1, 2, 12, 3, 13, 4, 14, 5, 11, 0 };
@@ -80,8 +84,8 @@ static const char variants_male[N_VOICE_VARIANTS] = { 1, 2, 3, 4, 5, 6, 0 };
 static const char variants_female[N_VOICE_VARIANTS] = { 11, 12, 13, 14, 0 };
 static const char *const variant_lists[3] = { variants_either, variants_male, variants_female };
 
-static voice_t voicedata;
-voice_t *voice = &voicedata;
+// the current voice is held by the current phonemizer, see phonemizer.h
+#define voicedata               (CurrentPhonemizer()->voicedata)
 
 static char *fgets_strip(char *buf, int size, FILE *f_in)
 {
@@ -107,7 +111,7 @@ static char *fgets_strip(char *buf, int size, FILE *f_in)
 	return buf;
 }
 
-static void SetToneAdjust(voice_t *voice, int *tone_pts)
+static void SetToneAdjust(voice_t *v, int *tone_pts)
 {
 	int ix;
 	int pt;
@@ -131,7 +135,7 @@ static void SetToneAdjust(voice_t *voice, int *tone_pts)
 				y = height1 + (int)((ix-freq1) * (height2-height1) / (freq2-freq1));
 				if (y > 255)
 					y = 255;
-				voice->tone_adjust[ix] = y;
+				v->tone_adjust[ix] = y;
 			}
 		}
 		freq1 = freq2;
@@ -397,6 +401,127 @@ void ReadNumbers(char *p, int *flags, int maxValue,  const MNEM_TAB *keyword_tab
 	}
 }
 
+static bool VoiceCacheOwns(const Translator *tr)
+{
+	VOICE_CACHE *cache = CurrentPhonemizer()->voice_cache;
+	int ix;
+
+	for (ix = 0; ix < N_VOICE_CACHE; ix++) {
+		if ((cache[ix].last_used != 0) && (cache[ix].tr == tr))
+			return true;
+	}
+	return false;
+}
+
+static void ReleaseTranslator(void)
+{
+	// the translator is deleted when it is replaced, unless the voice cache owns it
+	if ((translator != NULL) && !VoiceCacheOwns(translator))
+		DeleteTranslator(translator);
+	translator = NULL;
+}
+
+void FreeVoiceCache(void)
+{
+	PHONEMIZER *ph = CurrentPhonemizer();
+	int ix;
+
+	if (VoiceCacheOwns(translator))
+		translator = NULL;
+	for (ix = 0; ix < N_VOICE_CACHE; ix++) {
+		if (ph->voice_cache[ix].last_used != 0)
+			DeleteTranslator(ph->voice_cache[ix].tr);
+		ph->voice_cache[ix].last_used = 0;
+		ph->voice_cache[ix].tr = NULL;
+	}
+}
+
+static void CacheVoice(const char *name)
+{
+	// Keep the voice that has just been loaded, replacing the least recently
+	// used one if the cache is full.
+	PHONEMIZER *ph = CurrentPhonemizer();
+	VOICE_CACHE *entry = &ph->voice_cache[0];
+	int ix;
+
+#if USE_MBROLA
+	if (mbrola_name[0] != 0)
+		return; // the mbrola voice is not restored from the cache
+#endif
+	for (ix = 1; ix < N_VOICE_CACHE; ix++) {
+		if (ph->voice_cache[ix].last_used < entry->last_used)
+			entry = &ph->voice_cache[ix];
+	}
+	if (entry->last_used != 0)
+		DeleteTranslator(entry->tr);
+
+	strncpy0(entry->name, name, sizeof(entry->name));
+	entry->last_used = ++ph->voice_cache_clock;
+	entry->voice_data = *voice;
+	entry->tr = translator;
+	entry->n_replace = n_replace_phonemes;
+	memcpy(entry->replace, replace_phonemes, sizeof(entry->replace));
+	entry->voice_selected = current_voice_selected;
+	memcpy(entry->voice_identifier, voice_identifier, sizeof(voice_identifier));
+	memcpy(entry->voice_name, voice_name, sizeof(voice_name));
+	memcpy(entry->voice_languages, voice_languages, sizeof(voice_languages));
+	entry->fast_settings = speed.fast_settings;
+}
+
+static bool SelectCachedVoice(const char *name)
+{
+	// Switch to a voice in the cache: the same state that LoadVoice() would
+	// leave, without reading the voice file and dictionary again.
+	PHONEMIZER *ph = CurrentPhonemizer();
+	VOICE_CACHE *entry = NULL;
+	Translator *tr;
+	int ix;
+
+	for (ix = 0; ix < N_VOICE_CACHE; ix++) {
+		if ((ph->voice_cache[ix].last_used != 0) && (strcmp(ph->voice_cache[ix].name, name) == 0)) {
+			entry = &ph->voice_cache[ix];
+			break;
+		}
+	}
+	if (entry == NULL)
+		return false;
+
+	ReleaseTranslator();
+	entry->last_used = ++ph->voice_cache_clock;
+	voice = &voicedata;
+	voicedata = entry->voice_data;
+	translator = tr = entry->tr;
+	n_replace_phonemes = entry->n_replace;
+	memcpy(replace_phonemes, entry->replace, sizeof(entry->replace));
+	strcpy(CurrentPhonemizer()->dictionary_name, tr->dictionary_name);
+	SelectPhonemeTable(voice->phoneme_tab_ix);
+
+	// as for a new translator
+	tr->expect_verb = 0;
+	tr->expect_past = 0;
+	tr->expect_verb_s = 0;
+	tr->expect_noun = 0;
+	tr->clause_upper_count = 0;
+	tr->clause_lower_count = 0;
+	tr->phonemes_repeat[0] = 0;
+
+	current_voice_selected = entry->voice_selected;
+	memcpy(voice_identifier, entry->voice_identifier, sizeof(voice_identifier));
+	memcpy(voice_name, entry->voice_name, sizeof(voice_name));
+	memcpy(voice_languages, entry->voice_languages, sizeof(voice_languages));
+	current_voice_selected.identifier = voice_identifier;
+	current_voice_selected.name = voice_name;
+	current_voice_selected.languages = voice_languages;
+
+#if USE_MBROLA
+	LoadMbrolaTable(NULL, NULL, 0);
+#endif
+	speed.fast_settings = entry->fast_settings;
+	if ((voice->speed_percent != 100) || (speed.fast_settings != espeakRATE_MAXIMUM))
+		SetSpeed(3); // as done by the voice's "speed" or "fast" attribute
+	return true;
+}
+
 voice_t *LoadVoice(const char *vname, int control)
 {
 	// control, bit 0  1= no_default
@@ -432,10 +557,6 @@ voice_t *LoadVoice(const char *vname, int control)
 	int pitch1;
 	int pitch2;
 
-	static char voice_identifier[40]; // file name for  current_voice_selected
-	static char voice_name[40];       // voice name for current_voice_selected
-	static char voice_languages[100]; // list of languages and priorities for current_voice_selected
-
 	if (!tone_only) {
 		MAKE_MEM_UNDEFINED(&voice_identifier, sizeof(voice_identifier));
 		MAKE_MEM_UNDEFINED(&voice_name, sizeof(voice_name));
@@ -476,10 +597,8 @@ voice_t *LoadVoice(const char *vname, int control)
 			language_type = voicename;
 	}
 
-	if (!tone_only && (translator != NULL)) {
-		DeleteTranslator(translator);
-		translator = NULL;
-	}
+	if (!tone_only)
+		ReleaseTranslator();
 
 	strcpy(translator_name, language_type);
 	strcpy(new_dictionary, language_type);
@@ -719,8 +838,9 @@ voice_t *LoadVoice(const char *vname, int control)
 
 		if (!(control & 8/*compiling phonemes*/)) {
 			LoadDictionary(translator, new_dictionary, control & 4);
-			if (dictionary_name[0] == 0) {
+			if (CurrentPhonemizer()->dictionary_name[0] == 0) {
 				DeleteTranslator(translator);
+				translator = NULL;
 				return NULL; // no dictionary loaded
 			}
 		}
@@ -815,17 +935,17 @@ static int __cdecl VoiceScoreSorter(const void *p1, const void *p2)
 	return strcmp(v1->name, v2->name);
 }
 
-static int ScoreVoice(espeak_VOICE *voice_spec, const char *spec_language, int spec_n_parts, int spec_lang_len, espeak_VOICE *voice)
+static int ScoreVoice(espeak_VOICE *voice_spec, const char *spec_language, int spec_n_parts, int spec_lang_len, espeak_VOICE *v)
 {
 	const char *p;
 	int score = 0;
 	int x;
 
-	p = voice->languages; // list of languages+dialects for which this voice is suitable
+	p = v->languages; // list of languages+dialects for which this voice is suitable
 
 	if (spec_n_parts < 0) {
 		// match on the subdirectory
-		if (memcmp(voice->identifier, spec_language, spec_lang_len) == 0)
+		if (memcmp(v->identifier, spec_language, spec_lang_len) == 0)
 			return 100;
 		return 0;
 	}
@@ -891,25 +1011,25 @@ static int ScoreVoice(espeak_VOICE *voice_spec, const char *spec_language, int s
 		return 0;
 
 	if (voice_spec->name != NULL) {
-		if (strcmp(voice_spec->name, voice->name) == 0) {
+		if (strcmp(voice_spec->name, v->name) == 0) {
 			// match on voice name
 			score += 500;
-		} else if (strcmp(voice_spec->name, voice->identifier) == 0)
+		} else if (strcmp(voice_spec->name, v->identifier) == 0)
 			score += 400;
 	}
 
 	if (((voice_spec->gender == ENGENDER_MALE) || (voice_spec->gender == ENGENDER_FEMALE)) &&
-	    ((voice->gender == ENGENDER_MALE) || (voice->gender == ENGENDER_FEMALE))) {
-		if (voice_spec->gender == voice->gender)
+	    ((v->gender == ENGENDER_MALE) || (v->gender == ENGENDER_FEMALE))) {
+		if (voice_spec->gender == v->gender)
 			score += 50;
 		else
 			score -= 50;
 	}
 
-	if ((voice_spec->age <= 12) && (voice->gender == ENGENDER_FEMALE) && (voice->age > 12))
+	if ((voice_spec->age <= 12) && (v->gender == ENGENDER_FEMALE) && (v->age > 12))
 		score += 5; // give some preference for non-child female voice if a child is requested
 
-	if (voice->age != 0) {
+	if (v->age != 0) {
 		int required_age;
 		if (voice_spec->age == 0)
 			required_age = 30;
@@ -917,7 +1037,7 @@ static int ScoreVoice(espeak_VOICE *voice_spec, const char *spec_language, int s
 			required_age = voice_spec->age;
 
 		int ratio;
-		ratio = (required_age*100)/voice->age;
+		ratio = (required_age*100)/v->age;
 		if (ratio < 100)
 			ratio = 10000/ratio;
 		ratio = (ratio - 100)/10; // 0=exact match, 10=out by factor of 2
@@ -1272,17 +1392,37 @@ ESPEAK_NG_API espeak_ng_STATUS espeak_ng_SetVoiceByFile(const char *filename)
 	return ENS_VOICE_NOT_FOUND;
 }
 
-ESPEAK_NG_API espeak_ng_STATUS espeak_ng_SetVoiceByName(const char *name)
+espeak_ng_STATUS LoadVoiceByName(const char *name, char variant_name_out[40])
 {
+	// Loads the voice and its variant into the current phonemizer, without
+	// changing the synthesis parameters. Voices that were loaded before are
+	// selected from the phonemizer's voice cache.
 	espeak_VOICE *v;
 	int ix;
-	espeak_VOICE voice_selector;
 	char *variant_name;
 	char buf[60];
+	char cache_name[60];
+	espeak_ng_STATUS status = ENS_VOICE_NOT_FOUND;
+
+	LockVoices();
+
+	for (ix = 0; ix < (int)sizeof(cache_name)-1; ix++) {
+		// convert voice name to lower case  (ascii)
+		if ((cache_name[ix] = tolower(name[ix])) == 0)
+			break;
+	}
+	cache_name[ix] = 0;
 
 	strncpy0(buf, name, sizeof(buf));
 
 	variant_name = ExtractVoiceVariantName(buf, 0, 1);
+	if (variant_name_out != NULL)
+		strncpy0(variant_name_out, variant_name, 40);
+
+	if (SelectCachedVoice(cache_name)) {
+		UnlockVoices();
+		return ENS_OK;
+	}
 
 	for (ix = 0;; ix++) {
 		// convert voice name to lower case  (ascii)
@@ -1290,36 +1430,43 @@ ESPEAK_NG_API espeak_ng_STATUS espeak_ng_SetVoiceByName(const char *name)
 			break;
 	}
 
-	memset(&voice_selector, 0, sizeof(voice_selector));
-	voice_selector.name = (char *)name; // include variant name in voice stack ??
-
 	// first check for a voice with this filename
 	// This may avoid the need to call espeak_ListVoices().
 
-	if (LoadVoice(buf, 1) != NULL) {
-		if (variant_name[0] != 0)
-			LoadVoice(variant_name, 2);
+	if (LoadVoice(buf, 1) != NULL)
+		status = ENS_OK;
+	else {
+		if (n_voices_list == 0)
+			espeak_ListVoices(NULL); // create the voices list
 
-		DoVoiceChange(voice);
-		voice_selector.languages = voice->language_name;
-		SetVoiceStack(&voice_selector, variant_name);
-		return ENS_OK;
+		if (((v = SelectVoiceByName(voices_list, buf)) != NULL) && (LoadVoice(v->identifier, 0) != NULL))
+			status = ENS_OK;
 	}
+	if ((status == ENS_OK) && (variant_name[0] != 0))
+		LoadVoice(variant_name, 2);
+	if (status == ENS_OK)
+		CacheVoice(cache_name);
 
-	if (n_voices_list == 0)
-		espeak_ListVoices(NULL); // create the voices list
+	UnlockVoices();
+	return status;
+}
 
-	if ((v = SelectVoiceByName(voices_list, buf)) != NULL) {
-		if (LoadVoice(v->identifier, 0) != NULL) {
-			if (variant_name[0] != 0)
-				LoadVoice(variant_name, 2);
-			DoVoiceChange(voice);
-			voice_selector.languages = voice->language_name;
-			SetVoiceStack(&voice_selector, variant_name);
-			return ENS_OK;
-		}
-	}
-	return ENS_VOICE_NOT_FOUND;
+ESPEAK_NG_API espeak_ng_STATUS espeak_ng_SetVoiceByName(const char *name)
+{
+	espeak_VOICE voice_selector;
+	char variant_name[40];
+	espeak_ng_STATUS status;
+
+	if ((status = LoadVoiceByName(name, variant_name)) != ENS_OK)
+		return status;
+
+	memset(&voice_selector, 0, sizeof(voice_selector));
+	voice_selector.name = (char *)name; // include variant name in voice stack ??
+
+	DoVoiceChange(voice);
+	voice_selector.languages = voice->language_name;
+	SetVoiceStack(&voice_selector, variant_name);
+	return ENS_OK;
 }
 
 ESPEAK_NG_API espeak_ng_STATUS espeak_ng_SetVoiceByProperties(espeak_VOICE *voice_selector)
@@ -47,6 +47,7 @@
 
 #include "sintab.h"
 #include "speech.h"
+#include "phonemizer.h"
 
 static void SetSynth(int length, int modn, frame_t *fr1, frame_t *fr2, voice_t *v);
 
@@ -1105,7 +1106,7 @@ static void SetAmplitude(int length, unsigned char *amp_env, int value)
 	amplitude_env = amp_env;
 }
 
-void SetPitch2(voice_t *voice, int pitch1, int pitch2, int *pitch_base, int *pitch_range)
+void SetPitch2(voice_t *v, int pitch1, int pitch2, int *pitch_base, int *pitch_range)
 {
 	int base;
 	int range;
@@ -1124,11 +1125,11 @@ void SetPitch2(voice_t *voice, int pitch1, int pitch2, int *pitch_base, int *pit
 	if (pitch_value < 0)
 		pitch_value = 0;
 
-	base = (voice->pitch_base * pitch_adjust_tab[pitch_value])/128;
-	range =  (voice->pitch_range * embedded_value[EMBED_R])/50;
+	base = (v->pitch_base * pitch_adjust_tab[pitch_value])/128;
+	range =  (v->pitch_range * embedded_value[EMBED_R])/50;
 
 	// compensate for change in pitch when the range is narrowed or widened
-	base -= (range - voice->pitch_range)*18;
+	base -= (range - v->pitch_range)*18;
 
 	*pitch_base = base + (pitch1 * range)/2;
 	*pitch_range = base + (pitch2 * range)/2 - *pitch_base;
@@ -31,6 +31,7 @@
 #include "voice.h"
 #include "synthesize.h"
 #include "translate.h"
+#include "phonemizer.h"
 
 // region espeak_Initialize
 
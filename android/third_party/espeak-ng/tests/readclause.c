@@ -35,6 +35,7 @@
 #include "voice.h"
 #include "synthesize.h"
 #include "translate.h"
+#include "phonemizer.h"
 
 // Arguments to ReadClause. Declared here to avoid duplicating them across the
 // different test functions.
@@ -1,8 +1,11 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <espeak-ng/espeak_ng.h>
 #include <espeak-ng/speak_lib.h>
 
 #include "phonemize.hpp"
@@ -14,16 +17,84 @@ namespace piper {
 std::map<std::string, PhonemeMap> DEFAULT_PHONEME_MAP = {
     {"pt-br", {{U'c', {U'k'}}}}};
 
+namespace {
+
+// Adapts a translator that finds the end of the text itself.
+eSpeakClauseRangeFn ignoreTextEnd(const eSpeakClauseFn &translateClause) {
+  return [&translateClause](const void **textptr, const void * /*textend*/,
+                            int textmode, int phonememode, int *terminator) {
+    return translateClause(textptr, textmode, phonememode, terminator);
+  };
+}
+
+} // namespace
+
 PIPERPHONEMIZE_EXPORT void
-phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
                  std::vector<std::vector<Phoneme>> &phonemes) {
 
-  auto voice = config.voice;
-  int result = espeak_SetVoiceByName(voice.c_str());
+  int result = espeak_SetVoiceByName(config.voice.c_str());
   if (result != 0) {
     throw std::runtime_error("Failed to set eSpeak-ng voice");
   }
 
+#if defined(ESPEAK_NG_HAVE_TEXT_RANGE)
+  phonemize_eSpeak(text, config, phonemes,
+                   eSpeakClauseRangeFn(espeak_ng_TextToPhonemesInRange));
+#else
+  phonemize_eSpeak(text, config, phonemes,
+                   eSpeakClauseFn(espeak_TextToPhonemesWithTerminator));
+#endif
+} /* phonemize_eSpeak */
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
+                 std::vector<std::vector<Phoneme>> &phonemes,
+                 const eSpeakClauseFn &translateClause) {
+  phonemize_eSpeak(text, config, phonemes, ignoreTextEnd(translateClause));
+} /* phonemize_eSpeak */
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
+                 std::vector<std::vector<Phoneme>> &phonemes,
+                 const eSpeakClauseRangeFn &translateClause) {
+
+  std::vector<Phoneme> *sentencePhonemes = nullptr;
+  phonemize_eSpeak_clauses(
+      text, config, translateClause,
+      [&](const std::vector<Phoneme> &clausePhonemes, int terminator) {
+        if (!sentencePhonemes) {
+          // Start new sentence
+          phonemes.emplace_back();
+          sentencePhonemes = &phonemes[phonemes.size() - 1];
+        }
+        sentencePhonemes->insert(sentencePhonemes->end(),
+                                 clausePhonemes.begin(), clausePhonemes.end());
+
+        if ((terminator & CLAUSE_TYPE_SENTENCE) == CLAUSE_TYPE_SENTENCE) {
+          // End of sentence
+          sentencePhonemes = nullptr;
+        }
+        return true;
+      });
+
+} /* phonemize_eSpeak */
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak_clauses(const std::string &text, eSpeakPhonemeConfig &config,
+                         const eSpeakClauseFn &translateClause,
+                         const ClausePhonemesFn &onClause) {
+  phonemize_eSpeak_clauses(text, config, ignoreTextEnd(translateClause),
+                           onClause);
+} /* phonemize_eSpeak_clauses */
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak_clauses(const std::string &text, eSpeakPhonemeConfig &config,
+                         const eSpeakClauseRangeFn &translateClause,
+                         const ClausePhonemesFn &onClause) {
+
+  auto voice = config.voice;
+
   std::shared_ptr<PhonemeMap> phonemeMap;
   if (config.phonemeMap) {
     phonemeMap = config.phonemeMap;
@@ -31,32 +102,33 @@ phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
     phonemeMap = std::make_shared<PhonemeMap>(DEFAULT_PHONEME_MAP[voice]);
   }
 
-  // Modified by eSpeak
-  std::string textCopy(text);
+  // eSpeak only reads the text, advancing inputTextPointer clause by clause.
+  // The end includes the terminating NUL, which eSpeak reads as well.
+  const char *inputTextPointer = text.c_str();
+  const char *inputTextEnd = inputTextPointer + text.size() + 1;
 
-  std::vector<Phoneme> *sentencePhonemes = nullptr;
-  const char *inputTextPointer = textCopy.c_str();
+  std::vector<Phoneme> clausePhonemes;
+  std::vector<Phoneme> mappedSentPhonemes;
   int terminator = 0;
 
   while (inputTextPointer != NULL) {
     // Modified espeak-ng API to get access to clause terminator
-    std::string clausePhonemes(espeak_TextToPhonemesWithTerminator(
-        (const void **)&inputTextPointer,
+    const char *translated = translateClause(
+        (const void **)&inputTextPointer, inputTextEnd,
         /*textmode*/ espeakCHARS_AUTO,
-        /*phonememode = IPA*/ 0x02, &terminator));
+        /*phonememode = IPA*/ 0x02, &terminator);
+    if (!translated) {
+      throw std::runtime_error("Failed to translate eSpeak-ng clause");
+    }
 
     // Decompose, e.g. "ç" -> "c" + "̧"
-    auto phonemesNorm = una::norm::to_nfd_utf8(clausePhonemes);
+    auto phonemesNorm = una::norm::to_nfd_utf8(std::string_view(translated));
     auto phonemesRange = una::ranges::utf8_view{phonemesNorm};
 
-    if (!sentencePhonemes) {
-      // Start new sentence
-      phonemes.emplace_back();
-      sentencePhonemes = &phonemes[phonemes.size() - 1];
-    }
+    clausePhonemes.clear();
+    mappedSentPhonemes.clear();
 
     // Maybe use phoneme map
-    std::vector<Phoneme> mappedSentPhonemes;
     if (phonemeMap) {
       for (auto phoneme : phonemesRange) {
         if (phonemeMap->count(phoneme) < 1) {
@@ -81,8 +153,7 @@ phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
 
     if (config.keepLanguageFlags) {
       // No phoneme filter
-      sentencePhonemes->insert(sentencePhonemes->end(), phonemeIter,
-                               phonemeEnd);
+      clausePhonemes.insert(clausePhonemes.end(), phonemeIter, phonemeEnd);
     } else {
       // Filter out (lang) switch (flags).
       // These surround words from languages other than the current voice.
@@ -98,7 +169,7 @@ phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
           // Start of (lang) switch
           inLanguageFlag = true;
         } else {
-          sentencePhonemes->push_back(*phonemeIter);
+          clausePhonemes.push_back(*phonemeIter);
         }
 
         phonemeIter++;
@@ -108,30 +179,29 @@ phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
     // Add appropriate punctuation depending on terminator type
     int punctuation = terminator & 0x000FFFFF;
     if (punctuation == CLAUSE_PERIOD) {
-      sentencePhonemes->push_back(config.period);
+      clausePhonemes.push_back(config.period);
     } else if (punctuation == CLAUSE_QUESTION) {
-      sentencePhonemes->push_back(config.question);
+      clausePhonemes.push_back(config.question);
     } else if (punctuation == CLAUSE_EXCLAMATION) {
-      sentencePhonemes->push_back(config.exclamation);
+      clausePhonemes.push_back(config.exclamation);
     } else if (punctuation == CLAUSE_COMMA) {
-      sentencePhonemes->push_back(config.comma);
-      sentencePhonemes->push_back(config.space);
+      clausePhonemes.push_back(config.comma);
+      clausePhonemes.push_back(config.space);
     } else if (punctuation == CLAUSE_COLON) {
-      sentencePhonemes->push_back(config.colon);
-      sentencePhonemes->push_back(config.space);
+      clausePhonemes.push_back(config.colon);
+      clausePhonemes.push_back(config.space);
     } else if (punctuation == CLAUSE_SEMICOLON) {
-      sentencePhonemes->push_back(config.semicolon);
-      sentencePhonemes->push_back(config.space);
+      clausePhonemes.push_back(config.semicolon);
+      clausePhonemes.push_back(config.space);
     }
 
-    if ((terminator & CLAUSE_TYPE_SENTENCE) == CLAUSE_TYPE_SENTENCE) {
-      // End of sentence
-      sentencePhonemes = nullptr;
+    if (!onClause(clausePhonemes, terminator)) {
+      break;
     }
 
   } // while inputTextPointer != NULL
 
-} /* phonemize_eSpeak */
+} /* phonemize_eSpeak_clauses */
 
 // ----------------------------------------------------------------------------
 
@@ -1,6 +1,7 @@
 #ifndef PHOEMIZE_H_
 #define PHOEMIZE_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,9 +52,60 @@ struct eSpeakPhonemeConfig {
 //
 // Assumes espeak_Initialize has already been called.
 PIPERPHONEMIZE_EXPORT void
-phonemize_eSpeak(std::string text, eSpeakPhonemeConfig &config,
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
                  std::vector<std::vector<Phoneme>> &phonemes);
 
+// Translates one clause, with the signature of
+// espeak_TextToPhonemesWithTerminator.
+typedef std::function<const char *(const void **textptr, int textmode,
+                                    int phonememode, int *terminator)>
+    eSpeakClauseFn;
+#define PIPERPHONEMIZE_HAVE_CLAUSE_FN 1
+
+// Translates one clause of text that ends at textend (one past its
+// terminating NUL), with the signature of espeak_ng_TextToPhonemesInRange.
+// Unlike eSpeakClauseFn, the translator does not have to find the end of the
+// remaining text on every clause, so a document is phonemized in linear time.
+typedef std::function<const char *(const void **textptr, const void *textend,
+                                    int textmode, int phonememode,
+                                    int *terminator)>
+    eSpeakClauseRangeFn;
+#define PIPERPHONEMIZE_HAVE_CLAUSE_RANGE_FN 1
+
+// Same as above, but clauses are translated by translateClause (e.g. an
+// espeak_ng_PHONEMIZER bound to config.voice) and the global eSpeak voice is
+// left untouched. config.voice only selects the default phoneme map.
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
+                 std::vector<std::vector<Phoneme>> &phonemes,
+                 const eSpeakClauseRangeFn &translateClause);
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak(const std::string &text, eSpeakPhonemeConfig &config,
+                 std::vector<std::vector<Phoneme>> &phonemes,
+                 const eSpeakClauseFn &translateClause);
+
+// Receives the phonemes of one clause (with the punctuation appended for its
+// terminator) and the raw eSpeak clause terminator; CLAUSE_TYPE_SENTENCE is
+// set when the clause ends a sentence. Return false to stop phonemizing.
+typedef std::function<bool(const std::vector<Phoneme> &clausePhonemes,
+                           int terminator)>
+    ClausePhonemesFn;
+#define PIPERPHONEMIZE_HAVE_CLAUSE_STREAMING 1
+
+// Streaming variant: onClause is called as soon as each clause has been
+// translated instead of collecting all sentences first, so callers can start
+// consuming the first clause while the rest of the text is still pending.
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak_clauses(const std::string &text, eSpeakPhonemeConfig &config,
+                         const eSpeakClauseRangeFn &translateClause,
+                         const ClausePhonemesFn &onClause);
+
+PIPERPHONEMIZE_EXPORT void
+phonemize_eSpeak_clauses(const std::string &text, eSpeakPhonemeConfig &config,
+                         const eSpeakClauseFn &translateClause,
+                         const ClausePhonemesFn &onClause);
+
 enum TextCasing {
   CASING_IGNORE = 0,
   CASING_LOWER = 1,